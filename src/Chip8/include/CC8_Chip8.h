@@ -7,14 +7,17 @@
 Emulation Chip8Emulator = 
 {
     .GetInfo = CC8_GetInfo,
+    .CreateInstance = CC8_CreateInstance,
+    .DestroyInstance = CC8_DestroyInstance,
     .LoadProgram = CC8_LoadProgram,
     .QuitProgram = CC8_QuitProgram,
     .TickEmulation = CC8_TickEmulation,
+    .RunCycles = CC8_RunCycles,
+    .RunFrame = CC8_RunFrame,
     .TickTimers = CC8_TickDelayTimer,
-    .SetEmulationContext = CC8_SetEmulationContext,
     .OnInput = CC8_OnInput,
     .OnRender = CC8_OnRender,
-    .Loop = CC8_Loop
+    .DumpRegisters = CC8_DumpRegisters
 };
 
 #endif
\ No newline at end of file
@@ -4,16 +4,21 @@
 
 typedef void (*instructionFnPtr)(const InstructionContext * ctx);
 
-EmulationInfo CC8_GetInfo();
-long          CC8_LoadProgram(const char *filePath);
-void          CC8_QuitProgram();
-void          CC8_TickDelayTimer();
-int           CC8_TickEmulation();
-void          CC8_SetKeyboardValue(uint8_t key);
-void          CC8_SetEmulationContext(const void *context);
-void          CC8_PopulateMemory(const uint8_t *buffer, size_t bytesRead);
-void          CC8_OnInput(const char code);
-void          CC8_OnRender(uint32_t* pixels, const int64_t w, const int64_t h);
-void          CC8_Loop(uint32_t currentTime, uint32_t deltaTime);
+// Every entry point takes the CC8_Memory instance (no global machine)
+EmulationInfo     CC8_GetInfo();
+EmulationInstance CC8_CreateInstance();
+void              CC8_DestroyInstance(EmulationInstance instance);
+long              CC8_LoadProgram(EmulationInstance instance, const char *filePath);
+void              CC8_QuitProgram(EmulationInstance instance);
+void              CC8_TickDelayTimer(EmulationInstance instance);
+int               CC8_TickEmulation(EmulationInstance instance);
+uint64_t          CC8_RunCycles(EmulationInstance instance, const uint64_t budget);
+uint64_t          CC8_RunFrame(EmulationInstance instance);
+void              CC8_SetKeyboardValue(EmulationInstance instance, uint8_t key);
+void              CC8_PopulateMemory(void *instance, const uint8_t *buffer, size_t bytesRead);
+void              CC8_Step(CC8_Memory *chip, uint16_t opcode);
+void              CC8_OnInput(EmulationInstance instance, const char code);
+void              CC8_OnRender(EmulationInstance instance, uint32_t* pixels, const int64_t w, const int64_t h);
+int               CC8_DumpRegisters(EmulationInstance instance, char *buffer, const size_t size);
 
 #endif
\ No newline at end of file
@@ -16,6 +16,7 @@
 #define CC8_INSTRUCTION_SET_LENGHT 34
 #define CC8_INSTRUCTION_HASH_LENGHT 33
 #define CC8_INVALID_INSTRUCTION 0XFFFF
+#define CC8_INSTRUCTIONS_PER_FRAME 8 // ~500HZ CPU AT 60 FRAMES (DELAY TIMER TICKS ONCE PER FRAME)
 // MEMORY MAPING
 #define CC8_FONT_ADDR_START 0x000
 #define CC8_BOOT_ADDR_START 0x200
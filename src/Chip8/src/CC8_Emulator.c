@@ -5,8 +5,10 @@
 #include <minemu.h>
 
 
-static CC8_Memory * s_currentChipCtx;
-static int columCount =0; // TODO: remove this debug var
+// Chip8 log level (MNE_Log.h), executed opcodes are only traced
+#ifndef CC8_LOG_LEVEL
+#define CC8_LOG_LEVEL MNE_LOG_LEVEL
+#endif
 
 typedef struct {
     uint16_t mask;
@@ -84,14 +86,16 @@ EmulationInfo CC8_GetInfo()
     return info;
 }
 
-void CC8_PopulateMemory(const uint8_t *buffer, size_t bytesRead)
+void CC8_PopulateMemory(void *instance, const uint8_t *buffer, size_t bytesRead)
 {
+    CC8_Memory *chip = (CC8_Memory *) instance;
+
     // LOAD PROGRAM
     uint16_t addr = 0;
     uint16_t loop_index = 0;
     for (addr = CC8_BOOT_ADDR_START; (addr < CC8_BOOT_ADDR_START + bytesRead); addr++)
     {
-        s_currentChipCtx->RAM[addr] = buffer[loop_index++];
+        chip->RAM[addr] = buffer[loop_index++];
     }
 
     // LOAD FONT
@@ -99,39 +103,47 @@ void CC8_PopulateMemory(const uint8_t *buffer, size_t bytesRead)
     MNE_Log("Loaded font size: %li\n", sizeof(CC8_FONT));
     for (addr = CC8_FONT_ADDR_START; (addr < CC8_FONT_ADDR_START + sizeof(CC8_FONT)); addr++)
     {
-        s_currentChipCtx->RAM[CC8_FONT_ADDR_START + addr] = CC8_FONT[loop_index++];
+        chip->RAM[CC8_FONT_ADDR_START + addr] = CC8_FONT[loop_index++];
     }
 
-    s_currentChipCtx->PC = CC8_BOOT_ADDR_START;
+    chip->PC = CC8_BOOT_ADDR_START;
 }
 
-long CC8_LoadProgram(const char *filePath)
+EmulationInstance CC8_CreateInstance()
 {
-    if (s_currentChipCtx == NULL)
-    {
-        MNE_New(s_currentChipCtx, 1, CC8_Memory);
-        CC8_SetEmulationContext((void *) s_currentChipCtx);
-    }
+    CC8_Memory *chip = NULL;
+    MNE_New(chip, 1, CC8_Memory);
+
+    return chip;
+}
+
+void CC8_DestroyInstance(EmulationInstance instance)
+{
+    MNE_Delete(instance);
+}
+
+long CC8_LoadProgram(EmulationInstance instance, const char *filePath)
+{
+    if (instance == NULL) return 0;
 
-    return MNE_ReadFile(filePath, MNE_HEX_DUMP_FILE_FLAG, CC8_PopulateMemory);
+    return MNE_ReadFile(filePath, MNE_HEX_DUMP_FILE_FLAG, CC8_PopulateMemory, instance);
 }
 
-void CC8_QuitProgram()
+void CC8_QuitProgram(EmulationInstance instance)
 {
-    if (s_currentChipCtx != NULL)
+    if (instance != NULL)
     {
-        free(s_currentChipCtx);
-        s_currentChipCtx = NULL;
+        memset(instance, 0, sizeof(CC8_Memory));
     }
 }
 
-void CC8_Step(uint16_t opcode)
+void CC8_Step(CC8_Memory *chip, uint16_t opcode)
 {
     InstructionContext ctx;
 
     if (opcode == 0x0000) // NOP
     { 
-        s_currentChipCtx->INSTRUCTION = 0x0000;
+        chip->INSTRUCTION = 0x0000;
         return; 
     }
 
@@ -141,7 +153,7 @@ void CC8_Step(uint16_t opcode)
     ctx.nnn = opcode & 0x0FFF;
     ctx.kk = opcode & 0x00FF;
     ctx.n = opcode & 0x000F;
-    ctx.memory = s_currentChipCtx;
+    ctx.memory = chip;
 
     // Instruction fetching
     instructionFnPtr fetchedInstruction = FetchInstruction(opcode);
@@ -149,63 +161,104 @@ void CC8_Step(uint16_t opcode)
     // Instruction execution
     if (fetchedInstruction != NULL)
     {
-        MNE_Log("[%04X] ", opcode);
-        if (columCount++ >= 16)
-        {
-            MNE_Log("\n");
-            columCount = 0;
-        }
-
+        MNE_Trace(CC8_LOG_LEVEL, "[CC8] [%04X]\n", opcode);
         fetchedInstruction(&ctx);
-        s_currentChipCtx->INSTRUCTION = opcode; // Stores executed opcode to check later if was running fine
+        chip->INSTRUCTION = opcode; // Stores executed opcode to check later if was running fine
     }
     else
     {
-        MNE_Log("[Invalid opcode: %04X]\n", opcode);
-        columCount = 0;
-        s_currentChipCtx->INSTRUCTION = CC8_INVALID_INSTRUCTION; // Invalidate last instruction entry
+        MNE_LogAt(CC8_LOG_LEVEL, MNE_LOG_ERROR, "[Invalid opcode: %04X]\n", opcode);
+        chip->INSTRUCTION = CC8_INVALID_INSTRUCTION; // Invalidate last instruction entry
     }
 }
 
-void CC8_TickDelayTimer()
+void CC8_TickDelayTimer(EmulationInstance instance)
 {
-    if (s_currentChipCtx->DELAY != 0)
-        s_currentChipCtx->DELAY--;
+    CC8_Memory *chip = (CC8_Memory *) instance;
+
+    if (chip->DELAY != 0)
+        chip->DELAY--;
 }
 
-int CC8_TickEmulation()
+int CC8_TickEmulation(EmulationInstance instance)
 {
-    if (s_currentChipCtx == NULL) return 0;
+    CC8_Memory *chip = (CC8_Memory *) instance;
+
+    if (chip == NULL) return 0;
 
-    uint8_t higherByte = s_currentChipCtx->RAM[s_currentChipCtx->PC];
-    uint8_t lowerByte = s_currentChipCtx->RAM[s_currentChipCtx->PC + 1];
+    uint8_t higherByte = chip->RAM[chip->PC];
+    uint8_t lowerByte = chip->RAM[chip->PC + 1];
     uint16_t value16 = (higherByte << 8) | lowerByte;
     
-    CC8_Step(value16);
+    CC8_Step(chip, value16);
 
-    s_currentChipCtx->PC += 2;
+    chip->PC += 2;
     return 1;
 }
 
-void CC8_SetKeyboardValue(uint8_t key)
+uint64_t CC8_RunCycles(EmulationInstance instance, const uint64_t budget)
+{
+    CC8_Memory *chip = (CC8_Memory *) instance;
+
+    if (chip == NULL) return 0;
+
+    // One cycle per instruction, stops on an invalid opcode
+    uint64_t cycles = 0;
+    while (cycles < budget)
+    {
+        CC8_TickEmulation(chip);
+        cycles++;
+
+        if (chip->INSTRUCTION == CC8_INVALID_INSTRUCTION)
+        {
+            break;
+        }
+    }
+
+    return cycles;
+}
+
+uint64_t CC8_RunFrame(EmulationInstance instance)
+{
+    if (instance == NULL) return 0;
+
+    CC8_TickDelayTimer(instance);
+    return CC8_RunCycles(instance, CC8_INSTRUCTIONS_PER_FRAME);
+}
+
+void CC8_SetKeyboardValue(EmulationInstance instance, uint8_t key)
 {
-    s_currentChipCtx->KEYBOARD = key;
+    ((CC8_Memory *) instance)->KEYBOARD = key;
 }
 
-void CC8_SetEmulationContext(const void *context)
+void CC8_OnInput(EmulationInstance instance, const char code)
 {
-    s_currentChipCtx = (CC8_Memory *) context;
+    if (instance == NULL) return;
+    ((CC8_Memory *) instance)->KEYBOARD = code;
 }
 
-void CC8_OnInput(const char code)
+int CC8_DumpRegisters(EmulationInstance instance, char *buffer, const size_t size)
 {
-    if (s_currentChipCtx == NULL) return;
-    s_currentChipCtx->KEYBOARD = code;
+    const CC8_Memory *chip = (const CC8_Memory *) instance;
+    int lenght = snprintf(buffer, size, "{\"V\":[");
+
+    for (int i = 0; i < CHIP_8_V_REGISTERS_COUNT; i++)
+    {
+        lenght += snprintf(buffer + lenght, size > (size_t) lenght ? size - lenght : 0, i == 0 ? "%u" : ",%u", chip->V[i]);
+    }
+
+    lenght += snprintf(buffer + lenght, size > (size_t) lenght ? size - lenght : 0,
+                       "],\"I\":%u,\"PC\":%u,\"SP\":%u,\"DELAY\":%u,\"SOUND\":%u,\"INSTRUCTION\":%u}",
+                       chip->I, chip->PC, chip->SP, chip->DELAY, chip->SOUND, chip->INSTRUCTION);
+
+    return lenght;
 }
 
-void CC8_OnRender(uint32_t* pixels, const int64_t w, const int64_t h)
+void CC8_OnRender(EmulationInstance instance, uint32_t* pixels, const int64_t w, const int64_t h)
 {
-    if (s_currentChipCtx == NULL) return;
+    const CC8_Memory *chip = (const CC8_Memory *) instance;
+
+    if (chip == NULL) return;
 
     for (int i = 0; i < CHIP_8_VRAM_HEIGHT; i++)
     {
@@ -213,34 +266,10 @@ void CC8_OnRender(uint32_t* pixels, const int64_t w, const int64_t h)
         {
             int byteIndex = (i * CHIP_8_VRAM_WIDTH + (j / 8));
             int bitIndex = j % 8;
-            uint8_t vramByte = s_currentChipCtx->VRAM[byteIndex];
+            uint8_t vramByte = chip->VRAM[byteIndex];
             uint8_t vramBit = (vramByte >> bitIndex) & 0x1;
 
             pixels[i * CHIP_8_VRAM_WIDTH + j] = vramBit ? CHIP_8_FOREGROUND_DISPLAY_COLOR : CHIP_8_BACKGROUND_DISPLAY_COLOR;
         }
     }
 }
-
-// TODO: REMOVE ALL STATIC VARS FROM ALL THE CODE!!!
-static uint32_t last_update_emulation;
-static uint32_t last_update_time_timers;
-
-void CC8_Loop(uint32_t currentTime, uint32_t deltaTime)
-{
-    last_update_emulation += deltaTime;
-    last_update_time_timers += deltaTime;
-    
-    if (last_update_time_timers > 16) // TIMERS FREQ IN MS
-    { 
-        CC8_TickDelayTimer();
-        last_update_time_timers = 0;
-    }
-
-    if (last_update_emulation >= 2 ) // CPU FREQ IN MS
-    {
-        CC8_TickEmulation();
-        last_update_emulation = 0;
-    }
-
-   
-}
\ No newline at end of file
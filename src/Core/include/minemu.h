@@ -60,18 +60,24 @@ typedef struct
     ShellConfig UIConfig;
 } EmulationInfo;
 
+// Emulator instance handle (the emulator state, e.g. EmulationState or CC8_Memory), instances don't share any mutable state
+typedef void *EmulationInstance;
+
 typedef struct
 {
     EmulationInfo (*GetInfo)();
-    uint8_t (*Initialize)(int argc, const char **argv);
-    long (*LoadProgram)(const char *filePath);
-    void (*QuitProgram)();
-    int (*TickEmulation)();
-    void (*TickTimers)();
-    void (*SetEmulationContext)(const void *context);
-    void (*OnRender)(uint32_t *pixels, const int64_t w, const int64_t h);
-    void (*OnInput)(const char code); // TODO: REFACTOR THIS TO USE A CUSTOM MODEL THAT HANDLES KEYBOARD,JOYSTICKS AND MOUSE
-    void (*Loop)(uint32_t frameTicks, uint32_t deltaTime);
+    EmulationInstance (*CreateInstance)(); // Zeroed instance, every other entry point takes it
+    void (*DestroyInstance)(EmulationInstance instance);
+    uint8_t (*Initialize)(EmulationInstance instance, int argc, const char **argv); // Optional (NULL when the emulator doesn't need it)
+    long (*LoadProgram)(EmulationInstance instance, const char *filePath);
+    void (*QuitProgram)(EmulationInstance instance); // Releases the program resources, the instance can be initialized again
+    int (*TickEmulation)(EmulationInstance instance); // Single step (debugging), hosts should use RunCycles/RunFrame
+    uint64_t (*RunCycles)(EmulationInstance instance, const uint64_t budget); // Runs until budget cycles are consumed or the cpu stops, returns the consumed cycles
+    uint64_t (*RunFrame)(EmulationInstance instance); // One display frame worth of cycles (timers included), returns the consumed cycles
+    void (*TickTimers)(EmulationInstance instance);
+    void (*OnRender)(EmulationInstance instance, uint32_t *pixels, const int64_t w, const int64_t h);
+    void (*OnInput)(EmulationInstance instance, const char code); // TODO: REFACTOR THIS TO USE A CUSTOM MODEL THAT HANDLES KEYBOARD,JOYSTICKS AND MOUSE
+    int (*DumpRegisters)(EmulationInstance instance, char *buffer, const size_t size); // CPU registers as a JSON object (snprintf result)
 } Emulation;
 
 typedef struct
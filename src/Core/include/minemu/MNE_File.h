@@ -6,7 +6,8 @@
 #include <stdint.h>
 
 
-long MNE_ReadFile(const char *filePath, const uint8_t flags, void (*callback)(const uint8_t *buffer,size_t bytesRead));
+// context is passed back to the callback untouched (e.g. the emulator instance that receives the file)
+long MNE_ReadFile(const char *filePath, const uint8_t flags, void (*callback)(void *context, const uint8_t *buffer, size_t bytesRead), void *context);
 
 
 #endif
\ No newline at end of file
@@ -3,10 +3,85 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
+
+/*
+    LOGGING:
+    - MNE_Log always prints (reports, dumps, stats...), don't use it on emulation hot paths.
+    - MNE_LogAt(moduleLevel, level, ...) prints when level <= moduleLevel. Both are compile time constants so the whole call
+      goes away below the configured level. Every module defines its own level (defaulting to MNE_LOG_LEVEL, see GB_Log.h).
+    - MNE_Trace(moduleLevel, format, args) records into a per thread ring buffer (format pointer + raw arguments, no printf).
+      The last entries are only formatted on demand with MNE_TraceDump. Trace formats must be string literals and only use
+      integer conversions (%u %x %X %02X...), every argument is stored as uint32_t.
+    - MNE_LOG_LEVEL comes from the MINEMU_LOG_LEVEL build option.
+*/
+
+#define MNE_LOG_NONE  0
+#define MNE_LOG_ERROR 1
+#define MNE_LOG_WARN  2
+#define MNE_LOG_INFO  3
+#define MNE_LOG_DEBUG 4
+#define MNE_LOG_TRACE 5
+
+#ifndef MNE_LOG_LEVEL
+#define MNE_LOG_LEVEL MNE_LOG_INFO
+#endif
 
 //TODO: IMPLEMENT A REAL ONE OR USE SPDLG...
 #define MNE_Log(msg...) printf(msg)
 
+#define MNE_LogAt(moduleLevel, level, msg...) \
+    do                                        \
+    {                                         \
+        if ((moduleLevel) >= (level))         \
+        {                                     \
+            printf(msg);                      \
+        }                                     \
+    } while (0)
+
+// ---------------------------- Trace ring buffer
+
+// Entries kept per thread (power of 2)
+#define MNE_TRACE_LENGHT 4096
+#define MNE_TRACE_ARGS 4
+
+#define MNE_THREAD_LOCAL __thread
+
+typedef struct
+{
+    const char *format;
+    uint32_t    args[MNE_TRACE_ARGS];
+} MNE_TraceEntry;
+
+typedef struct
+{
+    uint64_t       count; // Recorded entries since the last clear (only the last MNE_TRACE_LENGHT are kept)
+    MNE_TraceEntry entries[MNE_TRACE_LENGHT];
+} MNE_TraceBuffer;
+
+extern MNE_THREAD_LOCAL MNE_TraceBuffer mne_traceBuffer;
+
+static inline void MNE_TraceRecord(const char *format, const uint32_t *args)
+{
+    MNE_TraceEntry *entry = &mne_traceBuffer.entries[mne_traceBuffer.count++ & (MNE_TRACE_LENGHT - 1)];
+
+    entry->format = format;
+    memcpy(entry->args, args, sizeof(entry->args));
+}
+
+#define MNE_Trace(moduleLevel, format, args...)                                          \
+    do                                                                                  \
+    {                                                                                   \
+        if ((moduleLevel) >= MNE_LOG_TRACE)                                             \
+        {                                                                               \
+            MNE_TraceRecord(format, (const uint32_t[MNE_TRACE_ARGS]){args});            \
+        }                                                                               \
+    } while (0)
+
+// Prints the last count entries of the calling thread (oldest first)
+void MNE_TraceDump(size_t count);
+void MNE_TraceClear();
+
 void MNE_HexDump(uint8_t *buffer, const size_t size);
 
-#endif
\ No newline at end of file
+#endif
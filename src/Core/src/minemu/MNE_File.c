@@ -2,7 +2,7 @@
 #include <minemu/MNE_Flags.h>
 #include <minemu/MNE_Memory.h>
 
-long MNE_ReadFile(const char *filePath, const uint8_t flags, void (*callback)(const uint8_t *buffer,size_t bytesRead))
+long MNE_ReadFile(const char *filePath, const uint8_t flags, void (*callback)(void *context, const uint8_t *buffer, size_t bytesRead), void *context)
 {
     long file_size = 0;
     uint8_t *buffer = NULL;
@@ -12,7 +12,8 @@ long MNE_ReadFile(const char *filePath, const uint8_t flags, void (*callback)(co
     if (file == NULL)
     {
         MNE_Log("Unable to open file %s\n", filePath);
-        callback(NULL, 0);
+        callback(context, NULL, 0);
+        return 0;
     }
 
     // Get the size of the file
@@ -33,7 +34,7 @@ long MNE_ReadFile(const char *filePath, const uint8_t flags, void (*callback)(co
         MNE_HexDump(buffer, bytes_read);
     }
 
-    callback(buffer, bytes_read);
+    callback(context, buffer, bytes_read);
     // Clean up resources
     free(buffer);
     fclose(file);
@@ -1,5 +1,32 @@
 #include <minemu/MNE_Log.h>
 
+MNE_THREAD_LOCAL MNE_TraceBuffer mne_traceBuffer;
+
+void MNE_TraceDump(size_t count)
+{
+    const uint64_t recorded = mne_traceBuffer.count;
+    const uint64_t available = recorded < MNE_TRACE_LENGHT ? recorded : MNE_TRACE_LENGHT;
+
+    if (count > available)
+    {
+        count = (size_t)available;
+    }
+
+    MNE_Log("[TRACE] LAST %zu OF %llu ENTRIES\n", count, (unsigned long long)recorded);
+
+    for (uint64_t i = recorded - count; i < recorded; i++)
+    {
+        const MNE_TraceEntry *entry = &mne_traceBuffer.entries[i & (MNE_TRACE_LENGHT - 1)];
+
+        MNE_Log(entry->format, entry->args[0], entry->args[1], entry->args[2], entry->args[3]);
+    }
+}
+
+void MNE_TraceClear()
+{
+    mne_traceBuffer.count = 0;
+}
+
 void MNE_HexDump(uint8_t *buffer, const size_t size)
 {
     // Print header
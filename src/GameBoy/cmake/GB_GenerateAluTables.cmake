@@ -0,0 +1,122 @@
+# Generates the Game Boy 8 bit ALU lookup tables (DAA, INC/DEC flags, ADD/SUB half carry)
+# usage: cmake -DOUTPUT=GB_AluTables.c -P GB_GenerateAluTables.cmake
+# Flags use the F register layout (Z:0x80, N:0x40, H:0x20, C:0x10), same as the opcode tables
+cmake_minimum_required(VERSION 3.19)
+
+# Appends one value to a table, 16 values per row
+function(gb_table_append table index value)
+    math(EXPR value "${value}" OUTPUT_FORMAT HEXADECIMAL)
+    set(values "${${table}}${value}, ")
+    math(EXPR rowEnd "${index} % 16")
+    if (rowEnd EQUAL 15)
+        string(APPEND values "\n    ")
+    endif()
+    set(${table} "${values}" PARENT_SCOPE)
+endfunction()
+
+function(gb_table_source type name lenght table out)
+    string(REPLACE " \n" "\n" values "${${table}}")
+    string(STRIP "${values}" values)
+    set(${out} "const ${type} ${name}[${lenght}] = {\n    ${values}\n};\n\n" PARENT_SCOPE)
+endfunction()
+
+# DAA: index = A | N << 8 | H << 9 | C << 10, entry = A | F << 8 (N kept, H cleared)
+set(daa "")
+foreach(index RANGE 2047)
+    math(EXPR a "${index} & 0xFF")
+    # (not named n: if(N) is the false constant)
+    math(EXPR subtract "(${index} >> 8) & 1")
+    math(EXPR halfCarry "(${index} >> 9) & 1")
+    math(EXPR carry "(${index} >> 10) & 1")
+    math(EXPR lowNibble "${a} & 0x0F")
+
+    if (subtract)
+        if (carry)
+            math(EXPR a "(${a} - 0x60) & 0xFF")
+        endif()
+        if (halfCarry)
+            math(EXPR a "(${a} - 0x06) & 0xFF")
+        endif()
+    else()
+        if (carry OR a GREATER 153) # 0x99
+            math(EXPR a "(${a} + 0x60) & 0xFF")
+            set(carry 1)
+        endif()
+        if (halfCarry OR lowNibble GREATER 9)
+            math(EXPR a "(${a} + 0x06) & 0xFF")
+        endif()
+    endif()
+
+    set(flags 0)
+    if (a EQUAL 0)
+        math(EXPR flags "${flags} | 0x80")
+    endif()
+    if (subtract)
+        math(EXPR flags "${flags} | 0x40")
+    endif()
+    if (carry)
+        math(EXPR flags "${flags} | 0x10")
+    endif()
+
+    gb_table_append(daa ${index} "${a} | (${flags} << 8)")
+endforeach()
+
+# INC/DEC: index = operand, C is not affected
+set(inc "")
+set(dec "")
+foreach(value RANGE 255)
+    math(EXPR lowNibble "${value} & 0x0F")
+
+    set(flags 0)
+    if (value EQUAL 255)
+        math(EXPR flags "${flags} | 0x80")
+    endif()
+    if (lowNibble EQUAL 15)
+        math(EXPR flags "${flags} | 0x20")
+    endif()
+    gb_table_append(inc ${value} ${flags})
+
+    set(flags 0x40)
+    if (value EQUAL 1)
+        math(EXPR flags "${flags} | 0x80")
+    endif()
+    if (lowNibble EQUAL 0)
+        math(EXPR flags "${flags} | 0x20")
+    endif()
+    gb_table_append(dec ${value} ${flags})
+endforeach()
+
+# ADD/SUB N and H flags: index = (a & 0x0F) << 5 | (b & 0x0F) << 1 | carry (Z and C need the whole operands)
+set(add "")
+set(sub "")
+foreach(index RANGE 511)
+    math(EXPR a "(${index} >> 5) & 0x0F")
+    math(EXPR b "(${index} >> 1) & 0x0F")
+    math(EXPR carry "${index} & 1")
+
+    math(EXPR sum "${a} + ${b} + ${carry}")
+    set(flags 0)
+    if (sum GREATER 15)
+        set(flags 0x20)
+    endif()
+    gb_table_append(add ${index} ${flags})
+
+    math(EXPR difference "${a} - ${b} - ${carry}")
+    set(flags 0x40)
+    if (difference LESS 0)
+        set(flags 0x60)
+    endif()
+    gb_table_append(sub ${index} ${flags})
+endforeach()
+
+gb_table_source(uint16_t gb_daa_table GB_DAA_TABLE_LENGHT daa DAA_SOURCE)
+gb_table_source(uint8_t gb_inc_flags GB_INC_DEC_TABLE_LENGHT inc INC_SOURCE)
+gb_table_source(uint8_t gb_dec_flags GB_INC_DEC_TABLE_LENGHT dec DEC_SOURCE)
+gb_table_source(uint8_t gb_add_flags GB_ADD_SUB_TABLE_LENGHT add ADD_SOURCE)
+gb_table_source(uint8_t gb_sub_flags GB_ADD_SUB_TABLE_LENGHT sub SUB_SOURCE)
+
+file(WRITE ${OUTPUT}
+"// GENERATED FILE, DO NOT EDIT (generator: cmake/GB_GenerateAluTables.cmake)
+#include <SOC/GB_AluTables.h>
+
+${DAA_SOURCE}${INC_SOURCE}${DEC_SOURCE}${ADD_SOURCE}${SUB_SOURCE}")
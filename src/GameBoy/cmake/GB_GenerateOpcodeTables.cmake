@@ -0,0 +1,135 @@
+# Generates the Game Boy opcode tables (names, lengths, cycles and flags) from DOCS/gameboy-opcodes.json
+# usage: cmake -DINPUT=gameboy-opcodes.json -DOUTPUT=GB_OpcodeTables.c -P GB_GenerateOpcodeTables.cmake
+cmake_minimum_required(VERSION 3.19) # string(JSON)
+
+file(READ ${INPUT} GB_OPCODES_JSON)
+
+# The file starts with a "// source:" comment line, json starts at the first brace
+string(FIND "${GB_OPCODES_JSON}" "{" GB_JSON_BEGIN)
+string(SUBSTRING "${GB_OPCODES_JSON}" ${GB_JSON_BEGIN} -1 GB_OPCODES_JSON)
+
+set(GB_HEX_DIGITS 0 1 2 3 4 5 6 7 8 9 A B C D E F)
+
+# Opcode key as written on the json file (0x0A)
+function(gb_opcode_key opcode out)
+    math(EXPR high "${opcode} >> 4")
+    math(EXPR low "${opcode} & 15")
+    list(GET GB_HEX_DIGITS ${high} highDigit)
+    list(GET GB_HEX_DIGITS ${low} lowDigit)
+    set(${out} "0x${highDigit}${lowDigit}" PARENT_SCOPE)
+endfunction()
+
+# Flags bit mask (Z:0x80, N:0x40, H:0x20, C:0x10) for the flags matching the requested effect
+function(gb_flags_mask opcodeJson effect out)
+    set(mask 0)
+    set(bit 128)
+    foreach(flag Z N H C)
+        string(JSON value GET "${opcodeJson}" flags ${flag})
+        if ((effect STREQUAL "affected" AND NOT value STREQUAL "-") OR
+            (effect STREQUAL "set" AND value STREQUAL "1") OR
+            (effect STREQUAL "reset" AND value STREQUAL "0"))
+            math(EXPR mask "${mask} | ${bit}")
+        endif()
+        math(EXPR bit "${bit} >> 1")
+    endforeach()
+    math(EXPR mask "${mask}" OUTPUT_FORMAT HEXADECIMAL)
+    set(${out} ${mask} PARENT_SCOPE)
+endfunction()
+
+# Mnemonic with operands, example: "LD (HL+),A"
+function(gb_opcode_name opcodeJson out)
+    string(JSON name GET "${opcodeJson}" mnemonic)
+    string(JSON operandsCount LENGTH "${opcodeJson}" operands)
+    set(separator " ")
+
+    if (operandsCount GREATER 0)
+        math(EXPR lastOperand "${operandsCount} - 1")
+        foreach(i RANGE ${lastOperand})
+            string(JSON operand GET "${opcodeJson}" operands ${i} name)
+            string(JSON immediate GET "${opcodeJson}" operands ${i} immediate)
+            string(JSON increment ERROR_VARIABLE noIncrement GET "${opcodeJson}" operands ${i} increment)
+            string(JSON decrement ERROR_VARIABLE noDecrement GET "${opcodeJson}" operands ${i} decrement)
+
+            if (NOT noIncrement AND increment)
+                string(APPEND operand "+")
+            elseif (NOT noDecrement AND decrement)
+                string(APPEND operand "-")
+            endif()
+
+            if (NOT immediate)
+                set(operand "(${operand})")
+            endif()
+
+            string(APPEND name "${separator}${operand}")
+
+            # SP+e8 (LD HL,SP+e8) is a single operand on the assembler syntax
+            if (immediate AND NOT noIncrement AND increment)
+                set(separator "")
+            else()
+                set(separator ",")
+            endif()
+        endforeach()
+    endif()
+
+    set(${out} "${name}" PARENT_SCOPE)
+endfunction()
+
+# Emits every table of one opcode group (unprefixed or cbprefixed)
+function(gb_generate_group group prefix out)
+    string(JSON groupJson GET "${GB_OPCODES_JSON}" ${group})
+
+    foreach(table names length cycles cycles_not_taken flags_affected flags_set flags_reset)
+        set(${table} "")
+    endforeach()
+
+    foreach(opcode RANGE 255)
+        gb_opcode_key(${opcode} key)
+        string(JSON opcodeJson GET "${groupJson}" ${key})
+
+        gb_opcode_name("${opcodeJson}" name)
+        string(JSON bytes GET "${opcodeJson}" bytes)
+        string(JSON cyclesCount LENGTH "${opcodeJson}" cycles)
+        string(JSON cyclesTaken GET "${opcodeJson}" cycles 0)
+        set(cyclesNotTaken ${cyclesTaken})
+        if (cyclesCount GREATER 1)
+            string(JSON cyclesNotTaken GET "${opcodeJson}" cycles 1)
+        endif()
+        gb_flags_mask("${opcodeJson}" affected flagsAffected)
+        gb_flags_mask("${opcodeJson}" set flagsSet)
+        gb_flags_mask("${opcodeJson}" reset flagsReset)
+
+        string(APPEND names "    \"${name}\", // ${key}\n")
+        string(APPEND length "${bytes}, ")
+        string(APPEND cycles "${cyclesTaken}, ")
+        string(APPEND cycles_not_taken "${cyclesNotTaken}, ")
+        string(APPEND flags_affected "${flagsAffected}, ")
+        string(APPEND flags_set "${flagsSet}, ")
+        string(APPEND flags_reset "${flagsReset}, ")
+
+        math(EXPR rowEnd "${opcode} % 16")
+        if (rowEnd EQUAL 15)
+            foreach(table length cycles cycles_not_taken flags_affected flags_set flags_reset)
+                string(APPEND ${table} "\n")
+            endforeach()
+        endif()
+    endforeach()
+
+    set(source "// ${group}\n")
+    string(APPEND source "const char *const ${prefix}_names[GB_OPCODES_TABLE_LENGHT] = {\n${names}};\n\n")
+    foreach(table length cycles cycles_not_taken flags_affected flags_set flags_reset)
+        string(REPLACE " \n" "\n    " values "    ${${table}}")
+        string(STRIP "${values}" values)
+        string(APPEND source "const uint8_t ${prefix}_${table}[GB_OPCODES_TABLE_LENGHT] = {\n    ${values}\n};\n\n")
+    endforeach()
+
+    set(${out} "${source}" PARENT_SCOPE)
+endfunction()
+
+gb_generate_group(unprefixed gb_opcodes UNPREFIXED_SOURCE)
+gb_generate_group(cbprefixed gb_cb_opcodes CB_SOURCE)
+
+file(WRITE ${OUTPUT}
+"// GENERATED FILE, DO NOT EDIT (source: DOCS/gameboy-opcodes.json, generator: cmake/GB_GenerateOpcodeTables.cmake)
+#include <SOC/GB_Opcodes.h>
+
+${UNPREFIXED_SOURCE}${CB_SOURCE}")
@@ -0,0 +1,23 @@
+# Generates the Game Boy tile row decode table (2bpp bitplane byte to eight pixels)
+# usage: cmake -DOUTPUT=GB_PpuTables.c -P GB_GeneratePpuTables.cmake
+cmake_minimum_required(VERSION 3.19)
+
+# tile_row_decode: index = bitplane byte, entry = bit of every pixel (leftmost pixel = bit 7 = first byte)
+set(rows "")
+foreach(value RANGE 255)
+    set(row "")
+    foreach(pixel RANGE 7)
+        math(EXPR bit "(${value} >> (7 - ${pixel})) & 1")
+        string(APPEND row "${bit}, ")
+    endforeach()
+    string(REGEX REPLACE ", $" "" row "${row}")
+    string(APPEND rows "    {${row}},\n")
+endforeach()
+
+file(WRITE ${OUTPUT}
+"// GENERATED FILE, DO NOT EDIT (generator: cmake/GB_GeneratePpuTables.cmake)
+#include <PPU/GB_PpuTables.h>
+
+const uint8_t gb_tile_row_decode[GB_TILE_ROW_DECODE_LENGHT][GB_TILE_ROW_PIXELS] = {
+${rows}};
+")
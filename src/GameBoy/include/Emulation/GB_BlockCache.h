@@ -0,0 +1,79 @@
+#ifndef GB_BLOCK_CACHE_H
+#define GB_BLOCK_CACHE_H
+
+#include <Emulation/GB_SystemContext.h>
+#include <Emulation/GB_Instruction.h>
+#include <Emulation/GB_Fusion.h>
+
+/*
+    BLOCK CACHE (cached interpreter):
+    - Straight-line runs of ROM code (ending on the first jump/call/ret/rst/halt/stop/ei/di) decoded once and keyed by PC (plus a boot rom overlay bit).
+    - Only code from the ROM banks (and the boot rom overlay) is cached, WRAM/HRAM/VRAM code always goes through GB_TickCpu.
+    - Any bus write to the ROM range (mbc registers), a GB_BusMapRomBank bank switch or loading a new program invalidates the whole cache (generation counter),
+      the switchable bank number is not part of the tag.
+    - With IME set and an interrupt pending the CPU single steps, a block also ends early when one of its IE/IF writes raises one.
+    - Handlers still fetch their own immediates from the bus, the block stores the resolved handler and instruction lenght.
+    - Enabled opcode sequences are decoded as one fused entry (superinstructions, GB_Fusion.h).
+*/
+
+// Direct mapped by PC
+#define GB_BLOCK_CACHE_LENGHT 0x400
+#define GB_BLOCK_MAX_INSTRUCTIONS 16
+
+typedef struct
+{
+    instructionFnPtrGb handler;
+    uint8_t opcode;
+    uint8_t lenght; // bytes (opcode + operands)
+    uint8_t count;  // instructions (more than one when fused)
+    uint8_t fusion; // GB_FusionId
+} GB_BlockInstruction;
+
+typedef struct
+{
+    uint32_t tag;        // boot rom overlay bit (0x10000) | start PC
+    uint32_t generation; // cache generation when decoded (stale when it doesn't match)
+    uint16_t leadCycles; // cycles of every instruction but the last one (they never branch)
+    uint16_t cycles;     // summed cycles (last instruction taken path)
+    uint8_t  lenght;     // entries (fused sequences count as one)
+    GB_BlockInstruction instructions[GB_BLOCK_MAX_INSTRUCTIONS];
+} GB_Block;
+
+typedef struct
+{
+    uint64_t lookups;       // GB_BlockCacheRun calls
+    uint64_t hits;          // valid block found
+    uint64_t misses;        // block decoded
+    uint64_t fallbacks;     // not cacheable (RAM code, IME set, budget, NOP/invalid opcode)
+    uint64_t invalidations;
+    uint64_t interrupted;   // blocks cut short by an invalidation while running
+    uint64_t executedBlocks;
+    uint64_t executedInstructions;
+    uint64_t lenghtHistogram[GB_BLOCK_MAX_INSTRUCTIONS + 1]; // decoded blocks by entry count
+    uint64_t fusions[GB_FUSION_COUNT];                       // decoded fused entries by GB_FusionId
+} GB_BlockCacheStats;
+
+typedef struct GB_BlockCache
+{
+    uint32_t generation;
+    uint32_t fusions; // enabled GB_FusionId bits
+    GB_BlockCacheStats stats;
+    GB_Block blocks[GB_BLOCK_CACHE_LENGHT];
+} GB_BlockCache;
+
+GB_BlockCache *GB_BlockCacheCreate();
+void           GB_BlockCacheDestroy(GB_BlockCache *cache);
+void           GB_BlockCacheInvalidate(GB_BlockCache *cache);
+// Enabled superinstructions (GB_FUSION_BIT mask, 0 disables fusion), invalidates the cache
+void           GB_BlockCacheSetFusions(GB_BlockCache *cache, const uint32_t fusions);
+
+// Valid block starting at PC (decoded on a miss) or NULL when the caller has to single step (see GB_BlockCacheRun)
+GB_Block      *GB_BlockCacheLookup(EmulationState *ctx, const uint16_t budget);
+// Interprets the block, returns consumed cycles
+uint16_t       GB_BlockCacheExecute(EmulationState *ctx, const GB_Block *block);
+
+// Runs one cached block if the block fits on budget (its leading instructions can't cross it), returns 0 when the caller has to single step
+uint8_t        GB_BlockCacheRun(EmulationState *ctx, const uint16_t budget, uint16_t *cycles);
+void           GB_BlockCachePrintStats(const GB_BlockCache *cache);
+
+#endif
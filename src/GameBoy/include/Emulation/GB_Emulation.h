@@ -7,34 +7,69 @@
 
 #include <minemu.h>
 #include <Emulation/GB_Instruction.h>
+#include <Emulation/GB_BlockCache.h>
+#include <Emulation/GB_IdleLoop.h>
+#include <Emulation/GB_Jit.h>
+#include <Emulation/GB_Profiler.h>
 #include <Memory/GB_Header.h>
+#include <PPU/GB_TileCache.h>
 #include <SOC/GB_LCD.h>
+#include <SOC/GB_Timer.h>
+#include <SOC/GB_Serial.h>
 #include <SOC/GB_Bus.h>
 #include <SOC/GB_CPU.h>
+#include <SOC/GB_CPU_Threaded.h>
+#include <SOC/GB_ALU.h>
+#include <SOC/GB_Interrupt.h>
 #include <SOC/GB_Opcodes.h>
 
 //0XD3 IS THE FIRST NOT VALID DMG OPCODE 
 #define GB_INVALID_INSTRUCTION 0xD3
 
+// ONE ENTRY PER OPCODE (0x00 - 0xFF)
+#define GB_DISPATCH_TABLE_LENGHT 0x100
+
 // CPU FREQ  4.194304 hz or 238.41857910156 ns
 #define GB_DMG_CPU_FREQ_NS 238.41f
 
-EmulationInfo GB_GetInfo();
-uint8_t       GB_Initialize(int argc, const char ** argv);
-long          GB_LoadProgram(const char *filePath);
-void          GB_QuitProgram();
-void          GB_TickTimers();
-int           GB_TickEmulation();
-void          GB_SetEmulationContext(const void *context);
-void          GB_OnRender(uint32_t* pixels, const int64_t w, const int64_t h);
+// 154 LINES * 456 CLOCK CYCLES
+#define GB_FRAME_CYCLES 70224
+
+// Every entry point takes the EmulationState instance (no global machine, one instance per thread)
+EmulationInfo     GB_GetInfo();
+EmulationInstance GB_CreateInstance();
+void              GB_DestroyInstance(EmulationInstance instance);
+uint8_t           GB_Initialize(EmulationInstance instance, int argc, const char ** argv);
+long              GB_LoadProgram(EmulationInstance instance, const char *filePath);
+void              GB_QuitProgram(EmulationInstance instance);
+void              GB_TickTimers(EmulationInstance instance);
+int               GB_TickEmulation(EmulationInstance instance);
+uint64_t          GB_RunCycles(EmulationInstance instance, const uint64_t budget);
+uint64_t          GB_RunFrame(EmulationInstance instance);
+void              GB_OnRender(EmulationInstance instance, uint32_t* pixels, const int64_t w, const int64_t h);
+int               GB_DumpRegisters(EmulationInstance instance, char *buffer, const size_t size);
+// Opcode profiler on/off (GB_Profiler.h), the counters survive until GB_QuitProgram dumps them
+void              GB_SetProfiling(EmulationInstance instance, const uint8_t enabled);
+// Frame skip: rasterize every Nth frame from the next frame on (0: none, right away), LY/STAT and interrupts keep their timing
+void              GB_SetRenderInterval(EmulationInstance instance, const uint16_t interval);
 
 // INTERNAL
-uint8_t             GB_TickCpu();
-uint8_t             GB_HandleInterrupts();
+uint8_t             GB_TickCpu(EmulationState *ctx);
+uint8_t             GB_HandleInterrupts(EmulationState *ctx);
+uint8_t             GB_InvalidInstruction(EmulationState *ctx, const uint8_t instr);
+
+// Moves the master clock and dispatches every scheduler event that became due
+void                GB_AdvanceClock(EmulationState *ctx, const uint16_t cycles);
+// Cycles the CPU can run before the next event (batch budget of the threaded/cached/JIT cores)
+uint16_t            GB_CyclesUntilNextEvent(const EmulationState *ctx);
+// Fraction of the emulated cycles skipped while the cpu was halted (HALT/STOP fast-forward)
+double              GB_HaltedRatio(const EmulationState *ctx);
 
-void                GB_PopulateMemory(const uint8_t *buffer, size_t bytesRead);
+void                GB_PopulateMemory(void *instance, const uint8_t *buffer, size_t bytesRead);
 GameBoyInstruction* GB_FetchInstruction(const uint8_t opcode);
-void                GB_ParseRom(const uint8_t *buffer, size_t size);
+GameBoyInstruction* GB_DecodeInstruction(const uint8_t opcode);
+void                GB_BuildDispatchTable(); // Thread safe, only the first call builds the tables
+void                GB_ParseRom(EmulationState *ctx, const uint8_t *buffer, size_t size);
 void                GB_PrintRomInfo(const GB_Header * header);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef GB_FUSION_H
+#define GB_FUSION_H
+
+#include <Emulation/GB_SystemContext.h>
+#include <Emulation/GB_Instruction.h>
+
+/*
+    SUPERINSTRUCTIONS (block cache):
+    - Common opcode sequences are decoded into one block entry with a fused handler (GB_BlockCacheDecode), the entry
+      still counts as every instruction it covers (instructions, INSTRUCTION register, PC).
+    - Fused handlers return the summed cycles of the original instructions (branch taken or not), the block budget check
+      keeps using the original instruction boundaries so the LCD sees the same timing.
+    - Only the last instruction of a sequence can branch or write the bus (rom writes invalidate the cache between entries).
+    - The enabled set is a mask of GB_FusionId bits (GB_BlockCacheSetFusions), pick new ones from the pair report.
+
+    OPCODE PAIR PROFILE:
+    - GB_TickCpu counts every executed opcode pair while ctx->pairProfile is set (single stepped instructions only, run it
+      on the function pointer core for a complete profile).
+*/
+
+#define GB_FUSION_MAX_LENGHT 3
+#define GB_PAIR_PROFILE_LENGHT 0x10000
+// Pairs printed when an instance with a profile quits
+#define GB_PAIR_PROFILE_REPORT_LENGHT 16
+
+typedef enum
+{
+    GB_FUSION_NONE,
+    GB_FUSION_LDI_A_HL_LD_DE_A,  // copy loops:     LD A,(HL+); LD (DE),A
+    GB_FUSION_DEC_B_JR_NZ,       // counters:       DEC B; JR NZ,e
+    GB_FUSION_DEC_C_JR_NZ,       //                 DEC C; JR NZ,e
+    GB_FUSION_LD_A_B_OR_C_JR_NZ, // 16 bit counter: LD A,B; OR C; JR NZ,e
+    GB_FUSION_LDH_A_N_CP_N,      // polling:        LDH A,(n); CP n
+    GB_FUSION_COUNT
+} GB_FusionId;
+
+#define GB_FUSION_BIT(id) (1u << (id))
+#define GB_FUSION_DEFAULT (((1u << GB_FUSION_COUNT) - 1) & ~GB_FUSION_BIT(GB_FUSION_NONE))
+
+typedef struct
+{
+    const char        *name;
+    uint8_t            opcodes[GB_FUSION_MAX_LENGHT];
+    uint8_t            lenght; // instructions
+    uint8_t            bytes;  // opcodes + operands
+    instructionFnPtrGb handler;
+} GB_Fusion;
+
+typedef struct GB_PairProfile
+{
+    uint16_t previous;                       // last opcode (0x100 before the first one)
+    uint64_t counts[GB_PAIR_PROFILE_LENGHT]; // first << 8 | second
+} GB_PairProfile;
+
+const GB_Fusion *GB_FusionGet(const uint8_t id);
+// Enabled sequence starting at pc (none when it would go past regionEnd)
+uint8_t          GB_FusionMatch(EmulationState *ctx, const uint16_t pc, const uint16_t regionEnd, const uint32_t enabled);
+
+GB_PairProfile  *GB_PairProfileCreate();
+void             GB_PairProfileDestroy(GB_PairProfile *profile);
+
+static inline void GB_PairProfileRecord(GB_PairProfile *profile, const uint8_t opcode)
+{
+    if (profile->previous <= 0xFF)
+    {
+        profile->counts[(profile->previous << 8) | opcode]++;
+    }
+
+    profile->previous = opcode;
+}
+
+// Most executed pairs, the ones starting a fusion are marked
+void             GB_PairProfilePrintReport(const GB_PairProfile *profile, const uint16_t top);
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef GB_IDLE_LOOP_H
+#define GB_IDLE_LOOP_H
+
+#include <Emulation/GB_SystemContext.h>
+
+/*
+    IDLE LOOP DETECTION (polling spin loops):
+    - Short loops reached by a backward branch (LDH A,(LY); CP n; JR NZ) whose only side effect is reading a register that
+      changes on its own (IF, STAT, LY: scheduler events, DIV/TIMA: timer clock) are decoded once and keyed by their head PC.
+    - Accepted bodies only write A and F: LDH A,(n) / LD A,(nn) of the polled register, CP/AND/OR/XOR n, AND A, OR A, CP A,
+      BIT b,A and the closing JR/JP (cc) back to the head.
+    - Before skipping, two iterations run for real: when both branch back with the same registers every following iteration
+      until the polled register changes is identical, so the clock jumps over whole iterations (GB_IdleLoopRun).
+    - The skip never crosses the step budget (next scheduler event) or the next DIV/TIMA change.
+    - TODO: LD A,(C) POLLING AND LOOPS THAT ALSO COUNT (DEC B; JR NZ) ARE NOT DETECTED
+*/
+
+// Direct mapped by the loop head PC
+#define GB_IDLE_LOOP_CACHE_LENGHT 0x40
+// Bytes from the loop head to the end of the branch
+#define GB_IDLE_LOOP_MAX_LENGHT 16
+// Iterations that have to fit on the budget (two of them are executed to prove the loop is idle)
+#define GB_IDLE_LOOP_MIN_ITERATIONS 2
+
+typedef enum
+{
+    GB_IDLE_LOOP_UNKNOWN,  // not decoded yet
+    GB_IDLE_LOOP_REJECTED, // not a polling loop
+    GB_IDLE_LOOP_ACCEPTED
+} GB_IdleLoopState;
+
+typedef struct
+{
+    uint16_t start;         // loop head (branch target)
+    uint16_t end;           // last byte of the closing branch
+    uint16_t polledAddress; // register read by the loop (0 when it only spins on A/F)
+    uint16_t cycles;        // per iteration (branch taken)
+    uint8_t  instructions;  // per iteration
+    uint8_t  lenght;        // bytes
+    uint8_t  state;         // GB_IdleLoopState
+    uint8_t  code[GB_IDLE_LOOP_MAX_LENGHT]; // loop bytes, compared before every skip (RAM code can change)
+    uint64_t skips;
+    uint64_t skippedCycles;
+} GB_IdleLoop;
+
+typedef struct GB_IdleLoopCache
+{
+    uint16_t    previousPC;    // PC of the previous step (backward branch detection)
+    uint64_t    skippedCycles; // every loop
+    GB_IdleLoop loops[GB_IDLE_LOOP_CACHE_LENGHT];
+} GB_IdleLoopCache;
+
+GB_IdleLoopCache *GB_IdleLoopCacheCreate();
+void              GB_IdleLoopCacheDestroy(GB_IdleLoopCache *cache);
+// Forgets every decoded loop (new program)
+void              GB_IdleLoopCacheReset(GB_IdleLoopCache *cache);
+
+// Skips whole iterations when PC is the head of an idle polling loop, returns 0 when the caller has to step the cpu
+uint8_t           GB_IdleLoopRun(EmulationState *ctx, const uint16_t budget, uint16_t *cycles);
+// Detected loops with their PC ranges and skipped cycles
+void              GB_IdleLoopPrintReport(const GB_IdleLoopCache *cache);
+
+#endif
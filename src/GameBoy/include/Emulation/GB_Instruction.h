@@ -21,4 +21,19 @@ typedef struct {
 #define GB_INSTRUCTION(mask, opcode, handler)  {mask, opcode, (instructionFnPtrGb)handler}
 #endif
 
+// CB prefixed instructions are fully decoded when the table is built (no masks at runtime)
+// Handlers work on the operand byte in place, GB_CB_PREFIX resolves it (register in the context or a (HL) bus copy)
+typedef void (*cbInstructionFnPtrGb)(EmulationState *ctx, uint8_t *operand, const uint8_t b);
+
+// Operand of the (HL) encoding, read from the bus before the handler and written back after it
+#define GB_CB_OPERAND_HL 0xFFFF
+
+typedef struct {
+    cbInstructionFnPtrGb handler;
+    uint16_t operand;   // Operand register offset in EmulationState (the table is shared by every instance), GB_CB_OPERAND_HL for (HL)
+    uint8_t  b;         // Bit index (BIT, RES, SET)
+    uint8_t  writeBack; // (HL) result written back to the bus (everything but BIT)
+    uint8_t  cycles;    // Clock cycles including the prefix fetch
+} GameBoyCBInstruction;
+
 #endif
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef GB_JIT_H
+#define GB_JIT_H
+
+#include <Emulation/GB_SystemContext.h>
+#include <Emulation/GB_BlockCache.h>
+
+/*
+    JIT (x86-64, MINEMU_GB_CPU_CORE=JIT):
+    - Hot block cache entries (GB_BlockCache.h) are translated into x86-64 code on an mmap'ed executable arena.
+    - EmulationState stays the canonical state, native code works directly on GB_Registers (no register allocation across blocks).
+    - Flag-less register ops (LD r,r' LD r,n LD rr,nn INC rr DEC rr) are emitted as native code, everything else calls the
+      GB_CPU.c handler, so the result is the same as GB_BlockCacheExecute.
+    - Blocks touching I/O registers (LDH) or without any native instruction stay on the interpreter; a rom write while
+      running (bank switch, self modifying code) leaves the block right after the handler that did it.
+    - Lockstep mode runs every native block on the interpreter as well and compares registers, cycles and memory.
+*/
+
+// Interpreted executions before a block is translated
+#define GB_JIT_HOT_THRESHOLD 8
+#define GB_JIT_ARENA_SIZE (1024 * 1024)
+
+typedef struct
+{
+    uint64_t compiled;
+    uint64_t rejected;         // I/O blocks or blocks without native instructions
+    uint64_t nativeRuns;
+    uint64_t interpretedRuns;
+    uint64_t nativeInstructions;
+    uint64_t calledInstructions; // handler call-outs
+    uint64_t arenaFlushes;
+    uint64_t lockstepBlocks;
+    uint64_t lockstepMismatches;
+} GB_JitStats;
+
+typedef struct GB_Jit GB_Jit;
+
+#ifdef GB_JIT
+
+GB_Jit            *GB_JitCreate();
+void               GB_JitDestroy(GB_Jit *jit);
+void               GB_JitSetLockstep(GB_Jit *jit, const uint8_t enabled);
+const GB_JitStats *GB_JitGetStats(const GB_Jit *jit);
+void               GB_JitPrintStats(const GB_Jit *jit);
+
+// Same contract as GB_BlockCacheRun (needs ctx->blockCache and ctx->jit), returns 0 when the caller has to single step
+uint8_t            GB_JitRun(EmulationState *ctx, const uint16_t budget, uint16_t *cycles);
+
+#endif
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef GB_LOG_H
+#define GB_LOG_H
+
+#include <minemu/MNE_Log.h>
+
+/*
+    GAME BOY LOG SUBSYSTEMS (MNE_Log.h):
+    - Every subsystem level defaults to MNE_LOG_LEVEL and can be overriden at build time (e.g. -DGB_LOG_LEVEL_BUS=MNE_LOG_TRACE).
+    - Hot paths (bus accesses, io registers, executed instructions) only use GB_Trace, never GB_Log.
+    - usage: GB_Log(BUS, WARN, "...", ...) GB_Trace(CPU, "...", ...)
+*/
+
+#ifndef GB_LOG_LEVEL_CPU
+#define GB_LOG_LEVEL_CPU MNE_LOG_LEVEL
+#endif
+
+#ifndef GB_LOG_LEVEL_BUS
+#define GB_LOG_LEVEL_BUS MNE_LOG_LEVEL
+#endif
+
+#ifndef GB_LOG_LEVEL_IO
+#define GB_LOG_LEVEL_IO MNE_LOG_LEVEL
+#endif
+
+#ifndef GB_LOG_LEVEL_EMULATION
+#define GB_LOG_LEVEL_EMULATION MNE_LOG_LEVEL
+#endif
+
+#ifndef GB_LOG_LEVEL_JIT
+#define GB_LOG_LEVEL_JIT MNE_LOG_LEVEL
+#endif
+
+#define GB_Log(subsystem, level, msg...) MNE_LogAt(GB_LOG_LEVEL_##subsystem, MNE_LOG_##level, msg)
+#define GB_Trace(subsystem, format, args...) MNE_Trace(GB_LOG_LEVEL_##subsystem, format, args)
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef GB_PROFILER_H
+#define GB_PROFILER_H
+
+#include <Emulation/GB_SystemContext.h>
+#include <Emulation/GB_Instruction.h>
+
+/*
+    OPCODE PROFILER:
+    - Toggled at runtime (GB_SetProfiling), while it is on every instruction is single stepped through GB_TickCpu and
+      timed (no blocks, JIT, threaded batches or idle loop skips), off it costs one byte test per GB_StepCpu.
+    - Executions, emulated cycles and host nanoseconds per opcode, CB opcodes are counted on their own table (not on 0xCB).
+    - Handlers are aggregated when reporting (every opcode decoded to the same function).
+    - Host time is measured around GB_TickCpu, the cost of reading the clock (measured at creation) is subtracted.
+    - GB_QuitProgram prints the table sorted by host time and writes every executed row to csvPath.
+*/
+
+#define GB_PROFILER_TABLE_LENGHT 0x100
+#define GB_PROFILER_CSV_PATH_LENGHT 512
+// Rows printed when an instance with a profiler quits
+#define GB_PROFILER_REPORT_LENGHT 24
+#define GB_PROFILER_DEFAULT_CSV_PATH "gb_profile.csv"
+
+typedef struct
+{
+    uint64_t executions;
+    uint64_t cycles;      // emulated clock cycles
+    uint64_t nanoseconds; // host time
+} GB_ProfilerEntry;
+
+typedef struct GB_Profiler
+{
+    GB_ProfilerEntry opcodes[GB_PROFILER_TABLE_LENGHT];
+    GB_ProfilerEntry cbOpcodes[GB_PROFILER_TABLE_LENGHT];
+    uint64_t         clockOverhead; // ns of one clock read
+    char             csvPath[GB_PROFILER_CSV_PATH_LENGHT];
+} GB_Profiler;
+
+GB_Profiler *GB_ProfilerCreate();
+void         GB_ProfilerDestroy(GB_Profiler *profiler);
+void         GB_ProfilerSetCsvPath(GB_Profiler *profiler, const char *path);
+
+// Single steps one instruction (GB_TickCpu) and records it on ctx->profiler
+uint8_t      GB_ProfilerStep(EmulationState *ctx);
+
+// Opcode, CB opcode and handler rows sorted by host time (top rows printed)
+void         GB_ProfilerPrintReport(const GB_Profiler *profiler, const uint16_t top);
+// One line per executed row (kind,code,name,executions,cycles,nanoseconds,ns_per_execution), 0 when the file can't be written
+uint8_t      GB_ProfilerWriteCsv(const GB_Profiler *profiler, const char *path);
+
+#endif
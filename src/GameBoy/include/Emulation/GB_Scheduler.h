@@ -0,0 +1,49 @@
+#ifndef GB_SCHEDULER_H
+#define GB_SCHEDULER_H
+
+#include <stdint.h>
+
+/*
+    EVENT SCHEDULER:
+    - Peripherals don't get ticked per instruction, they schedule their next event at an absolute master clock cycle
+      (EmulationState.cpuCycles) and the emulation loop dispatches them once the clock reaches the deadline (GB_AdvanceClock).
+    - Min-heap with one slot per event type (an event type is either pending once or not scheduled), so the cpu cores can run
+      until GB_SchedulerNextDeadline without looking at any peripheral.
+*/
+
+typedef enum
+{
+    GB_EVENT_PPU_MODE,       // PPU mode change (LY/LYC, STAT and VBLANK interrupts happen here)
+    GB_EVENT_TIMER_OVERFLOW, // TIMA overflow
+    GB_EVENT_DMA,            // OAM DMA end
+    GB_EVENT_SERIAL,         // Serial transfer end
+    GB_EVENT_COUNT
+} GB_EventType;
+
+typedef struct
+{
+    uint64_t deadline;
+    uint8_t  type;
+} GB_Event;
+
+typedef struct
+{
+    GB_Event heap[GB_EVENT_COUNT];
+    int8_t   slots[GB_EVENT_COUNT]; // Heap position of every event type (-1 not scheduled)
+    uint8_t  lenght;
+} GB_Scheduler;
+
+void     GB_SchedulerReset(GB_Scheduler *scheduler);
+void     GB_SchedulerSchedule(GB_Scheduler *scheduler, const GB_EventType type, const uint64_t deadline);
+void     GB_SchedulerCancel(GB_Scheduler *scheduler, const GB_EventType type);
+uint64_t GB_SchedulerDeadline(const GB_Scheduler *scheduler, const GB_EventType type);
+
+// Removes the earliest event if its deadline is <= now
+uint8_t  GB_SchedulerPopDue(GB_Scheduler *scheduler, const uint64_t now, GB_Event *event);
+
+static inline uint64_t GB_SchedulerNextDeadline(const GB_Scheduler *scheduler)
+{
+    return scheduler->lenght != 0 ? scheduler->heap[0].deadline : UINT64_MAX;
+}
+
+#endif
@@ -4,26 +4,99 @@
 #include <stdint.h>
 #include <SOC/GB_Registers.h>
 #include <Memory/GB_Header.h>
+#include <Emulation/GB_Scheduler.h>
+#include <PPU/GB_Pallete.h>
 
+// DIV/TIMA state (GB_Timer.h), counters are derived from the master clock
 typedef struct
 {
+    uint64_t divBase;  // Clock cycle of the last DIV reset
+    uint64_t timaBase; // Clock cycle where TIMA had the tima value
+    uint8_t  tima;
+    uint8_t  tma;
+    uint8_t  tac;
+} GB_TimerState;
+
+// Last flag producing ALU operation (GB_ALU.h), F only holds its flags after GB_FlagsSync
+typedef struct
+{
+    uint8_t op;     // GB_FlagsOp (GB_FLAGS_SYNCED when F is up to date)
+    uint8_t a;      // operands
+    uint8_t b;
+    uint8_t carry;  // carry input (ADD/SUB) or the untouched C (INC/DEC)
+    uint8_t result;
+} GB_LazyFlags;
+
+typedef struct
+{
+    // Peripheral events (PPU, timer, DMA, serial) keyed by cpuCycles
+    GB_Scheduler scheduler;
+
     //PPU
-    uint16_t ppuCycles;
     uint8_t  ppuMode;
+    uint8_t  windowLine; // window row drawn next (only counts the lines where the window was visible)
+    GB_PalleteTable palletes[GB_PALLETE_COUNT]; // BGP, OBP0, OBP1 decoded (PPU/GB_Pallete.h)
+    uint16_t renderInterval; // rasterize every Nth frame (1 every frame, 0 none), timing and interrupts never change
+    uint8_t  renderFrame;    // the current frame is rasterized (decided when LY wraps to 0)
+    uint64_t ppuFrames;      // frames started (LY wraps)
+    uint64_t renderedFrames; // frames started with rasterization on
+
+    // TIMER + SERIAL + OAM DMA
+    GB_TimerState timer;
+    uint8_t  serialData;
+    uint8_t  serialControl;
+    uint8_t  dmaSource;
+    uint8_t  dmaActive;
 
     // CPU
-    uint16_t cpuCycles; 
+    uint64_t cpuCycles;    // master clock (clock cycles since power on)
+    uint64_t instructions; // executed instructions (both cores)
     uint8_t  ime;
+    uint8_t  interruptPending; // (IE & IF & 0x1F) != 0, kept by every IE/IF writer (GB_Interrupt.h)
+    GB_LazyFlags flags;    // pending Z/N/H/C of the last ALU operation
+    uint8_t  halted;       // HALT/STOP, sleeps until an enabled interrupt is requested (IE & IF)
+    uint64_t haltedCycles; // master clock cycles skipped while halted
     uint8_t  bios_enabled;
  
     // TODO: MOVE THIS, MEMORY SHOULD BE ACCESED BY BUS READ AND BUS WRITE IF U WANT TO KNOW A SPECIFIC MEMORY REGION...
     uint8_t         *bios;
     uint8_t         *bank_00;
+    uint8_t         *bank_nn; // Switchable rom bank (NULL until a mapper sets it with GB_BusMapRomBank)
+    uint8_t         *bank_01; // Second bank of a 32 KB rom without mapper (mapped as bank_nn)
     uint8_t         *vram;
+    uint8_t         *wram;    // C000 - DFFF (both banks, echo ram points here too)
+    uint8_t         *oam;
+    uint8_t         *framebuffer; // 160x144 shades (0-3, after BGP/OBP) written by GB_RenderScanLine
     uint8_t         *hram;
+
+    // Host pointer of every 256 byte page (NULL pages go through the bus handlers), built by GB_BusRemap
+    uint8_t         *readPages[GB_PAGE_COUNT];
+    uint8_t         *writePages[GB_PAGE_COUNT];
     
     GB_Registers    registers;
 
+    // Decoded rom blocks (GB_BlockCache.h), only allocated by the cached and JIT cores
+    struct GB_BlockCache *blockCache;
+
+    // Polling loops skipped to the next change of the register they read (GB_IdleLoop.h)
+    struct GB_IdleLoopCache *idleLoops;
+
+    // Tiles decoded to color indices (PPU/GB_TileCache.h), dirtied by the vram writes
+    struct GB_TileCache *tileCache;
+
+    // x86-64 translation of the hot blocks (GB_Jit.h), only allocated by the JIT core
+    struct GB_Jit *jit;
+
+    // GB_TickCpu decodes with the mask scan (GB_FetchInstruction), reference of the dispatch table benchmark
+    uint8_t linearDecode;
+
+    // Executed opcode pairs (GB_Fusion.h), NULL unless a profile is attached
+    struct GB_PairProfile *pairProfile;
+
+    // Per opcode executions, cycles and host time (GB_Profiler.h), kept while profiling is paused
+    struct GB_Profiler *profiler;
+    uint8_t             profiling;
+
     // Cartige
     GB_Header       *header;
 } EmulationState;
@@ -9,13 +9,17 @@
 Emulation GameBoyEmulator =
 {
     .GetInfo = GB_GetInfo,
+    .CreateInstance = GB_CreateInstance,
+    .DestroyInstance = GB_DestroyInstance,
     .Initialize = GB_Initialize,
     .LoadProgram = GB_LoadProgram,
     .QuitProgram = GB_QuitProgram,
     .TickEmulation = GB_TickEmulation,
+    .RunCycles = GB_RunCycles,
+    .RunFrame = GB_RunFrame,
     .TickTimers = GB_TickTimers,
-    .SetEmulationContext = GB_SetEmulationContext,
-    .OnRender = GB_OnRender 
+    .OnRender = GB_OnRender,
+    .DumpRegisters = GB_DumpRegisters
 };
 
 #endif 
\ No newline at end of file
@@ -1,7 +1,40 @@
 #ifndef GB_PALLETE_H
 #define GB_PALLETE_H
 
+#include <stdint.h>
+
 // FOR THE MOMENT TESTING PALLETE
 // const uint32_t pallete[] = {0x9BBC0FFF , 0x8BAC0FFF, 0x306230FF, 0x0F380FFF}; // green shades
 
-#endif
\ No newline at end of file
+/*
+    PALETTE REGISTER TABLES (BGP, OBP0, OBP1):
+    - Rebuilt by GB_WriteIO when the register is written, the renderer only reads them (no per pixel bit decoding).
+    - shades: color index (0-3) to shade (0-3), pairs: two color indices packed in one byte to the shades of both pixels.
+    - The framebuffer keeps shades, the host colors (pallete) are applied once per presented frame by GB_OnRender.
+    - Code writing the registers directly (tests, state loading) has to call GB_LCD_SyncPalletes.
+*/
+
+#define GB_PALLETE_COLORS 4
+#define GB_PALLETE_PAIR_LENGHT 0x100
+
+// Pair index of two adjacent pixels (first is the leftmost)
+#define GB_PALLETE_PAIR(first, second) ((first) | (second) << 4)
+
+typedef enum
+{
+    GB_PALLETE_BG,
+    GB_PALLETE_OBJ0,
+    GB_PALLETE_OBJ1,
+    GB_PALLETE_COUNT
+} GB_PalleteId;
+
+typedef struct
+{
+    uint8_t shades[GB_PALLETE_COLORS];
+    uint8_t pairs[GB_PALLETE_PAIR_LENGHT][2];
+} GB_PalleteTable;
+
+// Decodes a palette register value (bits 1-0 color 0 ... bits 7-6 color 3)
+void GB_PalleteBuild(GB_PalleteTable *table, const uint8_t value);
+
+#endif
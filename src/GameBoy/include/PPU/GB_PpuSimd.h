@@ -0,0 +1,40 @@
+#ifndef GB_PPU_SIMD_H
+#define GB_PPU_SIMD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+    PPU PIXEL KERNELS (planar to chunky and palette expansion):
+    - decodeRows: 2bpp tile rows (low, high bitplane bytes as stored in vram) to 8 color indices per row.
+    - expand: color indices (0-3) to 32 bit pixels through a 4 entry palette.
+    - SCALAR is the reference (GB_DecodeTileRow table, one palette load per pixel).
+    - SSE2 decodes 8 rows per step (plane deinterleave, byte broadcasts + bit masks) and selects the palette entry with compare/and/or.
+    - AVX2 decodes 4 rows per step (vpshufb broadcasts) and expands 8 pixels per vpermd (the palette is the table).
+    - The best level supported by the host cpu is picked once at runtime (GB_PpuSelectKernels), GB_PpuKernelsGet returns a
+      given level (NULL when the cpu or the compiler can't run it) for tests and benchmarks.
+    - x86 SIMD levels need gcc/clang (target attributes and __builtin_cpu_supports), anything else only has SCALAR.
+*/
+
+typedef enum
+{
+    GB_PPU_SIMD_SCALAR,
+    GB_PPU_SIMD_SSE2,
+    GB_PPU_SIMD_AVX2,
+    GB_PPU_SIMD_COUNT
+} GB_PpuSimdLevel;
+
+typedef struct
+{
+    const char *name;
+    // rows * 2 bytes of tile data to rows * 8 color indices
+    void (*decodeRows)(uint8_t *indices, const uint8_t *data, const size_t rows);
+    // count color indices to count pixels (palette has 4 entries)
+    void (*expand)(uint32_t *pixels, const uint8_t *indices, const uint32_t *palette, const size_t count);
+} GB_PpuKernels;
+
+// Best kernels of this host (selected on the first call, thread safe)
+const GB_PpuKernels *GB_PpuSelectKernels();
+const GB_PpuKernels *GB_PpuKernelsGet(const GB_PpuSimdLevel level);
+
+#endif
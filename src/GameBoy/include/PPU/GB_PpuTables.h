@@ -0,0 +1,33 @@
+#ifndef GB_PPU_TABLES_H
+#define GB_PPU_TABLES_H
+
+#include <stdint.h>
+#include <string.h>
+
+/*
+    PPU lookup tables generated at build time (cmake/GB_GeneratePpuTables.cmake)
+
+    - tile_row_decode: one bitplane byte spread to eight pixels (one byte per pixel holding its bit, leftmost pixel first)
+      A tile row is decoded with two lookups: low plane | high plane << 1, both as a single 64 bit word, the shift never
+      carries between pixels (every byte is 0 or 1) so the result doesn't depend on the host byte order.
+*/
+
+#define GB_TILE_ROW_DECODE_LENGHT 0x100
+#define GB_TILE_ROW_PIXELS 8
+
+extern const uint8_t gb_tile_row_decode[GB_TILE_ROW_DECODE_LENGHT][GB_TILE_ROW_PIXELS];
+
+// Eight 2 bit color indices of a tile row (low and high bitplane bytes)
+static inline void GB_DecodeTileRow(uint8_t *pixels, const uint8_t low, const uint8_t high)
+{
+    uint64_t lowPlane;
+    uint64_t highPlane;
+
+    memcpy(&lowPlane, gb_tile_row_decode[low], sizeof(uint64_t));
+    memcpy(&highPlane, gb_tile_row_decode[high], sizeof(uint64_t));
+
+    lowPlane |= highPlane << 1;
+    memcpy(pixels, &lowPlane, sizeof(uint64_t));
+}
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef GB_TILE_CACHE_H
+#define GB_TILE_CACHE_H
+
+#include <Emulation/GB_SystemContext.h>
+#include <PPU/GB_PpuTables.h>
+#include <PPU/GB_PpuSimd.h>
+
+/*
+    DECODED TILE CACHE (PPU):
+    - The 384 tiles of 0x8000 - 0x97FF are kept decoded as 8x8 color index bytes, scanlines copy their rows from here.
+    - The tile data pages don't have a host write pointer (GB_BusRemap), GB_BusWriteHandler marks the written tile dirty.
+    - Dirty tiles are decoded again (whole tile, host SIMD kernel) the next time a scanline asks for one of their rows.
+    - Code writing ctx->vram directly (tests, state loading) has to call GB_TileCacheInvalidate.
+*/
+
+#define GB_TILE_COUNT 384
+#define GB_TILE_DATA_START 0x8000
+#define GB_TILE_DATA_END 0x97FF
+
+typedef struct
+{
+    uint64_t hits;          // rows served without decoding
+    uint64_t decodes;       // tiles decoded (first use or dirty)
+    uint64_t invalidations; // vram writes that dirtied a clean tile
+} GB_TileCacheStats;
+
+typedef struct GB_TileCache
+{
+    uint8_t              pixels[GB_TILE_COUNT][GB_TILE_ROW_PIXELS][GB_TILE_ROW_PIXELS];
+    uint8_t              dirty[GB_TILE_COUNT];
+    GB_TileCacheStats    stats;
+    const GB_PpuKernels *kernels; // planar to chunky decoder (GB_PpuSelectKernels)
+} GB_TileCache;
+
+GB_TileCache *GB_TileCacheCreate();
+void          GB_TileCacheDestroy(GB_TileCache *cache);
+// Every tile dirty (vram written without the bus)
+void          GB_TileCacheInvalidate(GB_TileCache *cache);
+void          GB_TileCacheDecode(GB_TileCache *cache, const uint8_t *vram, const uint16_t tile);
+void          GB_TileCachePrintStats(const GB_TileCache *cache);
+
+// Tile data write (address in 0x8000 - 0x97FF)
+static inline void GB_TileCacheWrite(GB_TileCache *cache, const uint16_t address)
+{
+    uint8_t *dirty = &cache->dirty[(address - GB_TILE_DATA_START) >> 4];
+
+    cache->stats.invalidations += !*dirty;
+    *dirty = 1;
+}
+
+// Eight color indices of a tile row (tile 0-383: 0x8000 + tile * 16)
+static inline const uint8_t *GB_TileCacheRow(GB_TileCache *cache, const uint8_t *vram, const uint16_t tile, const uint8_t row)
+{
+    if (cache->dirty[tile])
+    {
+        GB_TileCacheDecode(cache, vram, tile);
+    }
+    else
+    {
+        cache->stats.hits++;
+    }
+
+    return cache->pixels[tile][row];
+}
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef GB_ALU_H
+#define GB_ALU_H
+
+#include <Emulation/GB_SystemContext.h>
+#include <SOC/GB_AluTables.h>
+
+/*
+    8 BIT ALU PRIMITIVES:
+    - Shared by the function pointer core (GB_CPU.c) and the threaded core (GB_CPU_Threaded.c) so both cores produce the same results.
+    - Every primitive returns the 8 bit result, flags follow the instruction comments (see GB_CPU.c) but are evaluated lazily.
+    - carry is the carry/borrow input (0 for ADD/SUB/CP, flags.C for ADC/SBC).
+
+    LAZY FLAGS:
+    - The primitives only record the operation and its operands (EmulationState.flags), F is left untouched.
+    - Conditions and carry inputs evaluate the single flag they need (GB_FlagZero/GB_FlagCarry) without touching F.
+    - GB_FlagsSync writes the recorded flags into F, it has to run before anything else reads or writes F:
+      partial flag writers (rotates, BIT, CCF, SCF, CPL, ADD HL,rr), DAA, PUSH/POP AF, interrupts and the end of every run.
+    - N/H (and Z for INC/DEC) come from the generated tables (GB_AluTables.h), no branches per flag.
+*/
+
+typedef enum
+{
+    GB_FLAGS_SYNCED, // F is up to date
+    GB_FLAGS_ADD,    // ADD/ADC: a + b + carry
+    GB_FLAGS_SUB,    // SUB/SBC/CP: a - b - carry
+    GB_FLAGS_AND,
+    GB_FLAGS_LOGIC,  // XOR/OR
+    GB_FLAGS_INC,    // a + 1 (carry holds the untouched C)
+    GB_FLAGS_DEC     // a - 1 (carry holds the untouched C)
+} GB_FlagsOp;
+
+static inline void GB_FlagsRecord(EmulationState *ctx, const GB_FlagsOp op, const uint8_t a, const uint8_t b, const uint8_t carry, const uint8_t result)
+{
+    ctx->flags.op = op;
+    ctx->flags.a = a;
+    ctx->flags.b = b;
+    ctx->flags.carry = carry;
+    ctx->flags.result = result;
+}
+
+static inline uint8_t GB_FlagZero(const EmulationState *ctx)
+{
+    return ctx->flags.op == GB_FLAGS_SYNCED ? ctx->registers.ZERO_FLAG : ctx->flags.result == 0;
+}
+
+static inline uint8_t GB_FlagCarry(const EmulationState *ctx)
+{
+    const GB_LazyFlags *flags = &ctx->flags;
+
+    switch (flags->op)
+    {
+    case GB_FLAGS_SYNCED:
+        return ctx->registers.CARRY_FLAG;
+    case GB_FLAGS_ADD:
+        return flags->a + flags->b + flags->carry > 0xFF;
+    case GB_FLAGS_SUB:
+        return flags->a - flags->b - flags->carry < 0;
+    case GB_FLAGS_INC:
+    case GB_FLAGS_DEC:
+        return flags->carry;
+    }
+
+    return 0;
+}
+
+// Writes a F layout byte (Z:0x80 N:0x40 H:0x20 C:0x10) into the flag bits
+static inline void GB_FlagsWrite(EmulationState *ctx, const uint8_t flags)
+{
+    ctx->registers.ZERO_FLAG = (flags >> 7) & 1;
+    ctx->registers.N_FLAG = (flags >> 6) & 1;
+    ctx->registers.H_CARRY_FLAG = (flags >> 5) & 1;
+    ctx->registers.CARRY_FLAG = (flags >> 4) & 1;
+}
+
+static inline void GB_FlagsSync(EmulationState *ctx)
+{
+    const GB_LazyFlags *flags = &ctx->flags;
+    uint8_t f = 0;
+
+    switch (flags->op)
+    {
+    case GB_FLAGS_SYNCED:
+        return;
+
+    case GB_FLAGS_ADD:
+        f = gb_add_flags[GB_ADD_SUB_INDEX(flags->a, flags->b, flags->carry)] | (flags->result == 0) << 7;
+        break;
+
+    case GB_FLAGS_SUB:
+        f = gb_sub_flags[GB_ADD_SUB_INDEX(flags->a, flags->b, flags->carry)] | (flags->result == 0) << 7;
+        break;
+
+    case GB_FLAGS_AND:
+        f = 0x20 | (flags->result == 0) << 7;
+        break;
+
+    case GB_FLAGS_LOGIC:
+        f = (flags->result == 0) << 7;
+        break;
+
+    case GB_FLAGS_INC:
+        f = gb_inc_flags[flags->a];
+        break;
+
+    case GB_FLAGS_DEC:
+        f = gb_dec_flags[flags->a];
+        break;
+    }
+
+    GB_FlagsWrite(ctx, f | GB_FlagCarry(ctx) << 4);
+    ctx->flags.op = GB_FLAGS_SYNCED;
+}
+
+static inline uint8_t GB_ALU_Add8(EmulationState *ctx, const uint8_t a, const uint8_t b, const uint8_t carry)
+{
+    const uint8_t result = a + b + carry;
+
+    GB_FlagsRecord(ctx, GB_FLAGS_ADD, a, b, carry, result);
+    return result;
+}
+
+static inline uint8_t GB_ALU_Sub8(EmulationState *ctx, const uint8_t a, const uint8_t b, const uint8_t carry)
+{
+    const uint8_t result = a - b - carry;
+
+    GB_FlagsRecord(ctx, GB_FLAGS_SUB, a, b, carry, result);
+    return result;
+}
+
+static inline uint8_t GB_ALU_And8(EmulationState *ctx, const uint8_t a, const uint8_t b)
+{
+    const uint8_t result = a & b;
+
+    GB_FlagsRecord(ctx, GB_FLAGS_AND, a, b, 0, result);
+    return result;
+}
+
+static inline uint8_t GB_ALU_Xor8(EmulationState *ctx, const uint8_t a, const uint8_t b)
+{
+    const uint8_t result = a ^ b;
+
+    GB_FlagsRecord(ctx, GB_FLAGS_LOGIC, a, b, 0, result);
+    return result;
+}
+
+static inline uint8_t GB_ALU_Or8(EmulationState *ctx, const uint8_t a, const uint8_t b)
+{
+    const uint8_t result = a | b;
+
+    GB_FlagsRecord(ctx, GB_FLAGS_LOGIC, a, b, 0, result);
+    return result;
+}
+
+// INC/DEC don't touch the carry flag
+static inline uint8_t GB_ALU_Inc8(EmulationState *ctx, const uint8_t value)
+{
+    const uint8_t result = value + 1;
+
+    GB_FlagsRecord(ctx, GB_FLAGS_INC, value, 0, GB_FlagCarry(ctx), result);
+    return result;
+}
+
+static inline uint8_t GB_ALU_Dec8(EmulationState *ctx, const uint8_t value)
+{
+    const uint8_t result = value - 1;
+
+    GB_FlagsRecord(ctx, GB_FLAGS_DEC, value, 0, GB_FlagCarry(ctx), result);
+    return result;
+}
+
+#endif
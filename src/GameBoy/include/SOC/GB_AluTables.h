@@ -0,0 +1,30 @@
+#ifndef GB_ALU_TABLES_H
+#define GB_ALU_TABLES_H
+
+#include <stdint.h>
+
+/*
+    8 bit ALU lookup tables generated at build time (cmake/GB_GenerateAluTables.cmake)
+    Flags use the F register layout (Z:0x80 N:0x40 H:0x20 C:0x10).
+
+    - daa_table: A after the decimal correction on the low byte, flags on the high byte (indexed by A and N/H/C)
+    - inc_flags: Z/N/H after INC r (indexed by the operand, C is not affected)
+    - dec_flags: Z/N/H after DEC r (indexed by the operand, C is not affected)
+    - add_flags: N/H after ADD/ADC (indexed by the low nibbles and the carry input, Z and C need the whole operands)
+    - sub_flags: N/H after SUB/SBC/CP (same index as add_flags)
+*/
+
+#define GB_DAA_TABLE_LENGHT 0x800
+#define GB_INC_DEC_TABLE_LENGHT 0x100
+#define GB_ADD_SUB_TABLE_LENGHT 0x200
+
+#define GB_DAA_INDEX(a, n, h, c) ((a) | ((n) & 1) << 8 | ((h) & 1) << 9 | ((c) & 1) << 10)
+#define GB_ADD_SUB_INDEX(a, b, carry) (((a) & 0x0F) << 5 | ((b) & 0x0F) << 1 | ((carry) & 1))
+
+extern const uint16_t gb_daa_table[GB_DAA_TABLE_LENGHT];
+extern const uint8_t gb_inc_flags[GB_INC_DEC_TABLE_LENGHT];
+extern const uint8_t gb_dec_flags[GB_INC_DEC_TABLE_LENGHT];
+extern const uint8_t gb_add_flags[GB_ADD_SUB_TABLE_LENGHT];
+extern const uint8_t gb_sub_flags[GB_ADD_SUB_TABLE_LENGHT];
+
+#endif
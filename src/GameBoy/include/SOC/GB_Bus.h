@@ -1,5 +1,6 @@
 #ifndef GB_BUS_H
 #define GB_BUS_H
+#include <stddef.h>
 #include <Emulation/GB_SystemContext.h>
 
 // 16 BIT ADDRESSING MODES (enumerated)
@@ -7,10 +8,45 @@
 #define REG16_MODE_SP 1
 #define REG16_MODE_HL_PLUS_HL_MINUS 2
 
+/*
+    PAGE TABLES:
+    - readPages/writePages (EmulationState) hold a host pointer per 256 byte page, rom, vram, wram and echo ram are a single pointer add.
+    - NULL pages (rom writes, vram tile data writes, external ram, oam, io, hram, unmapped rom banks) go through GB_BusReadHandler/GB_BusWriteHandler.
+    - Rebuild the tables with GB_BusRemap when the mapped memory changes (bios overlay, allocations), bank switches only swap pages.
+*/
+
 //TODO: IMPROVE THIS METHOD....
 uint8_t GB_InAddressRange(const uint16_t a, const uint16_t b, const uint16_t addrr);
-uint8_t GB_BusRead(const EmulationState *ctx, uint16_t address);
-void GB_BusWrite(EmulationState *ctx, uint16_t address, uint8_t value);
+uint8_t GB_BusReadHandler(const EmulationState *ctx, uint16_t address);
+void    GB_BusWriteHandler(EmulationState *ctx, uint16_t address, uint8_t value);
+void    GB_BusRemap(EmulationState *ctx);
+void    GB_BusMapRomBank(EmulationState *ctx, uint8_t *bank);
+
+// OAM DMA (0xFF46), 160 M-cycles
+#define GB_DMA_CYCLES 640
+
+void    GB_DMA_Start(EmulationState *ctx, const uint8_t source);
+void    GB_DMA_OnComplete(EmulationState *ctx, const uint64_t deadline);
+
+static inline uint8_t GB_BusRead(const EmulationState *ctx, uint16_t address)
+{
+    const uint8_t *page = ctx->readPages[address >> 8];
+
+    return page != NULL ? page[address & 0xFF] : GB_BusReadHandler(ctx, address);
+}
+
+static inline void GB_BusWrite(EmulationState *ctx, uint16_t address, uint8_t value)
+{
+    uint8_t *page = ctx->writePages[address >> 8];
+
+    if (page != NULL)
+    {
+        page[address & 0xFF] = value;
+        return;
+    }
+
+    GB_BusWriteHandler(ctx, address, value);
+}
 
 // TODO: MOVE REGISTER OPERATIONS TO ANOTHER FILE...
 void     GB_SetReg8(EmulationState *ctx, uint8_t r, uint8_t value);
@@ -1,8 +1,10 @@
 #ifndef GB_INSTRUCTIONS_H
 #define GB_INSTRUCTIONS_H
 #include <Emulation/GB_SystemContext.h>
+#include <Emulation/GB_Instruction.h>
 
 #define GB_INSTRUCTION_SET_LENGHT 0xFF
+#define GB_CB_INSTRUCTION_SET_LENGHT 0x100
 
 // Condition types (enumarated)
 #define COND_NZ 0
@@ -10,11 +12,41 @@
 #define COND_NC 2
 #define COND_C  3
 
+// LD r,r' (0x40-0x7F except HALT): X(opcode, destination, source), one handler per opcode (GB_LD_B_C, GB_LD_HL_A...)
+// so the operands are resolved at compile time (HL is the (HL) operand)
+#define GB_LD_R_R_LIST(X) \
+    X(40, B, B) X(41, B, C) X(42, B, D) X(43, B, E) X(44, B, H) X(45, B, L) X(46, B, HL) X(47, B, A) \
+    X(48, C, B) X(49, C, C) X(4A, C, D) X(4B, C, E) X(4C, C, H) X(4D, C, L) X(4E, C, HL) X(4F, C, A) \
+    X(50, D, B) X(51, D, C) X(52, D, D) X(53, D, E) X(54, D, H) X(55, D, L) X(56, D, HL) X(57, D, A) \
+    X(58, E, B) X(59, E, C) X(5A, E, D) X(5B, E, E) X(5C, E, H) X(5D, E, L) X(5E, E, HL) X(5F, E, A) \
+    X(60, H, B) X(61, H, C) X(62, H, D) X(63, H, E) X(64, H, H) X(65, H, L) X(66, H, HL) X(67, H, A) \
+    X(68, L, B) X(69, L, C) X(6A, L, D) X(6B, L, E) X(6C, L, H) X(6D, L, L) X(6E, L, HL) X(6F, L, A) \
+    X(70, HL, B) X(71, HL, C) X(72, HL, D) X(73, HL, E) X(74, HL, H) X(75, HL, L) X(77, HL, A) \
+    X(78, A, B) X(79, A, C) X(7A, A, D) X(7B, A, E) X(7C, A, H) X(7D, A, L) X(7E, A, HL) X(7F, A, A)
+
+#define GB_LD_R_R_DECLARE(op, dst, src) uint8_t GB_LD_##dst##_##src(EmulationState *ctx);
+
+// Register operands of ALU A,r (0x80-0xBF), INC r, DEC r and LD r,n: X(r8 encoding, register), one handler per opcode
+// (GB_ADD_A_B, GB_INC_C, GB_LD_D_N...), the (HL) encoding (6) keeps its own handlers (GB_ADD_A_HL, GB_INC_HL, GB_LD_HL_N...)
+#define GB_R8_LIST(X) X(0, B) X(1, C) X(2, D) X(3, E) X(4, H) X(5, L) X(7, A)
+
+#define GB_R8_LOAD_DECLARE(r, reg) uint8_t GB_LD_##reg##_N(EmulationState *ctx);
+
+#define GB_R8_ALU_DECLARE(r, reg)                 \
+    uint8_t GB_ADD_A_##reg(EmulationState *ctx);  \
+    uint8_t GB_ADC_A_##reg(EmulationState *ctx);  \
+    uint8_t GB_SUB_##reg(EmulationState *ctx);    \
+    uint8_t GB_SBC_A_##reg(EmulationState *ctx);  \
+    uint8_t GB_AND_##reg(EmulationState *ctx);    \
+    uint8_t GB_XOR_##reg(EmulationState *ctx);    \
+    uint8_t GB_OR_##reg(EmulationState *ctx);     \
+    uint8_t GB_CP_##reg(EmulationState *ctx);     \
+    uint8_t GB_INC_##reg(EmulationState *ctx);    \
+    uint8_t GB_DEC_##reg(EmulationState *ctx);
+
 // 8-BIT LOAD INSTRUCTIONS
-uint8_t GB_LD_R_R(EmulationState *ctx);
-uint8_t GB_LD_R_N(EmulationState *ctx);
-uint8_t GB_LD_R_HL(EmulationState *ctx);
-uint8_t GB_LD_HL_R(EmulationState *ctx);
+GB_LD_R_R_LIST(GB_LD_R_R_DECLARE)
+GB_R8_LIST(GB_R8_LOAD_DECLARE)
 uint8_t GB_LD_HL_N(EmulationState *ctx);
 uint8_t GB_LD_A_BC(EmulationState *ctx);
 uint8_t GB_LD_A_DE(EmulationState *ctx);
@@ -39,33 +71,24 @@ uint8_t GB_PUSH_RR(EmulationState *ctx);
 uint8_t GB_POP_RR(EmulationState *ctx);
 
 // 8 BIT ALU INSTRUCTIONS
-uint8_t GB_ADD_A_R(EmulationState *ctx);
+GB_R8_LIST(GB_R8_ALU_DECLARE)
 uint8_t GB_ADD_A_N(EmulationState *ctx);
 uint8_t GB_ADD_A_HL(EmulationState *ctx);
-uint8_t GB_ADC_A_R(EmulationState *ctx);
 uint8_t GB_ADC_A_N(EmulationState *ctx);
 uint8_t GB_ADC_A_HL(EmulationState *ctx);
-uint8_t GB_SUB_R(EmulationState *ctx);
 uint8_t GB_SUB_N(EmulationState *ctx);
 uint8_t GB_SUB_HL(EmulationState *ctx);
-uint8_t GB_SBC_A_R(EmulationState *ctx);
 uint8_t GB_SBC_A_N(EmulationState *ctx);
 uint8_t GB_SBC_A_HL(EmulationState *ctx);
-uint8_t GB_AND_R(EmulationState *ctx);
 uint8_t GB_AND_N(EmulationState *ctx);
 uint8_t GB_AND_HL(EmulationState *ctx);
-uint8_t GB_XOR_R(EmulationState *ctx);
 uint8_t GB_XOR_N(EmulationState *ctx);
 uint8_t GB_XOR_HL(EmulationState *ctx);
-uint8_t GB_OR_R(EmulationState *ctx);
 uint8_t GB_OR_N(EmulationState *ctx);
 uint8_t GB_OR_HL(EmulationState *ctx);
-uint8_t GB_CP_R(EmulationState *ctx);
 uint8_t GB_CP_N(EmulationState *ctx);
 uint8_t GB_CP_HL(EmulationState *ctx);
-uint8_t GB_INC_R(EmulationState *ctx);
 uint8_t GB_INC_HL(EmulationState *ctx);
-uint8_t GB_DEC_R(EmulationState *ctx);
 uint8_t GB_DEC_HL(EmulationState *ctx);
 uint8_t GB_DAA(EmulationState *ctx);
 uint8_t GB_CPL(EmulationState *ctx);
@@ -107,19 +130,20 @@ uint8_t GB_RST_N(EmulationState *ctx);
 
 // CB PREFIX HELL
 uint8_t GB_CB_PREFIX(EmulationState *ctx);
+const GameBoyCBInstruction* GB_DecodeCBInstruction(const uint8_t cbOpcode);
+
+void GB_RLC_R(EmulationState *ctx, uint8_t *operand, const uint8_t b);
+void GB_RL_R(EmulationState *ctx, uint8_t *operand, const uint8_t b);
+void GB_RRC_R(EmulationState *ctx, uint8_t *operand, const uint8_t b);
+void GB_RR_R(EmulationState *ctx, uint8_t *operand, const uint8_t b);
+void GB_SLA_R(EmulationState *ctx, uint8_t *operand, const uint8_t b);
+void GB_SWAP_R(EmulationState *ctx, uint8_t *operand, const uint8_t b);
+void GB_SRA_R(EmulationState *ctx, uint8_t *operand, const uint8_t b);
+void GB_SRL_R(EmulationState *ctx, uint8_t *operand, const uint8_t b);
 
-uint8_t GB_RLC_R(EmulationState *ctx);
-uint8_t GB_RL_R(EmulationState *ctx);
-uint8_t GB_RRC_R(EmulationState *ctx);
-uint8_t GB_RR_R(EmulationState *ctx);
-uint8_t GB_SLA_R(EmulationState *ctx);
-uint8_t GB_SWAP_R(EmulationState *ctx);
-uint8_t GB_SRA_R(EmulationState *ctx);
-uint8_t GB_SRL_R(EmulationState *ctx);
-
-uint8_t GB_CB_BIT_N_R(EmulationState *ctx);   
-uint8_t GB_CB_SET_N_R(EmulationState *ctx);   
-uint8_t GB_CB_RES_N_R(EmulationState *ctx);   
+void GB_CB_BIT_N_R(EmulationState *ctx, uint8_t *operand, const uint8_t b);
+void GB_CB_SET_N_R(EmulationState *ctx, uint8_t *operand, const uint8_t b);
+void GB_CB_RES_N_R(EmulationState *ctx, uint8_t *operand, const uint8_t b);
 
 // AXULIAR DECODING FUNCTIONS
 uint8_t GB_ResolveCondition(const EmulationState *ctx, uint8_t cc);
@@ -0,0 +1,16 @@
+#ifndef GB_CPU_THREADED_H
+#define GB_CPU_THREADED_H
+
+#include <Emulation/GB_SystemContext.h>
+
+/*
+    THREADED CORE (computed goto, gcc/clang only):
+    - Runs instructions until budget clock cycles are consumed (always executes at least one instruction).
+    - Same EmulationState and same semantics as the function pointer core (GB_TickCpu), hot opcodes are inlined
+      and the rest are dispatched to the GB_CPU.c handlers.
+    - Returns early after EI/RETI, HALT/STOP or an invalid instruction so the caller can service interrupts/halt.
+    - Returns the consumed clock cycles (can overshoot budget by one instruction).
+*/
+uint32_t GB_RunThreaded(EmulationState *ctx, const uint32_t budget);
+
+#endif
@@ -1,7 +1,39 @@
-#ifdef  GB_INTTERUPT_H
-#define GB_INTTERUPT_H
+#ifndef GB_INTERRUPT_H
+#define GB_INTERRUPT_H
 
-// Insert here interrupt controller logic...
+#include <Emulation/GB_SystemContext.h>
 
+/*
+    INTERRUPT CONTROLLER:
+    - IE/IF bit n is source n, the lowest bit wins (VBLANK, LCD STAT, TIMER, SERIAL, JOYPAD), vector = 0x40 + 8 * n.
+    - interruptPending caches (IE & IF & 0x1F) != 0, every IE/IF writer keeps it updated (GB_InterruptRequest, bus writes
+      and GB_HandleInterrupts) so the cpu loop only tests one byte between instructions.
+    - Peripherals request interrupts with GB_InterruptRequest, never by writing IF directly.
+*/
 
-#endif
\ No newline at end of file
+#define GB_INTERRUPT_VBLANK 0x01
+#define GB_INTERRUPT_LCD    0x02
+#define GB_INTERRUPT_TIMER  0x04
+#define GB_INTERRUPT_SERIAL 0x08
+#define GB_INTERRUPT_JOYPAD 0x10
+#define GB_INTERRUPT_MASK   0x1F
+
+// Handler address of the source (IE/IF bit index)
+#define GB_INTERRUPT_VECTOR(source) (0x40 + ((source) << 3))
+
+// T-cycles of a dispatch: 2 wait M-cycles, 2 M-cycles pushing PC and 1 M-cycle jumping to the vector
+#define GB_INTERRUPT_DISPATCH_CYCLES 20
+
+static inline void GB_InterruptUpdatePending(EmulationState *ctx)
+{
+    ctx->interruptPending = (ctx->registers.IE.value & ctx->registers.IF.value & GB_INTERRUPT_MASK) != 0;
+}
+
+// interrupt: GB_INTERRUPT_* bit
+static inline void GB_InterruptRequest(EmulationState *ctx, const uint8_t interrupt)
+{
+    ctx->registers.IF.value |= interrupt;
+    GB_InterruptUpdatePending(ctx);
+}
+
+#endif
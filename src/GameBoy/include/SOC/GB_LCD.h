@@ -50,13 +50,47 @@
 
 */
 
-void GB_LCD_Init();
-void GB_LCD_Tick(EmulationState* state, uint8_t cycles);
+// Mode changes are GB_EVENT_PPU_MODE scheduler events (HBLANK 204, VBLANK 456 per line, OAM SEARCH 80, DRAWING 172 cycles)
+void GB_LCD_Init(EmulationState* state);
+void GB_LCD_OnModeEvent(EmulationState* state, const uint64_t deadline);
+
+#define GB_TILE_MAP_0 0x9800
+#define GB_TILE_MAP_1 0x9C00
+#define GB_TILE_MAP_WIDTH 32
+#define GB_TILE_BYTES 16
+#define GB_OBJ_COUNT 40
+#define GB_OBJ_PER_LINE 10
+
+// LCDC bits (GB_LCDC_Register)
+#define GB_LCDC_BG_WINDOW_ENABLE 0x01
+#define GB_LCDC_OBJ_ENABLE 0x02
+#define GB_LCDC_OBJ_SIZE 0x04
+#define GB_LCDC_BG_TILE_MAP 0x08
+#define GB_LCDC_TILE_DATA 0x10
+#define GB_LCDC_WINDOW_ENABLE 0x20
+#define GB_LCDC_WINDOW_TILE_MAP 0x40
+#define GB_LCDC_LCD_ENABLE 0x80
+
+// OAM attribute bits
+#define GB_OBJ_PALETTE 0x10
+#define GB_OBJ_X_FLIP 0x20
+#define GB_OBJ_Y_FLIP 0x40
+#define GB_OBJ_BG_PRIORITY 0x80
 
+/*
+    Scanline renderer (end of mode 3, one LY line into state->framebuffer):
+    - Background and window write their color indices (0-3) to colors, objects need them for the BG priority bit.
+    - Tile rows come from the decoded tile cache (PPU/GB_TileCache.h), decoded 8 pixels at a time (GB_DecodeTileRow).
+    - Objects: first 10 of OAM on the line, the smaller X (then OAM index) wins, color 0 is transparent.
+    - Shades come from the palette tables (state->palletes), two background pixels per lookup.
+*/
 void GB_RenderScanLine(EmulationState* state);
-void GB_DrawBackground();
-void GB_DrawWindow();
-void GB_DrawObjects();
+void GB_DrawBackground(EmulationState* state, uint8_t *colors);
+void GB_DrawWindow(EmulationState* state, uint8_t *colors);
+void GB_DrawObjects(EmulationState* state, uint8_t *line, const uint8_t *colors);
+
+// Palette tables rebuilt from BGP/OBP0/OBP1 (after writing the registers without GB_WriteIO)
+void GB_LCD_SyncPalletes(EmulationState* state);
 
 
 #endif
\ No newline at end of file
@@ -88,6 +88,16 @@
 #define GB_IE_REGISTER 0xFFFF
 #define GB_IF_REGISTER 0xFF0F
 
+// SERIAL
+#define GB_SB_REGISTER 0xFF01 // (Serial transfer data)
+#define GB_SC_REGISTER 0xFF02 // (Serial transfer control)
+
+// TIMER
+#define GB_DIV_REGISTER 0xFF04
+#define GB_TIMA_REGISTER 0xFF05
+#define GB_TMA_REGISTER 0xFF06
+#define GB_TAC_REGISTER 0xFF07
+
 // LCD
 #define GB_LCDC_REGISTER 0xFF40 // (LCD Control Register)
 #define GB_LCD_STAT_REGISTER 0xFF41 // (LCDC Status Register)
@@ -151,6 +161,10 @@
 #define GB_HRAM_START 0xFF80
 #define GB_HRAM_END 0xFFFE
 
+// Bus page tables (one host pointer per 256 byte page, see GB_Bus.h)
+#define GB_PAGE_SIZE 0x100
+#define GB_PAGE_COUNT 0x100
+
 // ADD MISSING SIZES: OAM, WRAM ECHO RAM, NOT USABLE...
 #define GB_ROM_SIZE 0x4000
 
@@ -160,6 +174,8 @@
 #define GB_WRAM_SIZE 0x2000
 #define GB_WRAM2_SIZE 0x2000
 
+#define GB_OAM_SIZE 0xA0
+
 #define GB_IO_RAM_SIZE 0x7F
 #define GB_HRAM_SIZE 0x7E
 
@@ -220,14 +236,15 @@ typedef struct
     {
         struct
         {
-            uint8_t LCD_DISPLAY_ENABLE : 1;
-            uint8_t WINDOW_TILE_MAP_SELECT : 1;
-            uint8_t WINDOW_DISPLAY_ENABLE : 1;
-            uint8_t BG_WINDOW_TILE_DATA_SELECT : 1;
-            uint8_t BG_TILE_MAP_SELECT : 1;
-            uint8_t OBJ_SIZE : 1;
-            uint8_t OBJ_DISPLAY_ENABLE : 1;
+            // LSB FIRST (BG/WINDOW ENABLE IS BIT 0, LCD ENABLE IS BIT 7)
             uint8_t BG_WINDOW_DISPLAY_PRIORITY : 1;
+            uint8_t OBJ_DISPLAY_ENABLE : 1;
+            uint8_t OBJ_SIZE : 1;
+            uint8_t BG_TILE_MAP_SELECT : 1;
+            uint8_t BG_WINDOW_TILE_DATA_SELECT : 1;
+            uint8_t WINDOW_DISPLAY_ENABLE : 1;
+            uint8_t WINDOW_TILE_MAP_SELECT : 1;
+            uint8_t LCD_DISPLAY_ENABLE : 1;
         };
         uint8_t value; // Access entire register
     };
@@ -240,13 +257,14 @@ typedef struct
     {
         struct
         {
-            uint8_t LYC_LY_COINCIDENCE_INTERRUPT : 1;
-            uint8_t MODE_2_OAM_INTERRUPT : 1;
-            uint8_t MODE_1_VBLANK_INTERRUPT : 1;
-            uint8_t MODE_0_HBLANK_INTERRUPT : 1;
-            uint8_t LYC_LY_COINCIDENCE_FLAG : 1;
+            // LSB FIRST (MODE FLAG IS BITS 0-1)
             uint8_t MODE_FLAG : 2;
-            uint8_t COINCIDENCE_FLAG : 1;
+            uint8_t LYC_LY_COINCIDENCE_FLAG : 1;
+            uint8_t MODE_0_HBLANK_INTERRUPT : 1;
+            uint8_t MODE_1_VBLANK_INTERRUPT : 1;
+            uint8_t MODE_2_OAM_INTERRUPT : 1;
+            uint8_t LYC_LY_COINCIDENCE_INTERRUPT : 1;
+            uint8_t UNUSED : 1;
         };
         uint8_t value; // Access entire register
     };
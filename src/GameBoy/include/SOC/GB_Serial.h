@@ -0,0 +1,19 @@
+#ifndef GB_SERIAL_H
+#define GB_SERIAL_H
+
+#include <Emulation/GB_SystemContext.h>
+
+/*
+    SERIAL (SB, SC):
+    - No link cable, a transfer started with the internal clock shifts in 0xFF and ends 8 bits later (GB_EVENT_SERIAL)
+      requesting the SERIAL interrupt. External clock transfers never end.
+*/
+
+// Clock cycles per transferred bit (8192 hz)
+#define GB_SERIAL_BIT_CYCLES 512
+
+uint8_t GB_Serial_Read(const EmulationState *state, const uint16_t address);
+void    GB_Serial_Write(EmulationState *state, const uint16_t address, const uint8_t value);
+void    GB_Serial_OnTransferEnd(EmulationState *state, const uint64_t deadline);
+
+#endif
@@ -1,7 +1,24 @@
-#ifdef  GB_TIMER_H
+#ifndef GB_TIMER_H
 #define GB_TIMER_H
 
-// Insert here timer controller logic...
+#include <Emulation/GB_SystemContext.h>
 
+/*
+    TIMER (DIV, TIMA, TMA, TAC):
+    - DIV and TIMA are not incremented per instruction, they are computed from the master clock when read.
+    - TIMA overflow is a scheduler event (GB_EVENT_TIMER_OVERFLOW): TIMA = TMA and the TIMER interrupt is requested.
+    - TODO: DIV WRITES / TAC CHANGES GLITCHES (TIMA IS NOT DRIVEN BY THE DIV INTERNAL COUNTER FALLING EDGE HERE)
+*/
 
-#endif
\ No newline at end of file
+// TAC bit 2 (timer enable)
+#define GB_TAC_ENABLE 0x04
+
+void    GB_Timer_Reset(EmulationState *state);
+uint8_t GB_Timer_Read(const EmulationState *state, const uint16_t address);
+void    GB_Timer_Write(EmulationState *state, const uint16_t address, const uint8_t value);
+void    GB_Timer_OnOverflow(EmulationState *state, const uint64_t deadline);
+
+// Master clock cycle where DIV/TIMA read a new value (UINT64_MAX for the rest of the registers or a stopped TIMA)
+uint64_t GB_Timer_NextChange(const EmulationState *state, const uint16_t address);
+
+#endif
@@ -0,0 +1,276 @@
+#include <Emulation/GB_BlockCache.h>
+#include <Emulation/GB_Emulation.h>
+
+#include <minemu/MNE_Memory.h>
+#include <minemu/MNE_Log.h>
+
+// Boot rom overlay (0x0000 - 0x00FF while bios_enabled) shares its PCs with bank 00, it gets its own tag
+#define GB_BLOCK_BIOS_TAG 0x10000
+#define GB_BLOCK_BIOS_END 0x00FF
+
+GB_BlockCache *GB_BlockCacheCreate()
+{
+    GB_BlockCache *cache = NULL;
+    MNE_New(cache, 1, GB_BlockCache);
+
+    // Generation 0 is never used so calloc'd blocks are stale
+    cache->generation = 1;
+    cache->fusions = GB_FUSION_DEFAULT;
+    return cache;
+}
+
+void GB_BlockCacheDestroy(GB_BlockCache *cache)
+{
+    MNE_Delete(cache);
+}
+
+void GB_BlockCacheInvalidate(GB_BlockCache *cache)
+{
+    if (cache == NULL)
+    {
+        return;
+    }
+
+    cache->generation++;
+    cache->stats.invalidations++;
+}
+
+void GB_BlockCacheSetFusions(GB_BlockCache *cache, const uint32_t fusions)
+{
+    cache->fusions = fusions;
+    GB_BlockCacheInvalidate(cache);
+}
+
+// Instructions that change PC or interrupt state close the block
+static uint8_t GB_BlockCacheEndsBlock(const uint8_t opcode)
+{
+    switch (opcode)
+    {
+    case 0x18: case 0x20: case 0x28: case 0x30: case 0x38: // JR
+    case 0xC2: case 0xC3: case 0xCA: case 0xD2: case 0xDA: case 0xE9: // JP
+    case 0xC4: case 0xCC: case 0xCD: case 0xD4: case 0xDC: // CALL
+    case 0xC0: case 0xC8: case 0xC9: case 0xD0: case 0xD8: case 0xD9: // RET, RETI
+    case 0xC7: case 0xCF: case 0xD7: case 0xDF: case 0xE7: case 0xEF: case 0xF7: case 0xFF: // RST
+    case 0x10: case 0x76: case 0xF3: case 0xFB: // STOP, HALT, DI, EI
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+// Last address of the rom region PC belongs to (blocks never cross it), 0 if PC is not cacheable
+// The switchable bank is not part of the tag, GB_BusMapRomBank and mbc register writes bump the generation instead
+static uint16_t GB_BlockCacheRegionEnd(const EmulationState *ctx, const uint16_t pc, uint32_t *tag)
+{
+    if (ctx->bios_enabled && pc <= GB_BLOCK_BIOS_END)
+    {
+        *tag = GB_BLOCK_BIOS_TAG | pc;
+        return GB_BLOCK_BIOS_END;
+    }
+
+    *tag = pc;
+
+    if (pc <= GB_BANK_00_END)
+    {
+        return GB_BANK_00_END;
+    }
+
+    if (pc <= GB_BANK_NN_END)
+    {
+        return GB_BANK_NN_END;
+    }
+
+    return 0;
+}
+
+static void GB_BlockCacheDecode(EmulationState *ctx, GB_BlockCache *cache, GB_Block *block, const uint16_t start, const uint16_t regionEnd)
+{
+    uint16_t pc = start;
+    uint16_t lastCycles = 0;
+
+    block->lenght = 0;
+    block->leadCycles = 0;
+
+    while (block->lenght < GB_BLOCK_MAX_INSTRUCTIONS)
+    {
+        const uint8_t fusion = cache->fusions ? GB_FusionMatch(ctx, pc, regionEnd, cache->fusions) : GB_FUSION_NONE;
+
+        if (fusion != GB_FUSION_NONE)
+        {
+            const GB_Fusion *sequence = GB_FusionGet(fusion);
+
+            GB_BlockInstruction *entry = &block->instructions[block->lenght++];
+            entry->handler = sequence->handler;
+            entry->opcode = sequence->opcodes[0];
+            entry->lenght = sequence->bytes;
+            entry->count = sequence->lenght;
+            entry->fusion = fusion;
+
+            // Budget check keeps the original boundaries (only the last instruction of the block can cross it)
+            for (uint8_t i = 0; i < sequence->lenght; i++)
+            {
+                block->leadCycles += lastCycles;
+                lastCycles = gb_opcodes_cycles[sequence->opcodes[i]];
+            }
+
+            cache->stats.fusions[fusion]++;
+            pc += sequence->bytes;
+
+            if (GB_BlockCacheEndsBlock(sequence->opcodes[sequence->lenght - 1]))
+            {
+                break;
+            }
+            continue;
+        }
+
+        const uint8_t opcode = GB_BusRead(ctx, pc);
+        const GameBoyInstruction *instruction = GB_DecodeInstruction(opcode);
+        const uint8_t lenght = opcode == 0xCB ? 2 : gb_opcodes_length[opcode]; // prefix + cb opcode
+
+        // NOP has the unit test PC behaviour (see GB_TickCpu) and invalid opcodes halt, both are single stepped
+        if (instruction->handler == NULL || opcode == 0x00 || (uint32_t)pc + lenght - 1 > regionEnd)
+        {
+            break;
+        }
+
+        GB_BlockInstruction *entry = &block->instructions[block->lenght++];
+        entry->handler = instruction->handler;
+        entry->opcode = opcode;
+        entry->lenght = lenght;
+        entry->count = 1;
+        entry->fusion = GB_FUSION_NONE;
+
+        block->leadCycles += lastCycles;
+        lastCycles = opcode == 0xCB ? gb_cb_opcodes_cycles[GB_BusRead(ctx, pc + 1)] : gb_opcodes_cycles[opcode];
+        pc += lenght;
+
+        if (GB_BlockCacheEndsBlock(opcode))
+        {
+            break;
+        }
+    }
+
+    block->cycles = block->leadCycles + lastCycles;
+    block->generation = cache->generation;
+
+    cache->stats.misses++;
+    cache->stats.lenghtHistogram[block->lenght]++;
+}
+
+GB_Block *GB_BlockCacheLookup(EmulationState *ctx, const uint16_t budget)
+{
+    GB_BlockCache *cache = ctx->blockCache;
+    const uint16_t pc = ctx->registers.PC;
+    uint32_t tag = 0;
+
+    cache->stats.lookups++;
+
+    // A pending interrupt is dispatched by GB_HandleInterrupts before the next instruction, single step it
+    const uint16_t regionEnd = GB_BlockCacheRegionEnd(ctx, pc, &tag);
+    if (regionEnd == 0 || (ctx->ime && ctx->interruptPending))
+    {
+        cache->stats.fallbacks++;
+        return NULL;
+    }
+
+    GB_Block *block = &cache->blocks[pc & (GB_BLOCK_CACHE_LENGHT - 1)];
+
+    if (block->tag == tag && block->generation == cache->generation)
+    {
+        cache->stats.hits++;
+    }
+    else
+    {
+        block->tag = tag;
+        GB_BlockCacheDecode(ctx, cache, block, pc, regionEnd);
+    }
+
+    // The LCD has to see the same instruction boundaries as single stepping
+    if (block->lenght == 0 || block->leadCycles >= budget)
+    {
+        cache->stats.fallbacks++;
+        return NULL;
+    }
+
+    return block;
+}
+
+uint16_t GB_BlockCacheExecute(EmulationState *ctx, const GB_Block *block)
+{
+    GB_BlockCache *cache = ctx->blockCache;
+    const uint32_t generation = cache->generation;
+    uint16_t blockCycles = 0;
+    uint8_t executed = 0;
+    uint8_t i = 0;
+
+    while (i < block->lenght)
+    {
+        const GB_BlockInstruction *instruction = &block->instructions[i++];
+
+        executed += instruction->count;
+        ctx->registers.PC++;
+        ctx->registers.INSTRUCTION = instruction->opcode;
+        blockCycles += instruction->handler(ctx);
+
+        // Rom write (bank switch) while running, the rest of the block might be stale
+        // IE/IF write with IME set, the interrupt has to be taken before the next instruction
+        if (cache->generation != generation || (ctx->ime && ctx->interruptPending))
+        {
+            cache->stats.interrupted++;
+            break;
+        }
+    }
+
+    cache->stats.executedBlocks++;
+    cache->stats.executedInstructions += executed;
+    ctx->instructions += executed;
+
+    return blockCycles;
+}
+
+uint8_t GB_BlockCacheRun(EmulationState *ctx, const uint16_t budget, uint16_t *cycles)
+{
+    const GB_Block *block = GB_BlockCacheLookup(ctx, budget);
+
+    if (block == NULL)
+    {
+        return 0;
+    }
+
+    *cycles = GB_BlockCacheExecute(ctx, block);
+    return 1;
+}
+
+void GB_BlockCachePrintStats(const GB_BlockCache *cache)
+{
+    const GB_BlockCacheStats *stats = &cache->stats;
+    uint64_t decodedInstructions = 0;
+
+    for (uint8_t lenght = 0; lenght <= GB_BLOCK_MAX_INSTRUCTIONS; lenght++)
+    {
+        decodedInstructions += stats->lenghtHistogram[lenght] * lenght;
+    }
+
+    MNE_Log("[BLOCK CACHE] LOOKUPS: %llu HITS: %llu (%.2f%%) MISSES: %llu FALLBACKS: %llu\n",
+            (unsigned long long)stats->lookups, (unsigned long long)stats->hits,
+            stats->lookups ? 100.0 * stats->hits / stats->lookups : 0.0,
+            (unsigned long long)stats->misses, (unsigned long long)stats->fallbacks);
+    MNE_Log("[BLOCK CACHE] INVALIDATIONS: %llu INTERRUPTED BLOCKS: %llu\n",
+            (unsigned long long)stats->invalidations, (unsigned long long)stats->interrupted);
+    MNE_Log("[BLOCK CACHE] EXECUTED BLOCKS: %llu AVG EXECUTED LENGHT: %.2f AVG DECODED LENGHT: %.2f\n",
+            (unsigned long long)stats->executedBlocks,
+            stats->executedBlocks ? (double)stats->executedInstructions / stats->executedBlocks : 0.0,
+            stats->misses ? (double)decodedInstructions / stats->misses : 0.0);
+
+    for (uint8_t fusion = GB_FUSION_NONE + 1; fusion < GB_FUSION_COUNT; fusion++)
+    {
+        MNE_Log("[BLOCK CACHE] FUSED %s: %llu\n", GB_FusionGet(fusion)->name, (unsigned long long)stats->fusions[fusion]);
+    }
+
+    MNE_Log("[BLOCK CACHE] DECODED LENGHT HISTOGRAM:");
+    for (uint8_t lenght = 0; lenght <= GB_BLOCK_MAX_INSTRUCTIONS; lenght++)
+    {
+        MNE_Log(" %u:%llu", lenght, (unsigned long long)stats->lenghtHistogram[lenght]);
+    }
+    MNE_Log("\n");
+}
@@ -1,19 +1,57 @@
 #include <Emulation/GB_Emulation.h>
+#include <Emulation/GB_Log.h>
 
-static EmulationState * s_systemContext;
-static uint32_t s_instructionLenght = 0;
+#include <pthread.h>
+
+// Mask table expanded into a flat opcode indexed table (see GB_BuildDispatchTable), shared by every instance and built once
+static GameBoyInstruction *s_gb_dispatch_table[GB_DISPATCH_TABLE_LENGHT];
+static pthread_once_t s_gb_dispatch_table_once = PTHREAD_ONCE_INIT;
+
+// Scheduler event handlers (GB_EventType order)
+typedef void (*GB_EventHandlerFnPtr)(EmulationState *ctx, const uint64_t deadline);
+
+static const GB_EventHandlerFnPtr s_gb_event_handlers[GB_EVENT_COUNT] =
+{
+    GB_LCD_OnModeEvent,
+    GB_Timer_OnOverflow,
+    GB_DMA_OnComplete,
+    GB_Serial_OnTransferEnd,
+};
+
+// One exact match entry per LD r,r' opcode (GB_CPU.h)
+#define GB_LD_R_R_INSTRUCTION(op, dst, src) GB_INSTRUCTION(0xFF, 0x##op, GB_LD_##dst##_##src),
+
+// One exact match entry per register operand (GB_R8_LIST), the (HL) encoding falls through to its own handler
+#define GB_R8_LOAD_INSTRUCTION(r, reg) GB_INSTRUCTION(0xFF, 0x06 | (r) << 3, GB_LD_##reg##_N),
+
+#define GB_R8_ALU_INSTRUCTIONS(r, reg)                  \
+    GB_INSTRUCTION(0xFF, 0x80 | (r), GB_ADD_A_##reg),   \
+    GB_INSTRUCTION(0xFF, 0x88 | (r), GB_ADC_A_##reg),   \
+    GB_INSTRUCTION(0xFF, 0x90 | (r), GB_SUB_##reg),     \
+    GB_INSTRUCTION(0xFF, 0x98 | (r), GB_SBC_A_##reg),   \
+    GB_INSTRUCTION(0xFF, 0xA0 | (r), GB_AND_##reg),     \
+    GB_INSTRUCTION(0xFF, 0xA8 | (r), GB_XOR_##reg),     \
+    GB_INSTRUCTION(0xFF, 0xB0 | (r), GB_OR_##reg),      \
+    GB_INSTRUCTION(0xFF, 0xB8 | (r), GB_CP_##reg),      \
+    GB_INSTRUCTION(0xFF, 0x04 | (r) << 3, GB_INC_##reg), \
+    GB_INSTRUCTION(0xFF, 0x05 | (r) << 3, GB_DEC_##reg),
+
+// Count trailing zeros of the pending IE & IF bits (index 0 is never looked up)
+static const uint8_t s_gb_interrupt_priority[GB_INTERRUPT_MASK + 1] =
+{
+    0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+};
 
 static GameBoyInstruction s_gb_instruction_set[GB_INSTRUCTION_SET_LENGHT] =
     {
         //-------------MASK----OPCODE--HANDLER
         GB_INSTRUCTION(0xFF, 0x00, GB_NOP),
+        GB_INSTRUCTION(0xFF, 0x76, GB_HALT), // LD (HL),(HL) encoding
 
         // 8-BIT LOAD INSTRUCTIONS
-        GB_INSTRUCTION(0XC0, 0x40, GB_LD_R_R),
-        GB_INSTRUCTION(0xC7, 0x06, GB_LD_R_N),
-        GB_INSTRUCTION(0xC7, 0x46, GB_LD_R_HL),
-
-        GB_INSTRUCTION(0xF8, 0x70, GB_LD_HL_R),
+        GB_LD_R_R_LIST(GB_LD_R_R_INSTRUCTION)
+        GB_R8_LIST(GB_R8_LOAD_INSTRUCTION)
         GB_INSTRUCTION(0xFF, 0x36, GB_LD_HL_N),
         GB_INSTRUCTION(0xFF, 0x0A, GB_LD_A_BC),
         GB_INSTRUCTION(0xFF, 0x1A, GB_LD_A_DE),
@@ -39,33 +77,24 @@ static GameBoyInstruction s_gb_instruction_set[GB_INSTRUCTION_SET_LENGHT] =
         GB_INSTRUCTION(0xCF, 0xC1, GB_POP_RR),
 
         // 8 BIT ALU
-        GB_INSTRUCTION(0xF8, 0x80, GB_ADD_A_R),
+        GB_R8_LIST(GB_R8_ALU_INSTRUCTIONS)
         GB_INSTRUCTION(0xFF, 0xC6, GB_ADD_A_N),
         GB_INSTRUCTION(0xFF, 0x86, GB_ADD_A_HL),
-        GB_INSTRUCTION(0xF8, 0x88, GB_ADC_A_R),
         GB_INSTRUCTION(0xFF, 0XCE, GB_ADC_A_N),
         GB_INSTRUCTION(0xFF, 0x8E, GB_ADC_A_HL),
-        GB_INSTRUCTION(0xF8, 0x90, GB_SUB_R),
-        GB_INSTRUCTION(0xFF, 0x10, GB_SUB_N),
+        GB_INSTRUCTION(0xFF, 0xD6, GB_SUB_N),
         GB_INSTRUCTION(0xFF, 0x96, GB_SUB_HL),
-        GB_INSTRUCTION(0xF8, 0x98, GB_SBC_A_R),
         GB_INSTRUCTION(0xFF, 0xDE, GB_SBC_A_N),
         GB_INSTRUCTION(0xFF, 0x9E, GB_SBC_A_HL),
-        GB_INSTRUCTION(0xF8, 0xA0, GB_AND_R),
         GB_INSTRUCTION(0xFF, 0xE6, GB_AND_N),
         GB_INSTRUCTION(0xFF, 0xA6, GB_AND_HL),
-        GB_INSTRUCTION(0xF8, 0xA8, GB_XOR_R),
-        GB_INSTRUCTION(0xFF, 0x28, GB_XOR_N),
+        GB_INSTRUCTION(0xFF, 0xEE, GB_XOR_N),
         GB_INSTRUCTION(0xFF, 0xAE, GB_XOR_HL),
-        GB_INSTRUCTION(0xF8, 0xB0, GB_OR_R),
-        GB_INSTRUCTION(0xFF, 0x30, GB_OR_N),
+        GB_INSTRUCTION(0xFF, 0xF6, GB_OR_N),
         GB_INSTRUCTION(0xFF, 0xB6, GB_OR_HL),
-        GB_INSTRUCTION(0xF8, 0xB8, GB_CP_R),
         GB_INSTRUCTION(0xFF, 0xFE, GB_CP_N),
         GB_INSTRUCTION(0xFF, 0xBE, GB_CP_HL),
-        GB_INSTRUCTION(0xC7, 0x04, GB_INC_R),
         GB_INSTRUCTION(0xFF, 0x34, GB_INC_HL),
-        GB_INSTRUCTION(0xC7, 0x05, GB_DEC_R),
         GB_INSTRUCTION(0xFF, 0x35, GB_DEC_HL),
         GB_INSTRUCTION(0xFF, 0x27, GB_DAA),
         GB_INSTRUCTION(0xFF, 0x2F, GB_CPL),
@@ -73,7 +102,7 @@ static GameBoyInstruction s_gb_instruction_set[GB_INSTRUCTION_SET_LENGHT] =
         // 16 BIT ALU INSTRUCTIONS
         GB_INSTRUCTION(0xCF, 0x09, GB_ADD_HL_RR),
         GB_INSTRUCTION(0xCF, 0x03, GB_INC_RR),
-        GB_INSTRUCTION(0XCB, 0x0B, GB_DEC_RR),
+        GB_INSTRUCTION(0xCF, 0x0B, GB_DEC_RR),
         GB_INSTRUCTION(0xFF, 0xE8, GB_ADD_SP_DD),
         GB_INSTRUCTION(0xFF, 0xF8, GB_LD_HL_SP_PLUS_DD),
 
@@ -86,7 +115,6 @@ static GameBoyInstruction s_gb_instruction_set[GB_INSTRUCTION_SET_LENGHT] =
         // CPU CONTROL INSTRUCTIONS
         GB_INSTRUCTION(0xFF, 0x3F, GB_CCF),
         GB_INSTRUCTION(0xFF, 0x37, GB_SCF),
-        GB_INSTRUCTION(0xFF, 0x76, GB_HALT),  
         GB_INSTRUCTION(0xFF, 0x10, GB_STOP),
         GB_INSTRUCTION(0xFF, 0xF3, GB_DI),
         GB_INSTRUCTION(0xFF, 0xFB, GB_EI),
@@ -94,42 +122,87 @@ static GameBoyInstruction s_gb_instruction_set[GB_INSTRUCTION_SET_LENGHT] =
         // JUMP INSTRUCTIONS
         GB_INSTRUCTION(0xFF, 0xC3, GB_JP_NN),
         GB_INSTRUCTION(0xFF, 0xE9, GB_JP_HL),
-        GB_INSTRUCTION(0xFF, 0xC2, GB_JP_CC_NN),
-        GB_INSTRUCTION(0xF8, 0x18, GB_JR_E),
-        GB_INSTRUCTION(0xF8, 0x20, GB_JR_CC_E),
+        GB_INSTRUCTION(0xE7, 0xC2, GB_JP_CC_NN),
+        GB_INSTRUCTION(0xFF, 0x18, GB_JR_E),
+        GB_INSTRUCTION(0xE7, 0x20, GB_JR_CC_E),
         GB_INSTRUCTION(0xFF, 0xCD, GB_CALL_NN),
         GB_INSTRUCTION(0xE7, 0xC4, GB_CALL_CC_NN),
         GB_INSTRUCTION(0xFF, 0xC9, GB_RET),
-        GB_INSTRUCTION(0xFF, 0xC0, GB_RET_CC),
+        GB_INSTRUCTION(0xE7, 0xC0, GB_RET_CC),
         GB_INSTRUCTION(0xFF, 0xD9, GB_RETI),
-        GB_INSTRUCTION(0xFF, 0xC7, GB_RST_N),
+        GB_INSTRUCTION(0xC7, 0xC7, GB_RST_N),
         
         // The whole cb prefix instructions
         GB_INSTRUCTION(0XFF,0XCB, GB_CB_PREFIX)
     };
 
-uint8_t GB_Initialize(int argc, const char ** argv)
+EmulationInstance GB_CreateInstance()
 {
+    EmulationState *ctx = NULL;
+    MNE_New(ctx, 1, EmulationState);
+
+    return ctx;
+}
+
+void GB_DestroyInstance(EmulationInstance instance)
+{
+    MNE_Delete(instance);
+}
+
+uint8_t GB_Initialize(EmulationInstance instance, int argc, const char ** argv)
+{
+    EmulationState *ctx = (EmulationState *) instance;
+
+    GB_BuildDispatchTable();
+
     //TODO: REMOVE USAGE OF ALLOCATED MEMORY....
-    MNE_New(s_systemContext->bank_00, GB_ROM_SIZE, uint8_t);
-    MNE_New(s_systemContext->vram, GB_VRAM_SIZE, uint8_t);
-    MNE_New(s_systemContext->hram, GB_HRAM_SIZE, uint8_t);
+    MNE_New(ctx->bank_00, GB_ROM_SIZE, uint8_t);
+    MNE_New(ctx->bank_01, GB_ROM_SIZE, uint8_t);
+    MNE_New(ctx->vram, GB_VRAM_SIZE, uint8_t);
+    MNE_New(ctx->wram, GB_WRAM_SIZE, uint8_t);
+    MNE_New(ctx->oam, GB_OAM_SIZE, uint8_t);
+    MNE_New(ctx->hram, GB_HRAM_SIZE, uint8_t);
+    MNE_New(ctx->framebuffer, GB_DISPLAY_WIDHT * GB_DISPLAY_HEIGHT, uint8_t);
+#if defined(GB_CACHED_CORE) || defined(GB_JIT)
+    ctx->blockCache = GB_BlockCacheCreate();
+#endif
+
+#ifdef GB_JIT
+    ctx->jit = GB_JitCreate();
+#endif
+    ctx->idleLoops = GB_IdleLoopCacheCreate();
+    ctx->tileCache = GB_TileCacheCreate();
 
     // TODO: ADD HERE PC = 0X100
-    s_systemContext->bios_enabled = 0; // 0 IS ONLY FOR UNIT TESTING BECAUS WE ARE LOADING IT FROM A FILE AN PLACING IT MANUALLY INTO BANK_00
+    ctx->bios_enabled = 0; // 0 IS ONLY FOR UNIT TESTING BECAUS WE ARE LOADING IT FROM A FILE AN PLACING IT MANUALLY INTO BANK_00
+    GB_BusRemap(ctx);
+
+    // Peripherals schedule their first events
+    GB_SchedulerReset(&ctx->scheduler);
+    GB_LCD_Init(ctx);
+    GB_Timer_Reset(ctx);
 
     return 0;
 }
 
-long GB_LoadProgram(const char *filePath)
+long GB_LoadProgram(EmulationInstance instance, const char *filePath)
 {
-    return MNE_ReadFile(filePath, 0, GB_PopulateMemory);
+    if (instance == NULL) return 0;
+
+    return MNE_ReadFile(filePath, 0, GB_PopulateMemory, instance);
 }
 
-void GB_ParseRom(const uint8_t *buffer, size_t size)
+void GB_ParseRom(EmulationState *ctx, const uint8_t *buffer, size_t size)
 {   
-    MNE_New(s_systemContext->header, 1, GB_Header);
-    GB_Header * header = s_systemContext->header;
+    MNE_New(ctx->header, 1, GB_Header);
+    GB_Header * header = ctx->header;
+
+    // Boot roms and test programs are shorter than the cartridge header, keep it zeroed
+    if (size <= ROM_HEADER_SIZE)
+    {
+        GB_Log(EMULATION, WARN, "[ROM] %zu BYTES, NO CARTRIDGE HEADER\n", size);
+        return;
+    }
 
     header->entry_point = buffer[0x100] | (buffer[0x101] << 8);
 
@@ -204,94 +277,196 @@ void GB_PrintRomInfo(const GB_Header * header)
     MNE_Log("--------------------------------------------------");
 }
 
-void GB_PopulateMemory(const uint8_t *buffer, size_t bytesRead)
+void GB_PopulateMemory(void *instance, const uint8_t *buffer, size_t bytesRead)
 {
+    EmulationState *ctx = (EmulationState *) instance;
+
     //For development program is stored at 0x0000, when using the boot rom (bios) program should start at  0x1000
     uint16_t ramIndex = 0;// replace with 0x1000...
     uint16_t bufferIndex = 0;
 
     // TODO: add bank_00 offset cond: (ramindex + 0x1000) < bytesRead
-    for (; ramIndex < bytesRead; ramIndex++, bufferIndex++)
+    for (; ramIndex < bytesRead && ramIndex < GB_ROM_SIZE; ramIndex++, bufferIndex++)
+    {
+        ctx->bank_00[ramIndex] = buffer[bufferIndex];
+    }
+
+    // 32 KB roms (no mapper) have a fixed second bank, bigger roms need an MBC (not implemented)
+    if (bytesRead > GB_ROM_SIZE)
+    {
+        const size_t lenght = bytesRead - GB_ROM_SIZE < GB_ROM_SIZE ? bytesRead - GB_ROM_SIZE : GB_ROM_SIZE;
+
+        memset(ctx->bank_01, 0, GB_ROM_SIZE);
+        memcpy(ctx->bank_01, buffer + GB_ROM_SIZE, lenght);
+        GB_BusMapRomBank(ctx, ctx->bank_01);
+
+        if (bytesRead > GB_ROM_SIZE * 2)
+        {
+            GB_Log(EMULATION, WARN, "[ROM] %zu BYTES, NO MBC: ONLY BANKS 00 AND 01 ARE MAPPED\n", bytesRead);
+        }
+    }
+    else if (ctx->bank_nn == ctx->bank_01)
     {
-        s_systemContext->bank_00[ramIndex] = buffer[bufferIndex];
+        GB_BusMapRomBank(ctx, NULL);
     }
+    GB_BlockCacheInvalidate(ctx->blockCache);
+    GB_IdleLoopCacheReset(ctx->idleLoops);
     //TODO: ADD RETURN TO CHECK 
-    GB_ParseRom(buffer,bytesRead);
+    GB_ParseRom(ctx, buffer, bytesRead);
 }
 
-void GB_QuitProgram()
+void GB_QuitProgram(EmulationInstance instance)
 {
-    if (s_systemContext == NULL) 
+    EmulationState *ctx = (EmulationState *) instance;
+
+    if (ctx == NULL) 
     {
         return;
     }
 
-    MNE_Delete(s_systemContext->bank_00);
-    MNE_Delete(s_systemContext->vram);
-    MNE_Delete(s_systemContext->hram);
+    MNE_Delete(ctx->bank_00);
+    MNE_Delete(ctx->bank_01);
+    MNE_Delete(ctx->vram);
+    MNE_Delete(ctx->wram);
+    MNE_Delete(ctx->oam);
+    MNE_Delete(ctx->hram);
+    MNE_Delete(ctx->framebuffer);
+
+#ifdef GB_JIT
+    if (ctx->jit != NULL)
+    {
+#ifdef GB_DEBUG
+        GB_JitPrintStats(ctx->jit);
+#endif
+        GB_JitDestroy(ctx->jit);
+        ctx->jit = NULL;
+    }
+#endif
+
+    if (ctx->blockCache != NULL)
+    {
+#ifdef GB_DEBUG
+        GB_BlockCachePrintStats(ctx->blockCache);
+#endif
+        GB_BlockCacheDestroy(ctx->blockCache);
+        ctx->blockCache = NULL;
+    }
+
+    if (ctx->pairProfile != NULL)
+    {
+#ifdef GB_DEBUG
+        GB_PairProfilePrintReport(ctx->pairProfile, GB_PAIR_PROFILE_REPORT_LENGHT);
+#endif
+        GB_PairProfileDestroy(ctx->pairProfile);
+        ctx->pairProfile = NULL;
+    }
+
+    if (ctx->profiler != NULL)
+    {
+        GB_ProfilerPrintReport(ctx->profiler, GB_PROFILER_REPORT_LENGHT);
+        GB_ProfilerWriteCsv(ctx->profiler, ctx->profiler->csvPath);
+        GB_ProfilerDestroy(ctx->profiler);
+        ctx->profiler = NULL;
+        ctx->profiling = 0;
+    }
+
+    if (ctx->tileCache != NULL)
+    {
+#ifdef GB_DEBUG
+        GB_TileCachePrintStats(ctx->tileCache);
+#endif
+        GB_TileCacheDestroy(ctx->tileCache);
+        ctx->tileCache = NULL;
+    }
+
+    if (ctx->idleLoops != NULL)
+    {
+#ifdef GB_DEBUG
+        GB_IdleLoopPrintReport(ctx->idleLoops);
+#endif
+        GB_IdleLoopCacheDestroy(ctx->idleLoops);
+        ctx->idleLoops = NULL;
+    }
     
-    MNE_Delete(s_systemContext->header);
+    MNE_Delete(ctx->header);
+
+    // Back to the GB_CreateInstance state (pages pointed to the memory freed above)
+    memset(ctx, 0, sizeof(EmulationState));
 }
 
-void GB_TickTimers()
+void GB_TickTimers(EmulationInstance instance)
 {
-
+    // Nothing to do, the game boy timer runs on scheduler events (GB_Timer.h)
 }
 
-uint8_t GB_HandleInterrupts()
+void GB_AdvanceClock(EmulationState *ctx, const uint16_t cycles)
 {
-    //TODO: IMPLEMENT HALT BUG (LOL)
-    uint16_t interruptSrc = 0;
+    GB_Event event;
 
-    if (!s_systemContext->ime)
-    {
-        return 0; // 0 clock cycles consumed
-    } 
+    ctx->cpuCycles += cycles;
 
-    // VBLANK INTERRUPT
-    if (s_systemContext->registers.IE.VBLANK && s_systemContext->registers.IF.VBLANK){
-        interruptSrc = 0x40; // VBLANK INTERRUPT SOURCE
-        s_systemContext->registers.IF.VBLANK = 0;
+    while (GB_SchedulerPopDue(&ctx->scheduler, ctx->cpuCycles, &event))
+    {
+        s_gb_event_handlers[event.type](ctx, event.deadline);
     }
+}
 
-    if (s_systemContext->registers.IE.LCD && s_systemContext->registers.IF.LCD){
-        interruptSrc = 0x48; // LCD STAT INTERRUPT SOURCE
-        s_systemContext->registers.IF.LCD = 0;
-    }
-    
-    if (s_systemContext->registers.IE.SERIAL && s_systemContext->registers.IF.SERIAL)
+uint16_t GB_CyclesUntilNextEvent(const EmulationState *ctx)
+{
+    const uint64_t deadline = GB_SchedulerNextDeadline(&ctx->scheduler);
+
+    if (deadline <= ctx->cpuCycles)
     {
-        interruptSrc = 0x58; // SERIAL INTERRUPT SOURCE
-        s_systemContext->registers.IF.SERIAL = 0;
+        return 1;
     }
 
-    if (s_systemContext->registers.IE.JOYPAD && s_systemContext->registers.IF.JOYPAD)
+    return deadline - ctx->cpuCycles > 0xFFFF ? 0xFFFF : (uint16_t)(deadline - ctx->cpuCycles);
+}
+
+uint8_t GB_HandleInterrupts(EmulationState *ctx)
+{
+    //TODO: IMPLEMENT HALT BUG (LOL)
+    const uint8_t pending = ctx->registers.IE.value & ctx->registers.IF.value & GB_INTERRUPT_MASK;
+
+    if (!ctx->ime || pending == 0)
     {
-        interruptSrc = 0x60; // JOYPAD INTERRUPT SOURCE
-        s_systemContext->registers.IF.JOYPAD = 0;
+        return 0; // 0 clock cycles consumed
     }
 
-    s_systemContext->ime = 0; // Disable intterupts before calling the intrrupt handler
+    // Highest priority source is the lowest pending bit
+    const uint8_t source = s_gb_interrupt_priority[pending];
+
+    ctx->registers.IF.value &= ~(1 << source);
+    GB_InterruptUpdatePending(ctx);
+
+    ctx->ime = 0; // Disable intterupts before calling the intrrupt handler
+    GB_FlagsSync(ctx);
 
     // TODO: This should be an GB_CALL function but i didnt make to support operands; only context argument...
-    s_systemContext->registers.SP--;
-    GB_BusWrite(s_systemContext, s_systemContext->registers.SP--, s_systemContext->registers.PC >> 8);
-    GB_BusWrite(s_systemContext, s_systemContext->registers.SP, s_systemContext->registers.PC & 0xFF);
+    ctx->registers.SP--;
+    GB_BusWrite(ctx, ctx->registers.SP--, ctx->registers.PC >> 8);
+    GB_BusWrite(ctx, ctx->registers.SP, ctx->registers.PC & 0xFF);
     
-    s_systemContext->registers.PC = interruptSrc;
+    ctx->registers.PC = GB_INTERRUPT_VECTOR(source);
 
-    // From magical sources, this is what it lasts the full interrupt handling (2 nops and a call that lasts only 3 M-Cycles)
-    return 5;
+    return GB_INTERRUPT_DISPATCH_CYCLES;
 }
 
-uint8_t  GB_TickCpu()
+uint8_t  GB_TickCpu(EmulationState *ctx)
 {
     //TODO: Implement CPU step function that take into account prefetch cycle (before executing an instruction fetch another one then execute both in order)
     // Fetch
-    const uint8_t instr = GB_BusRead(s_systemContext, s_systemContext->registers.PC++);
+    const uint8_t instr = GB_BusRead(ctx, ctx->registers.PC++);
 
-    const GameBoyInstruction *fetchedInstruction = GB_FetchInstruction(instr);
+    const GameBoyInstruction *fetchedInstruction = ctx->linearDecode ? GB_FetchInstruction(instr) : GB_DecodeInstruction(instr);
     uint8_t clockCycles = 0;
+
+    ctx->instructions++;
+
+    if (ctx->pairProfile != NULL)
+    {
+        GB_PairProfileRecord(ctx->pairProfile, instr);
+    }
     
     // Instruction execution
     if (fetchedInstruction->handler != NULL)
@@ -299,50 +474,167 @@ uint8_t  GB_TickCpu()
         // This is to ignore the NOPS on the units tests... (due to ticking programs more than it needed)
         if (fetchedInstruction->opcode == 0)
         {
-            s_systemContext->registers.PC--;
+            ctx->registers.PC--;
             return 1;
         }
         
-#ifdef GB_DEBUG
-        if (instr != 0xCB) {
-            MNE_Log("%-32s PC:[0x%02X] HANDLER: %s\n", gb_opcodes_names[instr], s_systemContext->registers.PC - 1, fetchedInstruction->handlerName);
-        }
-#endif
-        s_systemContext->registers.INSTRUCTION = instr;
-        clockCycles = fetchedInstruction->handler(s_systemContext);
+        GB_Trace(CPU, "[CPU] PC:[0x%04X] OPCODE:[0x%02X]\n", ctx->registers.PC - 1, instr);
+        ctx->registers.INSTRUCTION = instr;
+        clockCycles = fetchedInstruction->handler(ctx);
 
         return clockCycles;
     }
     else
-    {        
-        s_systemContext->registers.INSTRUCTION = GB_INVALID_INSTRUCTION; // Invalidate last instruction entry
-        GB_BusWrite(s_systemContext, GB_HALT_REGISTER, 0x01);
+    {
+        return GB_InvalidInstruction(ctx, instr);
+    }
+}
+
+uint8_t GB_InvalidInstruction(EmulationState *ctx, const uint8_t instr)
+{
+    ctx->registers.INSTRUCTION = GB_INVALID_INSTRUCTION; // Invalidate last instruction entry
+    GB_BusWrite(ctx, GB_HALT_REGISTER, 0x01);
+
+    GB_Log(CPU, ERROR, "[INVALID INSTRUCTION]:[%02X][HALTED]\n", instr);
+    return 0;
+}
 
-        MNE_Log("[INVALID INSTRUCTION]:[%02X][HALTED]\n", instr);
-        return 0;
+// One step of the selected core (instruction, block or batch bounded by budget, the whole budget while halted), returns 0 when the cpu stopped (invalid opcode)
+static uint16_t GB_StepCpu(EmulationState *ctx, const uint16_t budget)
+{
+    if (ctx->halted)
+    {
+        // Nothing can request an interrupt before the next scheduler event, jump straight to it (budget)
+        if (!ctx->interruptPending)
+        {
+            ctx->haltedCycles += budget;
+            return budget;
+        }
+
+        ctx->halted = 0;
+    }
+
+    // Profiled instructions are single stepped and timed one by one (GB_Profiler.h)
+    if (ctx->profiling)
+    {
+        const uint16_t interruptCycles = ctx->interruptPending ? GB_HandleInterrupts(ctx) : 0;
+        return interruptCycles + GB_ProfilerStep(ctx);
     }
+
+    // Same for LY/STAT/IF/DIV/TIMA polling loops, whole iterations are skipped until the polled register changes
+    uint16_t idleCycles = 0;
+
+    if (GB_IdleLoopRun(ctx, budget, &idleCycles))
+    {
+        return idleCycles;
+    }
+
+    // Nothing requested (or enabled) since the last dispatch, the interrupt check is a single byte test
+    uint16_t currentCycles = ctx->interruptPending ? GB_HandleInterrupts(ctx) : 0;
+
+#ifdef GB_THREADED_CORE
+    // Run until the budget (next scheduler event), peripherals only see the clock once per batch
+    currentCycles += GB_RunThreaded(ctx, budget);
+#elif defined(GB_JIT)
+    // Same as the cached core, hot blocks run as x86-64 code (GB_Jit.h); without a code arena everything is single stepped
+    uint16_t blockCycles = 0;
+    const uint8_t ranBlock = ctx->jit != NULL && GB_JitRun(ctx, budget, &blockCycles);
+    currentCycles += ranBlock ? blockCycles : GB_TickCpu(ctx);
+#elif defined(GB_CACHED_CORE)
+    // One decoded rom block per step (bounded by the budget), anything else is single stepped
+    uint16_t blockCycles = 0;
+    currentCycles += GB_BlockCacheRun(ctx, budget, &blockCycles) ? blockCycles : GB_TickCpu(ctx);
+#else
+    (void)budget;
+    currentCycles += GB_TickCpu(ctx);
+#endif
+
+    return currentCycles;
 }
 
-int GB_TickEmulation()
+int GB_TickEmulation(EmulationInstance instance)
 {
-    uint8_t currentCycles = 0; 
-    
-    if (s_systemContext == NULL) return 0;
+    EmulationState *ctx = (EmulationState *) instance;
 
-    // CPU
-    currentCycles += GB_HandleInterrupts();
-    currentCycles += GB_TickCpu();
-    
-    // DISPLAY
-    GB_LCD_Tick(s_systemContext, currentCycles);
-    s_systemContext->cpuCycles += currentCycles;
+    if (ctx == NULL) return 0;
+
+    // PPU, TIMER, DMA, SERIAL (only when one of their events is due)
+    GB_AdvanceClock(ctx, GB_StepCpu(ctx, GB_CyclesUntilNextEvent(ctx)));
+
+    // F is readable from outside the emulation between calls
+    GB_FlagsSync(ctx);
 
     return 1;
 }
 
+uint64_t GB_RunCycles(EmulationInstance instance, const uint64_t budget)
+{
+    EmulationState *ctx = (EmulationState *) instance;
+
+    if (ctx == NULL) return 0;
+
+    const uint64_t start = ctx->cpuCycles;
+    const uint64_t target = start + budget;
+
+    while (ctx->cpuCycles < target)
+    {
+        uint16_t stepBudget = GB_CyclesUntilNextEvent(ctx);
+
+        if (stepBudget > target - ctx->cpuCycles)
+        {
+            stepBudget = (uint16_t)(target - ctx->cpuCycles);
+        }
+
+        const uint16_t cycles = GB_StepCpu(ctx, stepBudget);
+
+        if (cycles == 0)
+        {
+            break;
+        }
+
+        GB_AdvanceClock(ctx, cycles);
+    }
+
+    // Lazy flags are written back once per run (F is readable from outside the emulation between calls)
+    GB_FlagsSync(ctx);
+
+    return ctx->cpuCycles - start;
+}
+
+uint64_t GB_RunFrame(EmulationInstance instance)
+{
+    return GB_RunCycles(instance, GB_FRAME_CYCLES);
+}
+
+// Not on GB_CPU.h, the CB table is only built from here (GB_CPU.c)
+void GB_BuildCBDispatchTable();
+
+static void GB_BuildDispatchTableOnce()
+{
+    // Resolve every opcode once using the mask table, first match wins (same as the linear scan)
+    for (uint16_t opcode = 0x00; opcode < GB_DISPATCH_TABLE_LENGHT; opcode++)
+    {
+        s_gb_dispatch_table[opcode] = GB_FetchInstruction((uint8_t) opcode);
+    }
+
+    GB_BuildCBDispatchTable();
+}
+
+void GB_BuildDispatchTable()
+{
+    // Instances can be initialized from several threads at the same time
+    pthread_once(&s_gb_dispatch_table_once, GB_BuildDispatchTableOnce);
+}
+
+GameBoyInstruction* GB_DecodeInstruction(const uint8_t opcode)
+{
+    return s_gb_dispatch_table[opcode];
+}
+
+// Linear mask scan, only used to build the dispatch table (and as reference on the benchmarks)
 GameBoyInstruction* GB_FetchInstruction(const uint8_t opcode)
 {
-    for (int  i = 0x00; i <= GB_INSTRUCTION_SET_LENGHT; i++)
+    for (int  i = 0x00; i < GB_INSTRUCTION_SET_LENGHT; i++)
     {
         uint16_t opmask = (opcode & s_gb_instruction_set[i].maskl);
 
@@ -354,10 +646,47 @@ GameBoyInstruction* GB_FetchInstruction(const uint8_t opcode)
 
     return NULL;
 }
-// TODO: FIX USAGE WHEN EMPTY INITIALIZED(EMULATOR FIRST RUN ON THE MENU...)
-void GB_SetEmulationContext(const void *context)
+double GB_HaltedRatio(const EmulationState *ctx)
+{
+    return ctx->cpuCycles != 0 ? (double) ctx->haltedCycles / (double) ctx->cpuCycles : 0.0;
+}
+
+int GB_DumpRegisters(EmulationInstance instance, char *buffer, const size_t size)
+{
+    const EmulationState *ctx = (const EmulationState *) instance;
+    const GB_Registers *registers = &ctx->registers;
+
+    return snprintf(buffer, size,
+                    "{\"A\":%u,\"F\":%u,\"B\":%u,\"C\":%u,\"D\":%u,\"E\":%u,\"H\":%u,\"L\":%u,"
+                    "\"SP\":%u,\"PC\":%u,\"IME\":%u,\"INSTRUCTION\":%u,\"CYCLES\":%llu,\"INSTRUCTIONS\":%llu,\"HALTED_RATIO\":%.4f}",
+                    registers->A, registers->F, registers->B, registers->C, registers->D, registers->E, registers->H, registers->L,
+                    registers->SP, registers->PC, ctx->ime, registers->INSTRUCTION,
+                    (unsigned long long)ctx->cpuCycles, (unsigned long long)ctx->instructions, GB_HaltedRatio(ctx));
+}
+
+void GB_SetProfiling(EmulationInstance instance, const uint8_t enabled)
+{
+    EmulationState *ctx = (EmulationState *) instance;
+
+    if (ctx == NULL) return;
+
+    if (enabled && ctx->profiler == NULL)
+    {
+        ctx->profiler = GB_ProfilerCreate();
+    }
+
+    ctx->profiling = enabled != 0;
+}
+
+void GB_SetRenderInterval(EmulationInstance instance, const uint16_t interval)
 {
-    s_systemContext = (EmulationState*) context;
+    EmulationState *ctx = (EmulationState *) instance;
+
+    if (ctx == NULL) return;
+
+    // Other intervals wait for the next frame, none stops at once
+    ctx->renderInterval = interval;
+    ctx->renderFrame = ctx->renderFrame && interval != 0;
 }
 
 EmulationInfo GB_GetInfo()
@@ -378,46 +707,19 @@ EmulationInfo GB_GetInfo()
 
 const uint32_t pallete[] = {0x9BBC0FFF , 0x8BAC0FFF, 0x306230FF, 0x0F380FFF}; // green shades
  
-// Renders n 8x8 pixel tiles
-void GB_RenderTile(uint32_t* pixels, const uint8_t* tile, const uint16_t x, const uint16_t y)
+// Shades of the last rendered lines (GB_RenderScanLine), the frame is only composed by the LCD
+void GB_OnRender(EmulationInstance instance, uint32_t * pixels, const int64_t w, const int64_t h)
 {
-    for (uint8_t tileIndex = 0;  tileIndex  < 16; tileIndex += 2)
-    {
-        for (uint8_t tileBitPos = 0;  tileBitPos < 8; tileBitPos++)
-        {
-            uint8_t colorIndex =  (tile[tileIndex]  >> tileBitPos & 0x01) | (((tile[tileIndex + 1] >> tileBitPos ) & 0x01)  << 1);
+    const EmulationState *ctx = (const EmulationState *) instance;
 
-            const uint64_t pixelIndex = (x - tileBitPos) + (GB_DISPLAY_WIDHT * ((tileIndex / 2) + y));
-            pixels[pixelIndex] = pallete[colorIndex];
-        }
-    }
-}
+    if (ctx == NULL || ctx->framebuffer == NULL) return;
 
-// TODO: THIS FUNCTION ONLY DOES MINIMAL TILE RENDERING AND IS A TEST... (LCD CONTROLLER GOES HERE ALONG WITH THE PPU.. PROCESING)
-void GB_OnRender(uint32_t * pixels, const int64_t w, const int64_t h)
-{
-    // provided by pan-docs game boy documentation :3
-    const uint8_t gameboy_tile[] = {0x3C, 0x7E, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x7E, 0x5E, 0x7E, 0x0A, 0x7C, 0x56, 0x38, 0x7C};
-    
-    // if (s_systemContext == NULL) return;
+    const int64_t width = w < GB_DISPLAY_WIDHT ? w : GB_DISPLAY_WIDHT;
+    const int64_t height = h < GB_DISPLAY_HEIGHT ? h : GB_DISPLAY_HEIGHT;
+    const GB_PpuKernels *kernels = GB_PpuSelectKernels();
 
-    // TODO: Make this pattern default startup screen on the sdl app screen initialiazation
-    // rendering has to be performed from upper left side of the screen...
-    for (int i = 0; i < GB_DISPLAY_HEIGHT; i++)
+    for (int64_t y = 0; y < height; y++)
     {
-        for (int j = 0; j < GB_DISPLAY_WIDHT; j++)
-        {
-            const uint64_t pixelIndex = i * GB_DISPLAY_WIDHT + j;
-                    
-            pixels[pixelIndex] = pallete[(i + j) % 2];
-        }
+        kernels->expand(&pixels[y * w], &ctx->framebuffer[y * GB_DISPLAY_WIDHT], pallete, (size_t)width);
     }
-    
-    // Pallete rendering test
-    for (int j = 0; j < 4; j++)
-    {        
-        pixels[j] = pallete[j];
-    }
-
-    GB_RenderTile(pixels, gameboy_tile, GB_DISPLAY_WIDHT / 2 , GB_DISPLAY_HEIGHT / 2);
 }
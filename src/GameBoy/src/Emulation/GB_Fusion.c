@@ -0,0 +1,205 @@
+#include <Emulation/GB_Fusion.h>
+#include <Emulation/GB_Emulation.h>
+
+#include <minemu/MNE_Memory.h>
+#include <minemu/MNE_Log.h>
+
+// Fused handlers start like any other handler (PC past the first opcode, INSTRUCTION = first opcode) and leave PC and
+// INSTRUCTION where the last instruction would
+
+static uint8_t GB_FusedLdiAHLLdDEA(EmulationState *ctx)
+{
+    // LD A,(HL+)
+    ctx->registers.A = GB_BusRead(ctx, ctx->registers.HL++);
+
+    // LD (DE),A
+    ctx->registers.PC++;
+    ctx->registers.INSTRUCTION = 0x12;
+    GB_BusWrite(ctx, ctx->registers.DE, ctx->registers.A);
+
+    return gb_opcodes_cycles[0x2A] + gb_opcodes_cycles[0x12];
+}
+
+// JR NZ,e closing a sequence (Z comes from the value the sequence just computed)
+static inline uint8_t GB_FusedJrNZ(EmulationState *ctx, const uint8_t value)
+{
+    ctx->registers.PC++;
+    ctx->registers.INSTRUCTION = 0x20;
+    const int8_t e = GB_BusRead(ctx, ctx->registers.PC++);
+
+    if (value != 0)
+    {
+        ctx->registers.PC += e;
+        return gb_opcodes_cycles[0x20];
+    }
+
+    return gb_opcodes_cycles_not_taken[0x20];
+}
+
+static uint8_t GB_FusedDecBJrNZ(EmulationState *ctx)
+{
+    ctx->registers.B = GB_ALU_Dec8(ctx, ctx->registers.B);
+
+    return gb_opcodes_cycles[0x05] + GB_FusedJrNZ(ctx, ctx->registers.B);
+}
+
+static uint8_t GB_FusedDecCJrNZ(EmulationState *ctx)
+{
+    ctx->registers.C = GB_ALU_Dec8(ctx, ctx->registers.C);
+
+    return gb_opcodes_cycles[0x0D] + GB_FusedJrNZ(ctx, ctx->registers.C);
+}
+
+static uint8_t GB_FusedLdABOrCJrNZ(EmulationState *ctx)
+{
+    // LD A,B
+    ctx->registers.A = ctx->registers.B;
+
+    // OR C
+    ctx->registers.PC++;
+    ctx->registers.A = GB_ALU_Or8(ctx, ctx->registers.A, ctx->registers.C);
+
+    return gb_opcodes_cycles[0x78] + gb_opcodes_cycles[0xB1] + GB_FusedJrNZ(ctx, ctx->registers.A);
+}
+
+static uint8_t GB_FusedLdhANCpN(EmulationState *ctx)
+{
+    // LDH A,(n)
+    const uint8_t n = GB_BusRead(ctx, ctx->registers.PC++);
+    ctx->registers.A = GB_BusRead(ctx, 0xFF00 | n);
+
+    // CP n
+    ctx->registers.PC++;
+    ctx->registers.INSTRUCTION = 0xFE;
+    GB_ALU_Sub8(ctx, ctx->registers.A, GB_BusRead(ctx, ctx->registers.PC++), 0);
+
+    return gb_opcodes_cycles[0xF0] + gb_opcodes_cycles[0xFE];
+}
+
+// GB_FusionId order
+static const GB_Fusion s_gb_fusions[GB_FUSION_COUNT] =
+{
+    {"NONE",                     {0x00},             1, 1, NULL},
+    {"LD A,(HL+); LD (DE),A",    {0x2A, 0x12},       2, 2, GB_FusedLdiAHLLdDEA},
+    {"DEC B; JR NZ,e",           {0x05, 0x20},       2, 3, GB_FusedDecBJrNZ},
+    {"DEC C; JR NZ,e",           {0x0D, 0x20},       2, 3, GB_FusedDecCJrNZ},
+    {"LD A,B; OR C; JR NZ,e",    {0x78, 0xB1, 0x20}, 3, 4, GB_FusedLdABOrCJrNZ},
+    {"LDH A,(n); CP n",          {0xF0, 0xFE},       2, 4, GB_FusedLdhANCpN},
+};
+
+const GB_Fusion *GB_FusionGet(const uint8_t id)
+{
+    return &s_gb_fusions[id];
+}
+
+uint8_t GB_FusionMatch(EmulationState *ctx, const uint16_t pc, const uint16_t regionEnd, const uint32_t enabled)
+{
+    for (uint8_t id = GB_FUSION_NONE + 1; id < GB_FUSION_COUNT; id++)
+    {
+        const GB_Fusion *fusion = &s_gb_fusions[id];
+
+        if (!(enabled & GB_FUSION_BIT(id)) || (uint32_t)pc + fusion->bytes - 1 > regionEnd)
+        {
+            continue;
+        }
+
+        uint16_t address = pc;
+        uint8_t i = 0;
+
+        for (; i < fusion->lenght; i++)
+        {
+            const uint8_t opcode = GB_BusRead(ctx, address);
+
+            if (opcode != fusion->opcodes[i])
+            {
+                break;
+            }
+
+            address += gb_opcodes_length[opcode];
+        }
+
+        if (i == fusion->lenght)
+        {
+            return id;
+        }
+    }
+
+    return GB_FUSION_NONE;
+}
+
+GB_PairProfile *GB_PairProfileCreate()
+{
+    GB_PairProfile *profile = NULL;
+    MNE_New(profile, 1, GB_PairProfile);
+
+    profile->previous = 0x100;
+    return profile;
+}
+
+void GB_PairProfileDestroy(GB_PairProfile *profile)
+{
+    MNE_Delete(profile);
+}
+
+static const char *GB_PairProfileFusion(const uint16_t pair)
+{
+    for (uint8_t id = GB_FUSION_NONE + 1; id < GB_FUSION_COUNT; id++)
+    {
+        if (((s_gb_fusions[id].opcodes[0] << 8) | s_gb_fusions[id].opcodes[1]) == pair)
+        {
+            return s_gb_fusions[id].name;
+        }
+    }
+
+    return "";
+}
+
+void GB_PairProfilePrintReport(const GB_PairProfile *profile, const uint16_t top)
+{
+    uint64_t total = 0;
+
+    for (uint32_t pair = 0; pair < GB_PAIR_PROFILE_LENGHT; pair++)
+    {
+        total += profile->counts[pair];
+    }
+
+    MNE_Log("[PAIR PROFILE] EXECUTED PAIRS: %llu\n", (unsigned long long)total);
+
+    // Selection by repeated max scans (report only, top is small)
+    uint64_t previousCount = UINT64_MAX;
+    uint32_t previousPair = 0;
+    uint16_t printed = 0;
+
+    while (printed < top)
+    {
+        uint64_t bestCount = 0;
+        uint32_t bestPair = 0;
+
+        for (uint32_t pair = 0; pair < GB_PAIR_PROFILE_LENGHT; pair++)
+        {
+            const uint64_t count = profile->counts[pair];
+
+            // Same order as a stable sort by count (descending), pair (ascending)
+            const uint8_t afterPrevious = count < previousCount || (count == previousCount && pair > previousPair);
+
+            if (afterPrevious && count > bestCount)
+            {
+                bestCount = count;
+                bestPair = pair;
+            }
+        }
+
+        if (bestCount == 0)
+        {
+            break;
+        }
+
+        MNE_Log("[PAIR PROFILE] %02X %02X %-12s %-12s %12llu %6.2f%% %s\n", bestPair >> 8, bestPair & 0xFF,
+                gb_opcodes_names[bestPair >> 8], gb_opcodes_names[bestPair & 0xFF], (unsigned long long)bestCount,
+                100.0 * bestCount / total, GB_PairProfileFusion(bestPair));
+
+        previousCount = bestCount;
+        previousPair = bestPair;
+        printed++;
+    }
+}
@@ -0,0 +1,295 @@
+#include <Emulation/GB_IdleLoop.h>
+#include <Emulation/GB_Emulation.h>
+#include <Emulation/GB_Log.h>
+
+#include <minemu/MNE_Memory.h>
+#include <minemu/MNE_Log.h>
+
+GB_IdleLoopCache *GB_IdleLoopCacheCreate()
+{
+    GB_IdleLoopCache *cache = NULL;
+    MNE_New(cache, 1, GB_IdleLoopCache);
+
+    return cache;
+}
+
+void GB_IdleLoopCacheDestroy(GB_IdleLoopCache *cache)
+{
+    MNE_Delete(cache);
+}
+
+void GB_IdleLoopCacheReset(GB_IdleLoopCache *cache)
+{
+    if (cache == NULL)
+    {
+        return;
+    }
+
+    memset(cache->loops, 0, sizeof(cache->loops));
+}
+
+// Registers that change without the cpu writing them (scheduler events or the timer clock)
+static uint8_t GB_IdleLoopIsPolledRegister(const uint16_t address)
+{
+    switch (address)
+    {
+    case GB_IF_REGISTER:
+    case GB_DIV_REGISTER:
+    case GB_TIMA_REGISTER:
+    case GB_LCD_STAT_REGISTER:
+    case GB_LY_REGISTER:
+        return 1;
+    }
+
+    return 0;
+}
+
+// Decodes the loop starting at start, accepted when every instruction only reads the polled register or writes A/F and it closes with a branch back to start
+static void GB_IdleLoopDecode(EmulationState *ctx, GB_IdleLoop *loop, const uint16_t start)
+{
+    memset(loop, 0, sizeof(GB_IdleLoop));
+    loop->start = start;
+    loop->state = GB_IDLE_LOOP_REJECTED;
+
+    uint16_t offset = 0;
+
+    while (offset < GB_IDLE_LOOP_MAX_LENGHT)
+    {
+        const uint16_t pc = start + offset;
+        const uint8_t opcode = GB_BusRead(ctx, pc);
+        uint8_t lenght = gb_opcodes_length[opcode];
+        uint16_t cycles = gb_opcodes_cycles[opcode];
+        uint16_t address = 0;
+        int32_t target = -1;
+
+        switch (opcode)
+        {
+        case 0xF0: // LDH A,(n)
+            address = 0xFF00 | GB_BusRead(ctx, pc + 1);
+            break;
+
+        case 0xFA: // LD A,(nn)
+            address = GB_BusRead(ctx, pc + 1) | (GB_BusRead(ctx, pc + 2) << 8);
+            break;
+
+        case 0xFE: // CP n
+        case 0xE6: // AND n
+        case 0xF6: // OR n
+        case 0xEE: // XOR n
+        case 0xA7: // AND A
+        case 0xB7: // OR A
+        case 0xBF: // CP A
+            break;
+
+        case 0xCB: // BIT b,A
+        {
+            const uint8_t cbOpcode = GB_BusRead(ctx, pc + 1);
+
+            if ((cbOpcode & 0xC7) != 0x47)
+            {
+                return;
+            }
+
+            lenght = 2;
+            cycles = gb_cb_opcodes_cycles[cbOpcode];
+            break;
+        }
+
+        case 0x18: // JR e
+        case 0x20: // JR NZ,e
+        case 0x28: // JR Z,e
+        case 0x30: // JR NC,e
+        case 0x38: // JR C,e
+            target = (uint16_t)(pc + 2 + (int8_t) GB_BusRead(ctx, pc + 1));
+            break;
+
+        case 0xC3: // JP nn
+        case 0xC2: // JP NZ,nn
+        case 0xCA: // JP Z,nn
+        case 0xD2: // JP NC,nn
+        case 0xDA: // JP C,nn
+            target = GB_BusRead(ctx, pc + 1) | (GB_BusRead(ctx, pc + 2) << 8);
+            break;
+
+        default:
+            return;
+        }
+
+        if (offset + lenght > GB_IDLE_LOOP_MAX_LENGHT)
+        {
+            return;
+        }
+
+        // Only one register per loop, its next change bounds the skip
+        if (address != 0)
+        {
+            if (!GB_IdleLoopIsPolledRegister(address) || (loop->polledAddress != 0 && loop->polledAddress != address))
+            {
+                return;
+            }
+
+            loop->polledAddress = address;
+        }
+
+        loop->cycles += cycles;
+        loop->instructions++;
+        offset += lenght;
+
+        if (target >= 0)
+        {
+            if (target != start)
+            {
+                return;
+            }
+
+            loop->end = start + offset - 1;
+            loop->lenght = (uint8_t) offset;
+            loop->state = GB_IDLE_LOOP_ACCEPTED;
+
+            for (uint8_t i = 0; i < loop->lenght; i++)
+            {
+                loop->code[i] = GB_BusRead(ctx, start + i);
+            }
+            return;
+        }
+    }
+}
+
+static uint8_t GB_IdleLoopCodeMatches(EmulationState *ctx, const GB_IdleLoop *loop)
+{
+    for (uint8_t i = 0; i < loop->lenght; i++)
+    {
+        if (GB_BusRead(ctx, loop->start + i) != loop->code[i])
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// One real iteration, 1 when it branched back to the head on the expected cycles
+static uint8_t GB_IdleLoopIterate(EmulationState *ctx, const GB_IdleLoop *loop)
+{
+    uint16_t cycles = 0;
+
+    for (uint8_t i = 0; i < loop->instructions; i++)
+    {
+        cycles += GB_TickCpu(ctx);
+    }
+
+    // Compared as registers (GB_IdleLoopRun)
+    GB_FlagsSync(ctx);
+
+    return ctx->registers.PC == loop->start && cycles == loop->cycles;
+}
+
+uint8_t GB_IdleLoopRun(EmulationState *ctx, const uint16_t budget, uint16_t *cycles)
+{
+    GB_IdleLoopCache *cache = ctx->idleLoops;
+
+    if (cache == NULL)
+    {
+        return 0;
+    }
+
+    const uint16_t pc = ctx->registers.PC;
+    const uint16_t previousPC = cache->previousPC;
+    cache->previousPC = pc;
+
+    // Loop heads are only looked up after a short backward branch (or a step that started on the head itself)
+    if (pc > previousPC || previousPC - pc >= GB_IDLE_LOOP_MAX_LENGHT)
+    {
+        return 0;
+    }
+
+    GB_IdleLoop *loop = &cache->loops[pc % GB_IDLE_LOOP_CACHE_LENGHT];
+
+    if (loop->state == GB_IDLE_LOOP_UNKNOWN || loop->start != pc)
+    {
+        GB_IdleLoopDecode(ctx, loop, pc);
+    }
+
+    if (loop->state != GB_IDLE_LOOP_ACCEPTED)
+    {
+        return 0;
+    }
+
+    // A pending interrupt has to be serviced first
+    if (ctx->ime && ctx->interruptPending)
+    {
+        return 0;
+    }
+
+    // The polled register keeps its value until the next scheduler event (budget) or its next DIV/TIMA increment
+    uint64_t wake = ctx->cpuCycles + budget;
+    const uint64_t change = GB_Timer_NextChange(ctx, loop->polledAddress);
+
+    if (change < wake)
+    {
+        wake = change;
+    }
+
+    const uint64_t iterations = (wake - ctx->cpuCycles) / loop->cycles;
+
+    if (iterations < GB_IDLE_LOOP_MIN_ITERATIONS)
+    {
+        return 0;
+    }
+
+    if (!GB_IdleLoopCodeMatches(ctx, loop))
+    {
+        loop->state = GB_IDLE_LOOP_UNKNOWN;
+        return 0;
+    }
+
+    // Both iterations read the same value, when they leave the same registers behind the loop can't exit before wake
+    const GB_Registers entryRegisters = ctx->registers;
+    const GB_LazyFlags entryFlags = ctx->flags;
+    const uint64_t entryInstructions = ctx->instructions;
+    GB_Registers firstIteration;
+
+    uint8_t idle = GB_IdleLoopIterate(ctx, loop);
+    firstIteration = ctx->registers;
+    idle = idle && GB_IdleLoopIterate(ctx, loop) && memcmp(&firstIteration, &ctx->registers, sizeof(GB_Registers)) == 0;
+
+    if (!idle)
+    {
+        // Reads of the polled registers have no side effects, going back is enough
+        ctx->registers = entryRegisters;
+        ctx->flags = entryFlags;
+        ctx->instructions = entryInstructions;
+        return 0;
+    }
+
+    const uint16_t skippedCycles = (uint16_t)(iterations * loop->cycles);
+
+    ctx->instructions += (iterations - GB_IDLE_LOOP_MIN_ITERATIONS) * loop->instructions;
+    loop->skips++;
+    loop->skippedCycles += skippedCycles;
+    cache->skippedCycles += skippedCycles;
+
+    GB_Trace(CPU, "[IDLE LOOP] PC:[0x%04X] SKIPPED %u CYCLES\n", pc, skippedCycles);
+
+    *cycles = skippedCycles;
+    return 1;
+}
+
+void GB_IdleLoopPrintReport(const GB_IdleLoopCache *cache)
+{
+    MNE_Log("[IDLE LOOP] SKIPPED CYCLES: %llu\n", (unsigned long long)cache->skippedCycles);
+
+    for (uint16_t i = 0; i < GB_IDLE_LOOP_CACHE_LENGHT; i++)
+    {
+        const GB_IdleLoop *loop = &cache->loops[i];
+
+        if (loop->state != GB_IDLE_LOOP_ACCEPTED)
+        {
+            continue;
+        }
+
+        MNE_Log("[IDLE LOOP] 0x%04X - 0x%04X POLLS: 0x%04X ITERATION: %u CYCLES %u INSTRUCTIONS SKIPS: %llu SKIPPED: %llu CYCLES\n",
+                loop->start, loop->end, loop->polledAddress, loop->cycles, loop->instructions,
+                (unsigned long long)loop->skips, (unsigned long long)loop->skippedCycles);
+    }
+}
@@ -0,0 +1,571 @@
+#include <Emulation/GB_Jit.h>
+
+#ifdef GB_JIT
+
+#if !defined(__x86_64__) || !defined(__unix__)
+#error "MINEMU GameBoy JIT needs an x86-64 POSIX host"
+#endif
+
+#include <Emulation/GB_Emulation.h>
+
+#include <minemu/MNE_Memory.h>
+#include <Emulation/GB_Log.h>
+
+#include <stddef.h>
+#include <string.h>
+#include <sys/mman.h>
+
+// Worst case code size of one block (prologue + GB_BLOCK_MAX_INSTRUCTIONS handler calls with generation/interrupt checks + exit stubs + epilogue)
+#define GB_JIT_MAX_BLOCK_CODE 2048
+
+// Bytes of one lockstep memory snapshot (bank 00, vram, wram, oam, hram)
+#define GB_JIT_SNAPSHOT_SIZE (GB_ROM_SIZE + GB_VRAM_SIZE + GB_WRAM_SIZE + GB_OAM_SIZE + GB_HRAM_SIZE)
+
+// Native blocks return the consumed cycles on the low 32 bits and the executed instructions on the high 32 bits
+typedef uint64_t (*GB_JitNativeFnPtr)(EmulationState *ctx);
+
+typedef struct
+{
+    uint32_t tag;        // block cache tag and generation the entry was built for
+    uint32_t generation;
+    uint32_t epoch;      // arena epoch (native code is gone after a flush)
+    uint16_t executions;
+    uint8_t  rejected;
+    GB_JitNativeFnPtr native;
+} GB_JitBlock;
+
+struct GB_Jit
+{
+    uint8_t    *arena;
+    uint32_t    arenaUsed;
+    uint32_t    epoch;
+    uint8_t     lockstep;
+    uint8_t    *lockstepMemory; // Two snapshots (before and interpreted), allocated by GB_JitSetLockstep
+    GB_JitStats stats;
+    GB_JitBlock blocks[GB_BLOCK_CACHE_LENGHT]; // Same index as GB_BlockCache.blocks
+};
+
+// ---------------------------- x86-64 emitter (rbx = ctx, r12d = cycles, r13 = &blockCache->generation)
+
+#define GB_JIT_REG_OFFSET(field) (int32_t)(offsetof(EmulationState, registers) + offsetof(GB_Registers, field))
+
+typedef struct
+{
+    uint8_t *code;
+    uint32_t size;
+} GB_JitEmitter;
+
+static void GB_JitEmit8(GB_JitEmitter *e, const uint8_t value)
+{
+    e->code[e->size++] = value;
+}
+
+static void GB_JitEmit16(GB_JitEmitter *e, const uint16_t value)
+{
+    memcpy(e->code + e->size, &value, sizeof(value));
+    e->size += sizeof(value);
+}
+
+static void GB_JitEmit32(GB_JitEmitter *e, const uint32_t value)
+{
+    memcpy(e->code + e->size, &value, sizeof(value));
+    e->size += sizeof(value);
+}
+
+static void GB_JitEmit64(GB_JitEmitter *e, const uint64_t value)
+{
+    memcpy(e->code + e->size, &value, sizeof(value));
+    e->size += sizeof(value);
+}
+
+static void GB_JitPatchRel32(GB_JitEmitter *e, const uint32_t at, const uint32_t target)
+{
+    const int32_t rel = (int32_t)target - (int32_t)(at + 4);
+    memcpy(e->code + at, &rel, sizeof(rel));
+}
+
+// Register file offset of an r8 operand (B,C,D,E,H,L,-,A encoding, A skips F same as GB_GetReg8)
+static int32_t GB_JitReg8Offset(const uint8_t r)
+{
+    return GB_JIT_REG_OFFSET(FILE_8) + (r == GB_A_OFFSET ? r - 1 : r);
+}
+
+// BC, DE, HL, SP
+static int32_t GB_JitReg16Offset(const uint8_t rr)
+{
+    return rr == 3 ? GB_JIT_REG_OFFSET(SP) : GB_JIT_REG_OFFSET(FILE_16) + rr * 2;
+}
+
+static void GB_JitStoreImm16(GB_JitEmitter *e, const int32_t offset, const uint16_t value)
+{
+    // mov word [rbx + offset], imm16
+    GB_JitEmit8(e, 0x66); GB_JitEmit8(e, 0xC7); GB_JitEmit8(e, 0x83);
+    GB_JitEmit32(e, offset);
+    GB_JitEmit16(e, value);
+}
+
+static void GB_JitAddCycles(GB_JitEmitter *e, const uint32_t cycles)
+{
+    if (cycles == 0)
+    {
+        return;
+    }
+
+    // add r12d, imm32
+    GB_JitEmit8(e, 0x41); GB_JitEmit8(e, 0x81); GB_JitEmit8(e, 0xC4);
+    GB_JitEmit32(e, cycles);
+}
+
+// ---------------------------- Translation
+
+static uint8_t GB_JitIsNative(const uint8_t opcode)
+{
+    // LD r,r' (no (HL) operands, 0x76 is HALT)
+    if ((opcode & 0xC0) == 0x40)
+    {
+        return (opcode & 0x07) != GB_HL_INDIRECT_OFFSET && ((opcode >> 3) & 0x07) != GB_HL_INDIRECT_OFFSET;
+    }
+
+    // LD r,n (not LD (HL),n)
+    if ((opcode & 0xC7) == 0x06)
+    {
+        return ((opcode >> 3) & 0x07) != GB_HL_INDIRECT_OFFSET;
+    }
+
+    // LD rr,nn INC rr DEC rr
+    return (opcode & 0xCF) == 0x01 || (opcode & 0xCF) == 0x03 || (opcode & 0xCF) == 0x0B;
+}
+
+static uint8_t GB_JitIsIO(const uint8_t opcode)
+{
+    return opcode == 0xE0 || opcode == 0xF0 || opcode == 0xE2 || opcode == 0xF2;
+}
+
+// Fused entries (superinstructions) are always handler calls, any IO opcode in the sequence keeps the block interpreted
+static uint8_t GB_JitEntryIsIO(const GB_BlockInstruction *instruction)
+{
+    const GB_Fusion *fusion = GB_FusionGet(instruction->fusion);
+
+    if (instruction->fusion == GB_FUSION_NONE)
+    {
+        return GB_JitIsIO(instruction->opcode);
+    }
+
+    for (uint8_t i = 0; i < fusion->lenght; i++)
+    {
+        if (GB_JitIsIO(fusion->opcodes[i]))
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static uint8_t GB_JitEntryIsNative(const GB_BlockInstruction *instruction)
+{
+    return instruction->fusion == GB_FUSION_NONE && GB_JitIsNative(instruction->opcode);
+}
+
+static void GB_JitEmitNative(GB_JitEmitter *e, EmulationState *ctx, const uint8_t opcode, const uint16_t address)
+{
+    if ((opcode & 0xC0) == 0x40)
+    {
+        // movzx eax, byte [rbx + src]; mov byte [rbx + dst], al
+        GB_JitEmit8(e, 0x0F); GB_JitEmit8(e, 0xB6); GB_JitEmit8(e, 0x83);
+        GB_JitEmit32(e, GB_JitReg8Offset(opcode & 0x07));
+        GB_JitEmit8(e, 0x88); GB_JitEmit8(e, 0x83);
+        GB_JitEmit32(e, GB_JitReg8Offset((opcode >> 3) & 0x07));
+    }
+    else if ((opcode & 0xC7) == 0x06)
+    {
+        // mov byte [rbx + r], n (immediate resolved now, rom writes invalidate the block)
+        GB_JitEmit8(e, 0xC6); GB_JitEmit8(e, 0x83);
+        GB_JitEmit32(e, GB_JitReg8Offset((opcode >> 3) & 0x07));
+        GB_JitEmit8(e, GB_BusRead(ctx, address + 1));
+    }
+    else if ((opcode & 0xCF) == 0x01)
+    {
+        const uint16_t nn = (uint16_t)(GB_BusRead(ctx, address + 1) | (GB_BusRead(ctx, address + 2) << 8));
+        GB_JitStoreImm16(e, GB_JitReg16Offset((opcode >> 4) & 0x03), nn);
+    }
+    else
+    {
+        // inc/dec word [rbx + rr]
+        GB_JitEmit8(e, 0x66); GB_JitEmit8(e, 0xFF); GB_JitEmit8(e, (opcode & 0xCF) == 0x03 ? 0x83 : 0x8B);
+        GB_JitEmit32(e, GB_JitReg16Offset((opcode >> 4) & 0x03));
+    }
+
+    GB_JitStoreImm16(e, GB_JIT_REG_OFFSET(INSTRUCTION), opcode);
+}
+
+static void GB_JitEmitHandlerCall(GB_JitEmitter *e, const GB_BlockInstruction *instruction, const uint16_t address)
+{
+    // Same as GB_BlockCacheExecute: PC past the opcode, INSTRUCTION set, handler(ctx)
+    GB_JitStoreImm16(e, GB_JIT_REG_OFFSET(PC), address + 1);
+    GB_JitStoreImm16(e, GB_JIT_REG_OFFSET(INSTRUCTION), instruction->opcode);
+
+    // mov rdi, rbx; mov rax, handler; call rax; movzx eax, al; add r12d, eax
+    GB_JitEmit8(e, 0x48); GB_JitEmit8(e, 0x89); GB_JitEmit8(e, 0xDF);
+    GB_JitEmit8(e, 0x48); GB_JitEmit8(e, 0xB8);
+    GB_JitEmit64(e, (uint64_t)(uintptr_t)instruction->handler);
+    GB_JitEmit8(e, 0xFF); GB_JitEmit8(e, 0xD0);
+    GB_JitEmit8(e, 0x0F); GB_JitEmit8(e, 0xB6); GB_JitEmit8(e, 0xC0);
+    GB_JitEmit8(e, 0x41); GB_JitEmit8(e, 0x01); GB_JitEmit8(e, 0xC4);
+}
+
+static uint8_t GB_JitArenaWritable(GB_Jit *jit, const uint8_t writable)
+{
+    return mprotect(jit->arena, GB_JIT_ARENA_SIZE, writable ? PROT_READ | PROT_WRITE : PROT_READ | PROT_EXEC) == 0;
+}
+
+static GB_JitNativeFnPtr GB_JitCompile(GB_Jit *jit, EmulationState *ctx, const GB_Block *block)
+{
+    uint8_t nativeCount = 0;
+
+    for (uint8_t i = 0; i < block->lenght; i++)
+    {
+        if (GB_JitEntryIsIO(&block->instructions[i]))
+        {
+            return NULL;
+        }
+        nativeCount += GB_JitEntryIsNative(&block->instructions[i]);
+    }
+
+    if (nativeCount == 0)
+    {
+        return NULL;
+    }
+
+    if (jit->arenaUsed + GB_JIT_MAX_BLOCK_CODE > GB_JIT_ARENA_SIZE)
+    {
+        jit->arenaUsed = 0;
+        jit->epoch++;
+        jit->stats.arenaFlushes++;
+    }
+
+    if (!GB_JitArenaWritable(jit, 1))
+    {
+        return NULL;
+    }
+
+    GB_JitEmitter e = {jit->arena + jit->arenaUsed, 0};
+    uint32_t exitJumps[GB_BLOCK_MAX_INSTRUCTIONS * 2]; // generation and interrupt checks
+    uint8_t  exitCounts[GB_BLOCK_MAX_INSTRUCTIONS * 2];
+    uint8_t  exitCount = 0;
+    uint32_t pendingCycles = 0;
+    uint32_t executed = 0; // instructions (fused entries count as every instruction they cover)
+    uint16_t address = (uint16_t)(block->tag & 0xFFFF);
+
+    // push rbx; push r12; push r13; mov rbx, rdi; xor r12d, r12d; mov r13, &generation
+    GB_JitEmit8(&e, 0x53);
+    GB_JitEmit8(&e, 0x41); GB_JitEmit8(&e, 0x54);
+    GB_JitEmit8(&e, 0x41); GB_JitEmit8(&e, 0x55);
+    GB_JitEmit8(&e, 0x48); GB_JitEmit8(&e, 0x89); GB_JitEmit8(&e, 0xFB);
+    GB_JitEmit8(&e, 0x45); GB_JitEmit8(&e, 0x31); GB_JitEmit8(&e, 0xE4);
+    GB_JitEmit8(&e, 0x49); GB_JitEmit8(&e, 0xBD);
+    GB_JitEmit64(&e, (uint64_t)(uintptr_t)&ctx->blockCache->generation);
+
+    for (uint8_t i = 0; i < block->lenght; i++)
+    {
+        const GB_BlockInstruction *instruction = &block->instructions[i];
+        const uint8_t last = i == block->lenght - 1;
+
+        executed += instruction->count;
+
+        if (GB_JitEntryIsNative(instruction))
+        {
+            GB_JitEmitNative(&e, ctx, instruction->opcode, address);
+            pendingCycles += gb_opcodes_cycles[instruction->opcode];
+            address += instruction->lenght;
+
+            if (last)
+            {
+                GB_JitStoreImm16(&e, GB_JIT_REG_OFFSET(PC), address);
+            }
+            continue;
+        }
+
+        GB_JitAddCycles(&e, pendingCycles);
+        pendingCycles = 0;
+
+        GB_JitEmitHandlerCall(&e, instruction, address);
+        address += instruction->lenght;
+
+        if (!last)
+        {
+            // cmp dword [r13], generation; jne exit stub (rom written, rest of the block might be stale)
+            GB_JitEmit8(&e, 0x41); GB_JitEmit8(&e, 0x81); GB_JitEmit8(&e, 0x7D); GB_JitEmit8(&e, 0x00);
+            GB_JitEmit32(&e, ctx->blockCache->generation);
+            GB_JitEmit8(&e, 0x0F); GB_JitEmit8(&e, 0x85);
+            exitJumps[exitCount] = e.size;
+            exitCounts[exitCount++] = executed;
+            GB_JitEmit32(&e, 0);
+
+            // movzx eax, byte [rbx + ime]; and al, byte [rbx + interruptPending]; jnz exit stub (same as GB_BlockCacheExecute)
+            GB_JitEmit8(&e, 0x0F); GB_JitEmit8(&e, 0xB6); GB_JitEmit8(&e, 0x83);
+            GB_JitEmit32(&e, (uint32_t)offsetof(EmulationState, ime));
+            GB_JitEmit8(&e, 0x22); GB_JitEmit8(&e, 0x83);
+            GB_JitEmit32(&e, (uint32_t)offsetof(EmulationState, interruptPending));
+            GB_JitEmit8(&e, 0x0F); GB_JitEmit8(&e, 0x85);
+            exitJumps[exitCount] = e.size;
+            exitCounts[exitCount++] = executed;
+            GB_JitEmit32(&e, 0);
+        }
+    }
+
+    GB_JitAddCycles(&e, pendingCycles);
+
+    // mov edx, instructions
+    GB_JitEmit8(&e, 0xBA);
+    GB_JitEmit32(&e, executed);
+
+    // mov eax, r12d; shl rdx, 32; or rax, rdx; pop r13; pop r12; pop rbx; ret
+    const uint32_t epilogue = e.size;
+    GB_JitEmit8(&e, 0x44); GB_JitEmit8(&e, 0x89); GB_JitEmit8(&e, 0xE0);
+    GB_JitEmit8(&e, 0x48); GB_JitEmit8(&e, 0xC1); GB_JitEmit8(&e, 0xE2); GB_JitEmit8(&e, 0x20);
+    GB_JitEmit8(&e, 0x48); GB_JitEmit8(&e, 0x09); GB_JitEmit8(&e, 0xD0);
+    GB_JitEmit8(&e, 0x41); GB_JitEmit8(&e, 0x5D);
+    GB_JitEmit8(&e, 0x41); GB_JitEmit8(&e, 0x5C);
+    GB_JitEmit8(&e, 0x5B);
+    GB_JitEmit8(&e, 0xC3);
+
+    // Exit stubs: mov edx, executed instructions; jmp epilogue
+    for (uint8_t i = 0; i < exitCount; i++)
+    {
+        GB_JitPatchRel32(&e, exitJumps[i], e.size);
+        GB_JitEmit8(&e, 0xBA);
+        GB_JitEmit32(&e, exitCounts[i]);
+        GB_JitEmit8(&e, 0xE9);
+        GB_JitEmit32(&e, 0);
+        GB_JitPatchRel32(&e, e.size - 4, epilogue);
+    }
+
+    GB_JitArenaWritable(jit, 0);
+
+    GB_JitNativeFnPtr native = (GB_JitNativeFnPtr)(void *)(jit->arena + jit->arenaUsed);
+    jit->arenaUsed += (e.size + 15) & ~15u;
+
+    jit->stats.compiled++;
+    jit->stats.nativeInstructions += nativeCount;
+    jit->stats.calledInstructions += executed - nativeCount;
+
+    return native;
+}
+
+// ---------------------------- Lockstep (interpreter vs native on the same starting state)
+
+typedef struct
+{
+    uint8_t *bank_00;
+    uint8_t *vram;
+    uint8_t *wram;
+    uint8_t *oam;
+    uint8_t *hram;
+} GB_JitMemorySnapshot;
+
+static GB_JitMemorySnapshot GB_JitSnapshotAt(uint8_t *memory)
+{
+    GB_JitMemorySnapshot snapshot;
+
+    snapshot.bank_00 = memory;
+    snapshot.vram = snapshot.bank_00 + GB_ROM_SIZE;
+    snapshot.wram = snapshot.vram + GB_VRAM_SIZE;
+    snapshot.oam = snapshot.wram + GB_WRAM_SIZE;
+    snapshot.hram = snapshot.oam + GB_OAM_SIZE;
+
+    return snapshot;
+}
+
+static void GB_JitSnapshotMemory(const EmulationState *ctx, GB_JitMemorySnapshot *snapshot, const uint8_t save)
+{
+    if (save)
+    {
+        memcpy(snapshot->bank_00, ctx->bank_00, GB_ROM_SIZE);
+        memcpy(snapshot->vram, ctx->vram, GB_VRAM_SIZE);
+        memcpy(snapshot->wram, ctx->wram, GB_WRAM_SIZE);
+        memcpy(snapshot->oam, ctx->oam, GB_OAM_SIZE);
+        memcpy(snapshot->hram, ctx->hram, GB_HRAM_SIZE);
+    }
+    else
+    {
+        memcpy(ctx->bank_00, snapshot->bank_00, GB_ROM_SIZE);
+        memcpy(ctx->vram, snapshot->vram, GB_VRAM_SIZE);
+        memcpy(ctx->wram, snapshot->wram, GB_WRAM_SIZE);
+        memcpy(ctx->oam, snapshot->oam, GB_OAM_SIZE);
+        memcpy(ctx->hram, snapshot->hram, GB_HRAM_SIZE);
+    }
+}
+
+static uint8_t GB_JitMemoryEquals(const EmulationState *ctx, const GB_JitMemorySnapshot *snapshot)
+{
+    return memcmp(ctx->bank_00, snapshot->bank_00, GB_ROM_SIZE) == 0 &&
+           memcmp(ctx->vram, snapshot->vram, GB_VRAM_SIZE) == 0 &&
+           memcmp(ctx->wram, snapshot->wram, GB_WRAM_SIZE) == 0 &&
+           memcmp(ctx->oam, snapshot->oam, GB_OAM_SIZE) == 0 &&
+           memcmp(ctx->hram, snapshot->hram, GB_HRAM_SIZE) == 0;
+}
+
+static uint16_t GB_JitRunLockstep(GB_Jit *jit, EmulationState *ctx, const GB_Block *block, GB_JitNativeFnPtr native)
+{
+    GB_JitMemorySnapshot before = GB_JitSnapshotAt(jit->lockstepMemory);
+    GB_JitMemorySnapshot interpreted = GB_JitSnapshotAt(jit->lockstepMemory + GB_JIT_SNAPSHOT_SIZE);
+
+    const EmulationState initialState = *ctx;
+    const uint32_t initialGeneration = ctx->blockCache->generation;
+    GB_JitSnapshotMemory(ctx, &before, 1);
+
+    // Reference
+    const uint16_t interpretedCycles = GB_BlockCacheExecute(ctx, block);
+    const EmulationState interpretedState = *ctx;
+    const uint32_t interpretedGeneration = ctx->blockCache->generation;
+    GB_JitSnapshotMemory(ctx, &interpreted, 1);
+
+    // Native from the same state
+    *ctx = initialState;
+    ctx->blockCache->generation = initialGeneration;
+    GB_JitSnapshotMemory(ctx, &before, 0);
+
+    const uint64_t result = native(ctx);
+    ctx->instructions += result >> 32;
+
+    jit->stats.lockstepBlocks++;
+
+    if ((uint16_t)result != interpretedCycles ||
+        ctx->instructions != interpretedState.instructions ||
+        memcmp(&ctx->registers, &interpretedState.registers, sizeof(GB_Registers)) != 0 ||
+        !GB_JitMemoryEquals(ctx, &interpreted))
+    {
+        jit->stats.lockstepMismatches++;
+        GB_Log(JIT, ERROR, "[JIT LOCKSTEP] MISMATCH BLOCK PC:[0x%04X] CYCLES:[%u/%u] PC:[0x%04X/0x%04X] A:[0x%02X/0x%02X]\n",
+                block->tag & 0xFFFF, (uint32_t)(uint16_t)result, interpretedCycles,
+                ctx->registers.PC, interpretedState.registers.PC, ctx->registers.A, interpretedState.registers.A);
+
+        // Keep going from the interpreter result
+        *ctx = interpretedState;
+        ctx->blockCache->generation = interpretedGeneration;
+        GB_JitSnapshotMemory(ctx, &interpreted, 0);
+    }
+
+    return interpretedCycles;
+}
+
+// ---------------------------- API
+
+GB_Jit *GB_JitCreate()
+{
+    GB_Jit *jit = NULL;
+    MNE_New(jit, 1, GB_Jit);
+
+    jit->arena = mmap(NULL, GB_JIT_ARENA_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (jit->arena == MAP_FAILED)
+    {
+        GB_Log(JIT, ERROR, "[JIT] CANNOT MAP THE CODE ARENA\n");
+        MNE_Delete(jit);
+        return NULL;
+    }
+
+    return jit;
+}
+
+void GB_JitDestroy(GB_Jit *jit)
+{
+    if (jit == NULL)
+    {
+        return;
+    }
+
+    munmap(jit->arena, GB_JIT_ARENA_SIZE);
+    MNE_Delete(jit->lockstepMemory);
+    MNE_Delete(jit);
+}
+
+void GB_JitSetLockstep(GB_Jit *jit, const uint8_t enabled)
+{
+    if (enabled && jit->lockstepMemory == NULL)
+    {
+        MNE_New(jit->lockstepMemory, GB_JIT_SNAPSHOT_SIZE * 2, uint8_t);
+    }
+
+    jit->lockstep = enabled && jit->lockstepMemory != NULL;
+}
+
+const GB_JitStats *GB_JitGetStats(const GB_Jit *jit)
+{
+    return &jit->stats;
+}
+
+uint8_t GB_JitRun(EmulationState *ctx, const uint16_t budget, uint16_t *cycles)
+{
+    GB_Jit *jit = ctx->jit;
+    const GB_Block *block = GB_BlockCacheLookup(ctx, budget);
+
+    if (block == NULL)
+    {
+        return 0;
+    }
+
+    GB_JitBlock *entry = &jit->blocks[block - ctx->blockCache->blocks];
+
+    // Block decoded again (other PC/bank or invalidated cache)
+    if (entry->tag != block->tag || entry->generation != block->generation)
+    {
+        memset(entry, 0, sizeof(GB_JitBlock));
+        entry->tag = block->tag;
+        entry->generation = block->generation;
+    }
+
+    if (entry->native != NULL && entry->epoch != jit->epoch)
+    {
+        entry->native = NULL;
+    }
+
+    if (entry->native == NULL && !entry->rejected && ++entry->executions >= GB_JIT_HOT_THRESHOLD)
+    {
+        entry->native = GB_JitCompile(jit, ctx, block);
+        entry->epoch = jit->epoch;
+        entry->rejected = entry->native == NULL;
+        jit->stats.rejected += entry->rejected;
+    }
+
+    if (entry->native == NULL)
+    {
+        *cycles = GB_BlockCacheExecute(ctx, block);
+        jit->stats.interpretedRuns++;
+        return 1;
+    }
+
+    jit->stats.nativeRuns++;
+
+    if (jit->lockstep)
+    {
+        *cycles = GB_JitRunLockstep(jit, ctx, block, entry->native);
+        return 1;
+    }
+
+    const uint64_t result = entry->native(ctx);
+    ctx->instructions += result >> 32;
+    *cycles = (uint16_t)result;
+
+    return 1;
+}
+
+void GB_JitPrintStats(const GB_Jit *jit)
+{
+    const GB_JitStats *stats = &jit->stats;
+
+    MNE_Log("[JIT] COMPILED: %llu REJECTED: %llu ARENA: %u/%u BYTES FLUSHES: %llu\n",
+            (unsigned long long)stats->compiled, (unsigned long long)stats->rejected,
+            jit->arenaUsed, GB_JIT_ARENA_SIZE, (unsigned long long)stats->arenaFlushes);
+    MNE_Log("[JIT] NATIVE RUNS: %llu INTERPRETED RUNS: %llu NATIVE/CALLED INSTRUCTIONS: %llu/%llu\n",
+            (unsigned long long)stats->nativeRuns, (unsigned long long)stats->interpretedRuns,
+            (unsigned long long)stats->nativeInstructions, (unsigned long long)stats->calledInstructions);
+
+    if (jit->lockstep)
+    {
+        MNE_Log("[JIT] LOCKSTEP BLOCKS: %llu MISMATCHES: %llu\n",
+                (unsigned long long)stats->lockstepBlocks, (unsigned long long)stats->lockstepMismatches);
+    }
+}
+
+#endif
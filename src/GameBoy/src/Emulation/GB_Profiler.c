@@ -0,0 +1,320 @@
+#include <Emulation/GB_Profiler.h>
+#include <Emulation/GB_Emulation.h>
+
+#include <minemu/MNE_Memory.h>
+#include <minemu/MNE_Log.h>
+
+#include <stdio.h>
+#include <time.h>
+
+// Opcode and CB opcode rows plus at most one handler per opcode
+#define GB_PROFILER_ROWS_LENGHT (GB_PROFILER_TABLE_LENGHT * 4)
+#define GB_PROFILER_NAME_LENGHT 32
+#define GB_PROFILER_CALIBRATION_LENGHT 1000
+
+typedef struct
+{
+    const char      *kind; // opcode, cb, handler or cb handler
+    uint16_t         code; // opcode (first opcode of the handler)
+    const void      *handler;
+    char             name[GB_PROFILER_NAME_LENGHT];
+    GB_ProfilerEntry entry;
+} GB_ProfilerRow;
+
+// CB handlers are shared by every operand (GB_BuildCBDispatchTable), their names are not on the dispatch table
+static const struct
+{
+    cbInstructionFnPtrGb handler;
+    const char          *name;
+} s_gb_profiler_cb_handlers[] =
+{
+    {GB_RLC_R, "GB_RLC_R"},
+    {GB_RRC_R, "GB_RRC_R"},
+    {GB_RL_R, "GB_RL_R"},
+    {GB_RR_R, "GB_RR_R"},
+    {GB_SLA_R, "GB_SLA_R"},
+    {GB_SRA_R, "GB_SRA_R"},
+    {GB_SWAP_R, "GB_SWAP_R"},
+    {GB_SRL_R, "GB_SRL_R"},
+    {GB_CB_BIT_N_R, "GB_CB_BIT_N_R"},
+    {GB_CB_RES_N_R, "GB_CB_RES_N_R"},
+    {GB_CB_SET_N_R, "GB_CB_SET_N_R"},
+};
+
+static uint64_t GB_ProfilerNow()
+{
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+GB_Profiler *GB_ProfilerCreate()
+{
+    GB_Profiler *profiler = NULL;
+    MNE_New(profiler, 1, GB_Profiler);
+
+    // Cheapest back to back read, it is paid once per timed instruction
+    profiler->clockOverhead = UINT64_MAX;
+
+    for (uint16_t i = 0; i < GB_PROFILER_CALIBRATION_LENGHT; i++)
+    {
+        const uint64_t start = GB_ProfilerNow();
+        const uint64_t elapsed = GB_ProfilerNow() - start;
+
+        if (elapsed < profiler->clockOverhead)
+        {
+            profiler->clockOverhead = elapsed;
+        }
+    }
+
+    GB_ProfilerSetCsvPath(profiler, GB_PROFILER_DEFAULT_CSV_PATH);
+    return profiler;
+}
+
+void GB_ProfilerDestroy(GB_Profiler *profiler)
+{
+    MNE_Delete(profiler);
+}
+
+void GB_ProfilerSetCsvPath(GB_Profiler *profiler, const char *path)
+{
+    snprintf(profiler->csvPath, sizeof(profiler->csvPath), "%s", path);
+}
+
+uint8_t GB_ProfilerStep(EmulationState *ctx)
+{
+    GB_Profiler *profiler = ctx->profiler;
+
+    // Peeked before the fetch, GB_TickCpu moves PC
+    const uint16_t pc = ctx->registers.PC;
+    const uint8_t opcode = GB_BusRead(ctx, pc);
+    GB_ProfilerEntry *entry = opcode == 0xCB ? &profiler->cbOpcodes[GB_BusRead(ctx, pc + 1)] : &profiler->opcodes[opcode];
+
+    const uint64_t start = GB_ProfilerNow();
+    const uint8_t cycles = GB_TickCpu(ctx);
+    const uint64_t elapsed = GB_ProfilerNow() - start;
+
+    entry->executions++;
+    entry->cycles += cycles;
+    entry->nanoseconds += elapsed > profiler->clockOverhead ? elapsed - profiler->clockOverhead : 0;
+
+    return cycles;
+}
+
+static void GB_ProfilerAccumulate(GB_ProfilerEntry *total, const GB_ProfilerEntry *entry)
+{
+    total->executions += entry->executions;
+    total->cycles += entry->cycles;
+    total->nanoseconds += entry->nanoseconds;
+}
+
+// Function name of an unprefixed handler (mnemonic of its first opcode without the debug names)
+static void GB_ProfilerHandlerName(char *name, const uint8_t opcode)
+{
+#ifdef GB_DEBUG
+    // "GB_HANDLER [MASK:...] [CODE:...]"
+    const char *handlerName = GB_DecodeInstruction(opcode)->handlerName;
+
+    if (handlerName != NULL)
+    {
+        snprintf(name, GB_PROFILER_NAME_LENGHT, "%.*s", (int)strcspn(handlerName, " "), handlerName);
+        return;
+    }
+#endif
+    snprintf(name, GB_PROFILER_NAME_LENGHT, "%s", gb_opcodes_names[opcode]);
+}
+
+static void GB_ProfilerCBHandlerName(char *name, const cbInstructionFnPtrGb handler)
+{
+    for (size_t i = 0; i < sizeof(s_gb_profiler_cb_handlers) / sizeof(s_gb_profiler_cb_handlers[0]); i++)
+    {
+        if (s_gb_profiler_cb_handlers[i].handler == handler)
+        {
+            snprintf(name, GB_PROFILER_NAME_LENGHT, "%s", s_gb_profiler_cb_handlers[i].name);
+            return;
+        }
+    }
+
+    snprintf(name, GB_PROFILER_NAME_LENGHT, "CB HANDLER");
+}
+
+// Row of handler (created on its first opcode)
+static GB_ProfilerRow *GB_ProfilerHandlerRow(GB_ProfilerRow *rows, uint16_t *count, const void *handler, const char *kind, const uint8_t code)
+{
+    for (uint16_t i = 0; i < *count; i++)
+    {
+        if (rows[i].handler == handler && strcmp(rows[i].kind, kind) == 0)
+        {
+            return &rows[i];
+        }
+    }
+
+    GB_ProfilerRow *row = &rows[(*count)++];
+    row->kind = kind;
+    row->code = code;
+    row->handler = handler;
+    return row;
+}
+
+static int GB_ProfilerCompareRows(const void *a, const void *b)
+{
+    const GB_ProfilerRow *rowA = (const GB_ProfilerRow *) a;
+    const GB_ProfilerRow *rowB = (const GB_ProfilerRow *) b;
+
+    if (rowA->entry.nanoseconds != rowB->entry.nanoseconds)
+    {
+        return rowA->entry.nanoseconds > rowB->entry.nanoseconds ? -1 : 1;
+    }
+
+    if (rowA->entry.executions != rowB->entry.executions)
+    {
+        return rowA->entry.executions > rowB->entry.executions ? -1 : 1;
+    }
+
+    // Same order on every run
+    const int kind = strcmp(rowA->kind, rowB->kind);
+    return kind != 0 ? kind : (int)rowA->code - (int)rowB->code;
+}
+
+// Executed opcode rows (instructions) followed by the handler rows, each group sorted by host time
+static GB_ProfilerRow *GB_ProfilerBuildRows(const GB_Profiler *profiler, uint16_t *instructionRows, uint16_t *handlerRows)
+{
+    GB_ProfilerRow *rows = NULL;
+    MNE_New(rows, GB_PROFILER_ROWS_LENGHT, GB_ProfilerRow);
+
+    uint16_t count = 0;
+
+    for (uint16_t opcode = 0; opcode < GB_PROFILER_TABLE_LENGHT; opcode++)
+    {
+        if (profiler->opcodes[opcode].executions != 0)
+        {
+            GB_ProfilerRow *row = &rows[count++];
+            row->kind = "opcode";
+            row->code = opcode;
+            row->entry = profiler->opcodes[opcode];
+            snprintf(row->name, GB_PROFILER_NAME_LENGHT, "%s", gb_opcodes_names[opcode]);
+        }
+
+        if (profiler->cbOpcodes[opcode].executions != 0)
+        {
+            GB_ProfilerRow *row = &rows[count++];
+            row->kind = "cb";
+            row->code = opcode;
+            row->entry = profiler->cbOpcodes[opcode];
+            snprintf(row->name, GB_PROFILER_NAME_LENGHT, "%s", gb_cb_opcodes_names[opcode]);
+        }
+    }
+
+    *instructionRows = count;
+    GB_ProfilerRow *handlers = &rows[count];
+    uint16_t handlerCount = 0;
+
+    for (uint16_t opcode = 0; opcode < GB_PROFILER_TABLE_LENGHT; opcode++)
+    {
+        if (profiler->opcodes[opcode].executions != 0)
+        {
+            const GameBoyInstruction *instruction = GB_DecodeInstruction(opcode);
+            GB_ProfilerRow *row = GB_ProfilerHandlerRow(handlers, &handlerCount, (const void *) instruction->handler, "handler", opcode);
+
+            if (row->entry.executions == 0)
+            {
+                GB_ProfilerHandlerName(row->name, opcode);
+            }
+            GB_ProfilerAccumulate(&row->entry, &profiler->opcodes[opcode]);
+        }
+
+        if (profiler->cbOpcodes[opcode].executions != 0)
+        {
+            const GameBoyCBInstruction *instruction = GB_DecodeCBInstruction(opcode);
+            GB_ProfilerRow *row = GB_ProfilerHandlerRow(handlers, &handlerCount, (const void *) instruction->handler, "cb handler", opcode);
+
+            if (row->entry.executions == 0)
+            {
+                GB_ProfilerCBHandlerName(row->name, instruction->handler);
+            }
+            GB_ProfilerAccumulate(&row->entry, &profiler->cbOpcodes[opcode]);
+        }
+    }
+
+    *handlerRows = handlerCount;
+
+    qsort(rows, *instructionRows, sizeof(GB_ProfilerRow), GB_ProfilerCompareRows);
+    qsort(handlers, handlerCount, sizeof(GB_ProfilerRow), GB_ProfilerCompareRows);
+    return rows;
+}
+
+static void GB_ProfilerPrintRows(const char *title, const GB_ProfilerRow *rows, const uint16_t count, const uint16_t top, const uint64_t totalNanoseconds)
+{
+    MNE_Log("[PROFILER] %-10s %-4s %-16s %12s %14s %14s %10s %7s\n", title, "CODE", "NAME", "EXECUTIONS", "CYCLES", "HOST NS", "NS/EXEC", "TIME");
+
+    for (uint16_t i = 0; i < count && i < top; i++)
+    {
+        const GB_ProfilerRow *row = &rows[i];
+
+        MNE_Log("[PROFILER] %-10s %02X   %-16s %12llu %14llu %14llu %10.2f %6.2f%%\n", row->kind, row->code, row->name,
+                (unsigned long long)row->entry.executions, (unsigned long long)row->entry.cycles,
+                (unsigned long long)row->entry.nanoseconds, (double)row->entry.nanoseconds / row->entry.executions,
+                totalNanoseconds != 0 ? 100.0 * row->entry.nanoseconds / totalNanoseconds : 0.0);
+    }
+}
+
+void GB_ProfilerPrintReport(const GB_Profiler *profiler, const uint16_t top)
+{
+    GB_ProfilerEntry total = {0};
+
+    for (uint16_t opcode = 0; opcode < GB_PROFILER_TABLE_LENGHT; opcode++)
+    {
+        GB_ProfilerAccumulate(&total, &profiler->opcodes[opcode]);
+        GB_ProfilerAccumulate(&total, &profiler->cbOpcodes[opcode]);
+    }
+
+    MNE_Log("[PROFILER] INSTRUCTIONS: %llu CYCLES: %llu HOST: %.3f ms (CLOCK OVERHEAD: %llu ns)\n",
+            (unsigned long long)total.executions, (unsigned long long)total.cycles, total.nanoseconds / 1e6,
+            (unsigned long long)profiler->clockOverhead);
+
+    if (total.executions == 0)
+    {
+        return;
+    }
+
+    uint16_t instructionRows = 0;
+    uint16_t handlerRows = 0;
+    GB_ProfilerRow *rows = GB_ProfilerBuildRows(profiler, &instructionRows, &handlerRows);
+
+    GB_ProfilerPrintRows("OPCODE", rows, instructionRows, top, total.nanoseconds);
+    GB_ProfilerPrintRows("HANDLER", &rows[instructionRows], handlerRows, top, total.nanoseconds);
+
+    MNE_Delete(rows);
+}
+
+uint8_t GB_ProfilerWriteCsv(const GB_Profiler *profiler, const char *path)
+{
+    FILE *file = fopen(path, "w");
+
+    if (file == NULL)
+    {
+        MNE_Log("[PROFILER] CANNOT WRITE %s\n", path);
+        return 0;
+    }
+
+    uint16_t instructionRows = 0;
+    uint16_t handlerRows = 0;
+    GB_ProfilerRow *rows = GB_ProfilerBuildRows(profiler, &instructionRows, &handlerRows);
+
+    fprintf(file, "kind,code,name,executions,cycles,nanoseconds,ns_per_execution\n");
+
+    for (uint16_t i = 0; i < instructionRows + handlerRows; i++)
+    {
+        const GB_ProfilerRow *row = &rows[i];
+
+        // Mnemonics have commas (LD A,B)
+        fprintf(file, "%s,0x%02X,\"%s\",%llu,%llu,%llu,%.2f\n", row->kind, row->code, row->name,
+                (unsigned long long)row->entry.executions, (unsigned long long)row->entry.cycles,
+                (unsigned long long)row->entry.nanoseconds, (double)row->entry.nanoseconds / row->entry.executions);
+    }
+
+    MNE_Delete(rows);
+    fclose(file);
+    return 1;
+}
@@ -0,0 +1,127 @@
+#include <Emulation/GB_Scheduler.h>
+
+static void GB_SchedulerSwap(GB_Scheduler *scheduler, const uint8_t a, const uint8_t b)
+{
+    const GB_Event event = scheduler->heap[a];
+
+    scheduler->heap[a] = scheduler->heap[b];
+    scheduler->heap[b] = event;
+
+    scheduler->slots[scheduler->heap[a].type] = a;
+    scheduler->slots[scheduler->heap[b].type] = b;
+}
+
+static void GB_SchedulerSiftUp(GB_Scheduler *scheduler, uint8_t index)
+{
+    while (index > 0)
+    {
+        const uint8_t parent = (index - 1) / 2;
+
+        if (scheduler->heap[parent].deadline <= scheduler->heap[index].deadline)
+        {
+            break;
+        }
+
+        GB_SchedulerSwap(scheduler, parent, index);
+        index = parent;
+    }
+}
+
+static void GB_SchedulerSiftDown(GB_Scheduler *scheduler, uint8_t index)
+{
+    for (;;)
+    {
+        const uint8_t left = index * 2 + 1;
+        const uint8_t right = left + 1;
+        uint8_t smallest = index;
+
+        if (left < scheduler->lenght && scheduler->heap[left].deadline < scheduler->heap[smallest].deadline)
+        {
+            smallest = left;
+        }
+
+        if (right < scheduler->lenght && scheduler->heap[right].deadline < scheduler->heap[smallest].deadline)
+        {
+            smallest = right;
+        }
+
+        if (smallest == index)
+        {
+            return;
+        }
+
+        GB_SchedulerSwap(scheduler, index, smallest);
+        index = smallest;
+    }
+}
+
+static void GB_SchedulerRemoveAt(GB_Scheduler *scheduler, const uint8_t index)
+{
+    const uint8_t last = --scheduler->lenght;
+
+    scheduler->slots[scheduler->heap[index].type] = -1;
+
+    if (index == last)
+    {
+        return;
+    }
+
+    scheduler->heap[index] = scheduler->heap[last];
+    scheduler->slots[scheduler->heap[index].type] = index;
+
+    GB_SchedulerSiftDown(scheduler, index);
+    GB_SchedulerSiftUp(scheduler, index);
+}
+
+void GB_SchedulerReset(GB_Scheduler *scheduler)
+{
+    scheduler->lenght = 0;
+
+    for (uint8_t type = 0; type < GB_EVENT_COUNT; type++)
+    {
+        scheduler->slots[type] = -1;
+    }
+}
+
+void GB_SchedulerSchedule(GB_Scheduler *scheduler, const GB_EventType type, const uint64_t deadline)
+{
+    int8_t index = scheduler->slots[type];
+
+    if (index < 0)
+    {
+        index = scheduler->lenght++;
+        scheduler->heap[index].type = type;
+        scheduler->slots[type] = index;
+    }
+
+    scheduler->heap[index].deadline = deadline;
+
+    GB_SchedulerSiftDown(scheduler, index);
+    GB_SchedulerSiftUp(scheduler, scheduler->slots[type]);
+}
+
+void GB_SchedulerCancel(GB_Scheduler *scheduler, const GB_EventType type)
+{
+    if (scheduler->slots[type] >= 0)
+    {
+        GB_SchedulerRemoveAt(scheduler, scheduler->slots[type]);
+    }
+}
+
+uint64_t GB_SchedulerDeadline(const GB_Scheduler *scheduler, const GB_EventType type)
+{
+    return scheduler->slots[type] >= 0 ? scheduler->heap[scheduler->slots[type]].deadline : UINT64_MAX;
+}
+
+uint8_t GB_SchedulerPopDue(GB_Scheduler *scheduler, const uint64_t now, GB_Event *event)
+{
+    if (scheduler->lenght == 0 || scheduler->heap[0].deadline > now)
+    {
+        return 0;
+    }
+
+    *event = scheduler->heap[0];
+    GB_SchedulerRemoveAt(scheduler, 0);
+
+    return 1;
+}
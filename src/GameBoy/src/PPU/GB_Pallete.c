@@ -0,0 +1,16 @@
+#include <PPU/GB_Pallete.h>
+
+void GB_PalleteBuild(GB_PalleteTable *table, const uint8_t value)
+{
+    for (uint8_t color = 0; color < GB_PALLETE_COLORS; color++)
+    {
+        table->shades[color] = (value >> (color * 2)) & 0x03;
+    }
+
+    // Only the low two bits of each nibble are color indices, the rest of the table mirrors them
+    for (uint16_t pair = 0; pair < GB_PALLETE_PAIR_LENGHT; pair++)
+    {
+        table->pairs[pair][0] = table->shades[pair & 0x03];
+        table->pairs[pair][1] = table->shades[(pair >> 4) & 0x03];
+    }
+}
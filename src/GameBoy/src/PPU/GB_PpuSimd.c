@@ -0,0 +1,211 @@
+#include <PPU/GB_PpuSimd.h>
+#include <PPU/GB_PpuTables.h>
+
+#include <pthread.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define GB_PPU_X86_SIMD
+#include <immintrin.h>
+#define GB_PPU_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+static pthread_once_t       s_gb_ppu_kernels_once = PTHREAD_ONCE_INIT;
+static uint8_t              s_gb_ppu_supported[GB_PPU_SIMD_COUNT];
+static const GB_PpuKernels *s_gb_ppu_selected = NULL;
+
+// SCALAR (reference)
+
+static void GB_PpuDecodeRowsScalar(uint8_t *indices, const uint8_t *data, const size_t rows)
+{
+    for (size_t row = 0; row < rows; row++)
+    {
+        GB_DecodeTileRow(&indices[row * GB_TILE_ROW_PIXELS], data[row * 2], data[row * 2 + 1]);
+    }
+}
+
+static void GB_PpuExpandScalar(uint32_t *pixels, const uint8_t *indices, const uint32_t *palette, const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        pixels[i] = palette[indices[i]];
+    }
+}
+
+#ifdef GB_PPU_X86_SIMD
+
+// SSE2
+
+// Two rows of indices from [low0 x8, low1 x8] and [high0 x8, high1 x8] (a set bit leaves a non zero byte, min makes it 1)
+GB_PPU_TARGET("sse2") static inline __m128i GB_PpuMergePlanesSSE2(const __m128i low, const __m128i high)
+{
+    const __m128i bits = _mm_set_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i highBits = _mm_min_epu8(_mm_and_si128(high, bits), one);
+
+    return _mm_add_epi8(_mm_min_epu8(_mm_and_si128(low, bits), one), _mm_add_epi8(highBits, highBits));
+}
+
+GB_PPU_TARGET("sse2") static void GB_PpuDecodeRowsSSE2(uint8_t *indices, const uint8_t *data, const size_t rows)
+{
+    const __m128i lowMask = _mm_set1_epi16(0x00FF);
+    size_t row = 0;
+
+    for (; row + 8 <= rows; row += 8)
+    {
+        // l0 h0 .. l7 h7 -> l0 .. l7 | h0 .. h7 -> planes of rows 0-3 / 4-7 (every byte 4 times)
+        const __m128i data16 = _mm_loadu_si128((const __m128i *)&data[row * 2]);
+        __m128i low = _mm_packus_epi16(_mm_and_si128(data16, lowMask), _mm_setzero_si128());
+        __m128i high = _mm_packus_epi16(_mm_srli_epi16(data16, 8), _mm_setzero_si128());
+
+        low = _mm_unpacklo_epi8(low, low);
+        high = _mm_unpacklo_epi8(high, high);
+
+        for (int half = 0; half < 2; half++)
+        {
+            const __m128i lowRows = half ? _mm_unpackhi_epi16(low, low) : _mm_unpacklo_epi16(low, low);
+            const __m128i highRows = half ? _mm_unpackhi_epi16(high, high) : _mm_unpacklo_epi16(high, high);
+            uint8_t *out = &indices[(row + half * 4) * GB_TILE_ROW_PIXELS];
+
+            _mm_storeu_si128((__m128i *)out, GB_PpuMergePlanesSSE2(_mm_unpacklo_epi32(lowRows, lowRows),
+                                                                   _mm_unpacklo_epi32(highRows, highRows)));
+            _mm_storeu_si128((__m128i *)&out[16], GB_PpuMergePlanesSSE2(_mm_unpackhi_epi32(lowRows, lowRows),
+                                                                        _mm_unpackhi_epi32(highRows, highRows)));
+        }
+    }
+
+    GB_PpuDecodeRowsScalar(&indices[row * GB_TILE_ROW_PIXELS], &data[row * 2], rows - row);
+}
+
+// Four 32 bit indices to pixels (one compare per palette entry)
+GB_PPU_TARGET("sse2") static inline __m128i GB_PpuSelectSSE2(const __m128i index, const __m128i *colors)
+{
+    __m128i pixels = _mm_and_si128(_mm_cmpeq_epi32(index, _mm_setzero_si128()), colors[0]);
+
+    pixels = _mm_or_si128(pixels, _mm_and_si128(_mm_cmpeq_epi32(index, _mm_set1_epi32(1)), colors[1]));
+    pixels = _mm_or_si128(pixels, _mm_and_si128(_mm_cmpeq_epi32(index, _mm_set1_epi32(2)), colors[2]));
+    return _mm_or_si128(pixels, _mm_and_si128(_mm_cmpeq_epi32(index, _mm_set1_epi32(3)), colors[3]));
+}
+
+GB_PPU_TARGET("sse2") static void GB_PpuExpandSSE2(uint32_t *pixels, const uint8_t *indices, const uint32_t *palette, const size_t count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i colors[4] = {
+        _mm_set1_epi32((int32_t)palette[0]), _mm_set1_epi32((int32_t)palette[1]),
+        _mm_set1_epi32((int32_t)palette[2]), _mm_set1_epi32((int32_t)palette[3])};
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i bytes = _mm_loadu_si128((const __m128i *)&indices[i]);
+        const __m128i low = _mm_unpacklo_epi8(bytes, zero);
+        const __m128i high = _mm_unpackhi_epi8(bytes, zero);
+
+        _mm_storeu_si128((__m128i *)&pixels[i], GB_PpuSelectSSE2(_mm_unpacklo_epi16(low, zero), colors));
+        _mm_storeu_si128((__m128i *)&pixels[i + 4], GB_PpuSelectSSE2(_mm_unpackhi_epi16(low, zero), colors));
+        _mm_storeu_si128((__m128i *)&pixels[i + 8], GB_PpuSelectSSE2(_mm_unpacklo_epi16(high, zero), colors));
+        _mm_storeu_si128((__m128i *)&pixels[i + 12], GB_PpuSelectSSE2(_mm_unpackhi_epi16(high, zero), colors));
+    }
+
+    GB_PpuExpandScalar(&pixels[i], &indices[i], palette, count - i);
+}
+
+// AVX2
+
+// [low x8, high x8] per lane to the lane row indices (low 8 bytes of each lane)
+GB_PPU_TARGET("avx2") static inline __m256i GB_PpuMergePlanesAVX2(__m256i planes)
+{
+    const __m256i bits = _mm256_setr_epi8(-128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1,
+                                          -128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1);
+
+    planes = _mm256_min_epu8(_mm256_and_si256(planes, bits), _mm256_set1_epi8(1));
+    return _mm256_add_epi8(planes, _mm256_srli_si256(_mm256_add_epi8(planes, planes), 8));
+}
+
+GB_PPU_TARGET("avx2") static void GB_PpuDecodeRowsAVX2(uint8_t *indices, const uint8_t *data, const size_t rows)
+{
+    // rows 0 and 2 / 1 and 3 (lane 0 / lane 1), unpacking both keeps the output rows in order
+    const __m256i evenRows = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                                              4, 4, 4, 4, 4, 4, 4, 4, 5, 5, 5, 5, 5, 5, 5, 5);
+    const __m256i oddRows = _mm256_setr_epi8(2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3,
+                                             6, 6, 6, 6, 6, 6, 6, 6, 7, 7, 7, 7, 7, 7, 7, 7);
+    size_t row = 0;
+
+    for (; row + 4 <= rows; row += 4)
+    {
+        const __m256i planes = _mm256_broadcastsi128_si256(_mm_loadl_epi64((const __m128i *)&data[row * 2]));
+        const __m256i even = GB_PpuMergePlanesAVX2(_mm256_shuffle_epi8(planes, evenRows));
+        const __m256i odd = GB_PpuMergePlanesAVX2(_mm256_shuffle_epi8(planes, oddRows));
+
+        _mm256_storeu_si256((__m256i *)&indices[row * GB_TILE_ROW_PIXELS], _mm256_unpacklo_epi64(even, odd));
+    }
+
+    GB_PpuDecodeRowsScalar(&indices[row * GB_TILE_ROW_PIXELS], &data[row * 2], rows - row);
+}
+
+GB_PPU_TARGET("avx2") static void GB_PpuExpandAVX2(uint32_t *pixels, const uint8_t *indices, const uint32_t *palette, const size_t count)
+{
+    const __m256i colors = _mm256_setr_epi32((int32_t)palette[0], (int32_t)palette[1], (int32_t)palette[2], (int32_t)palette[3],
+                                             (int32_t)palette[0], (int32_t)palette[1], (int32_t)palette[2], (int32_t)palette[3]);
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m256i low = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)&indices[i]));
+        const __m256i high = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)&indices[i + 8]));
+
+        _mm256_storeu_si256((__m256i *)&pixels[i], _mm256_permutevar8x32_epi32(colors, low));
+        _mm256_storeu_si256((__m256i *)&pixels[i + 8], _mm256_permutevar8x32_epi32(colors, high));
+    }
+
+    GB_PpuExpandScalar(&pixels[i], &indices[i], palette, count - i);
+}
+
+#endif
+
+static const GB_PpuKernels s_gb_ppu_kernels[GB_PPU_SIMD_COUNT] = {
+    {"SCALAR", GB_PpuDecodeRowsScalar, GB_PpuExpandScalar},
+#ifdef GB_PPU_X86_SIMD
+    {"SSE2", GB_PpuDecodeRowsSSE2, GB_PpuExpandSSE2},
+    {"AVX2", GB_PpuDecodeRowsAVX2, GB_PpuExpandAVX2},
+#else
+    {"SSE2", NULL, NULL},
+    {"AVX2", NULL, NULL},
+#endif
+};
+
+static void GB_PpuDetectKernelsOnce()
+{
+    s_gb_ppu_supported[GB_PPU_SIMD_SCALAR] = 1;
+
+#ifdef GB_PPU_X86_SIMD
+    __builtin_cpu_init();
+    s_gb_ppu_supported[GB_PPU_SIMD_SSE2] = __builtin_cpu_supports("sse2") != 0;
+    s_gb_ppu_supported[GB_PPU_SIMD_AVX2] = __builtin_cpu_supports("avx2") != 0;
+#endif
+
+    for (int level = GB_PPU_SIMD_COUNT - 1; level >= 0 && s_gb_ppu_selected == NULL; level--)
+    {
+        if (s_gb_ppu_supported[level])
+        {
+            s_gb_ppu_selected = &s_gb_ppu_kernels[level];
+        }
+    }
+}
+
+const GB_PpuKernels *GB_PpuSelectKernels()
+{
+    pthread_once(&s_gb_ppu_kernels_once, GB_PpuDetectKernelsOnce);
+    return s_gb_ppu_selected;
+}
+
+const GB_PpuKernels *GB_PpuKernelsGet(const GB_PpuSimdLevel level)
+{
+    pthread_once(&s_gb_ppu_kernels_once, GB_PpuDetectKernelsOnce);
+
+    if (level < GB_PPU_SIMD_SCALAR || level >= GB_PPU_SIMD_COUNT || !s_gb_ppu_supported[level])
+    {
+        return NULL;
+    }
+
+    return &s_gb_ppu_kernels[level];
+}
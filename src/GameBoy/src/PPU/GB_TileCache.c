@@ -0,0 +1,48 @@
+#include <PPU/GB_TileCache.h>
+
+#include <minemu/MNE_Memory.h>
+#include <minemu/MNE_Log.h>
+
+GB_TileCache *GB_TileCacheCreate()
+{
+    GB_TileCache *cache = NULL;
+    MNE_New(cache, 1, GB_TileCache);
+
+    cache->kernels = GB_PpuSelectKernels();
+
+    GB_TileCacheInvalidate(cache);
+    return cache;
+}
+
+void GB_TileCacheDestroy(GB_TileCache *cache)
+{
+    MNE_Delete(cache);
+}
+
+void GB_TileCacheInvalidate(GB_TileCache *cache)
+{
+    if (cache == NULL)
+    {
+        return;
+    }
+
+    memset(cache->dirty, 1, sizeof(cache->dirty));
+}
+
+void GB_TileCacheDecode(GB_TileCache *cache, const uint8_t *vram, const uint16_t tile)
+{
+    cache->kernels->decodeRows(cache->pixels[tile][0], &vram[tile * 16], GB_TILE_ROW_PIXELS);
+
+    cache->dirty[tile] = 0;
+    cache->stats.decodes++;
+}
+
+void GB_TileCachePrintStats(const GB_TileCache *cache)
+{
+    const GB_TileCacheStats *stats = &cache->stats;
+    const uint64_t rows = stats->hits + stats->decodes;
+
+    MNE_Log("[TILE CACHE] ROW HITS: %llu (%.2f%%) TILE DECODES: %llu INVALIDATIONS: %llu\n",
+            (unsigned long long)stats->hits, rows ? 100.0 * stats->hits / rows : 0.0,
+            (unsigned long long)stats->decodes, (unsigned long long)stats->invalidations);
+}
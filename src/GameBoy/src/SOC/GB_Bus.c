@@ -1,8 +1,15 @@
 #include <SOC/GB_Bus.h>
-#include <minemu/MNE_Log.h>
+#include <Emulation/GB_BlockCache.h>
+#include <PPU/GB_TileCache.h>
+#include <SOC/GB_Timer.h>
+#include <SOC/GB_Serial.h>
+#include <SOC/GB_Interrupt.h>
+#include <Emulation/GB_Log.h>
+
+#include <string.h>
 
 /* GB_Bus.c TODOS
-- FIX THE IF-ELSE HELL
+- FIX THE IF-ELSE HELL (ONLY THE PAGES WITHOUT HOST POINTER END HERE NOW)
 */
 
 uint8_t GB_InAddressRange(const uint16_t a, const uint16_t b, const uint16_t addrr)
@@ -11,15 +18,51 @@ uint8_t GB_InAddressRange(const uint16_t a, const uint16_t b, const uint16_t add
     return (addrr >= a) && (addrr <= b);
 }
 
-uint8_t GB_ReadIO(const GB_Registers* registers, const uint16_t address)
+// OAM DMA: the 160 bytes are copied at once, the transfer only keeps dmaActive set until GB_EVENT_DMA
+// TODO: BLOCK CPU ACCESSES OUTSIDE HRAM WHILE dmaActive
+void GB_DMA_Start(EmulationState *ctx, const uint8_t source)
 {
-        MNE_Log("[IO READ INTENT] %04x\n", address);
+    const uint16_t address = source << 8;
+
+    ctx->dmaSource = source;
+
+    for (uint16_t i = 0; i < GB_OAM_SIZE; i++)
+    {
+        ctx->oam[i] = GB_BusRead(ctx, address + i);
+    }
+
+    ctx->dmaActive = 1;
+    GB_SchedulerSchedule(&ctx->scheduler, GB_EVENT_DMA, ctx->cpuCycles + GB_DMA_CYCLES);
+}
+
+void GB_DMA_OnComplete(EmulationState *ctx, const uint64_t deadline)
+{
+    (void)deadline;
+    ctx->dmaActive = 0;
+}
+
+uint8_t GB_ReadIO(const EmulationState *ctx, const uint16_t address)
+{
+        const GB_Registers *registers = &ctx->registers;
+
+        GB_Trace(IO, "[IO READ INTENT] %04x\n", address);
 
         switch (address)
         {
             // CPU RELATED REGISTERS
             case GB_IF_REGISTER:
                 return registers->IF.value;
+
+            // SERIAL + TIMER
+            case GB_SB_REGISTER:
+            case GB_SC_REGISTER:
+                return GB_Serial_Read(ctx, address);
+
+            case GB_DIV_REGISTER:
+            case GB_TIMA_REGISTER:
+            case GB_TMA_REGISTER:
+            case GB_TAC_REGISTER:
+                return GB_Timer_Read(ctx, address);
             
             // DISPLAY REGISTERS
             case GB_LCDC_REGISTER:
@@ -40,9 +83,7 @@ uint8_t GB_ReadIO(const GB_Registers* registers, const uint16_t address)
                 return registers->LCD_LYC;
 
             case GB_DMA_REGISTER:
-                // return registers->LCD_DMA;
-                MNE_Log("GB_DMA_REGISTER NOT READEABLE (NOT IMPLEMENTED!!!)\n");
-                return 0xFF;
+                return ctx->dmaSource;
 
             case GB_BGP_REGISTER:
                 return registers->LCD_BGP;
@@ -60,22 +101,38 @@ uint8_t GB_ReadIO(const GB_Registers* registers, const uint16_t address)
                 return registers->LCD_WX;
 
         default:
-                MNE_Log("IO RANGE NOT READBLE (NOT IMPLEMENTED!!!) io address: 0x%04x\n", address);
+                GB_Log(IO, DEBUG, "IO RANGE NOT READBLE (NOT IMPLEMENTED!!!) io address: 0x%04x\n", address);
             break;
         }
 
     return 0xFF;
 }
 
-void GB_WriteIO(GB_Registers* registers, const uint16_t address, const uint8_t value)
+void GB_WriteIO(EmulationState *ctx, const uint16_t address, const uint8_t value)
 {
-    MNE_Log("[IO WRITE INTENT] %04x\n", address);
+    GB_Registers *registers = &ctx->registers;
+
+    GB_Trace(IO, "[IO WRITE INTENT] %04x value[%02x]\n", address, value);
 
     switch (address)
     {
         // CPU RELATED REGISTERS
         case GB_IF_REGISTER:
             registers->IF.value = value;
+            GB_InterruptUpdatePending(ctx);
+            break;
+
+        // SERIAL + TIMER
+        case GB_SB_REGISTER:
+        case GB_SC_REGISTER:
+            GB_Serial_Write(ctx, address, value);
+            break;
+
+        case GB_DIV_REGISTER:
+        case GB_TIMA_REGISTER:
+        case GB_TMA_REGISTER:
+        case GB_TAC_REGISTER:
+            GB_Timer_Write(ctx, address, value);
             break;
         
         // DISPLAY REGISTERS
@@ -84,7 +141,8 @@ void GB_WriteIO(GB_Registers* registers, const uint16_t address, const uint8_t v
             break;
 
         case GB_LCD_STAT_REGISTER:
-            registers->LCD_STAT.value = value;
+            // Mode and coincidence bits are read only
+            registers->LCD_STAT.value = (value & 0x78) | (registers->LCD_STAT.value & 0x07);
             break;
 
         case GB_SCY_REGISTER:
@@ -104,21 +162,22 @@ void GB_WriteIO(GB_Registers* registers, const uint16_t address, const uint8_t v
             break;
 
         case GB_DMA_REGISTER:
-            // registers->LCD_DMA = value;
-            MNE_Log("GB_DMA_REGISTER NOT WRITABLE (NOT IMPLEMENTED!!!)\n");
-
+            GB_DMA_Start(ctx, value);
             break;
 
         case GB_BGP_REGISTER:
             registers->LCD_BGP = value;
+            GB_PalleteBuild(&ctx->palletes[GB_PALLETE_BG], value);
             break;
 
         case GB_OBP0_REGISTER:
             registers->LCD_OBP0 = value;
+            GB_PalleteBuild(&ctx->palletes[GB_PALLETE_OBJ0], value);
             break;
 
         case GB_OBP1_REGISTER:
             registers->LCD_OBP1 = value;
+            GB_PalleteBuild(&ctx->palletes[GB_PALLETE_OBJ1], value);
             break;
 
         case GB_WY_REGISTER:
@@ -130,65 +189,106 @@ void GB_WriteIO(GB_Registers* registers, const uint16_t address, const uint8_t v
             break;
 
     default:
-        MNE_Log("IO RANGE NOT WRITABLE (NOT IMPLEMENTED!!!)  io address: 0x%04x\n", address);
+        GB_Log(IO, DEBUG, "IO RANGE NOT WRITABLE (NOT IMPLEMENTED!!!)  io address: 0x%04x\n", address);
         break;
     }
 }
 
-uint8_t GB_BusRead(const EmulationState *ctx, uint16_t address)
+// Points [start, end] pages to memory (NULL = handler), writable = 0 leaves the writes on the handler
+static void GB_BusMapPages(EmulationState *ctx, const uint16_t start, const uint16_t end, uint8_t *memory, const uint8_t writable)
+{
+    for (uint16_t page = start >> 8; page <= end >> 8; page++)
+    {
+        uint8_t *base = memory != NULL ? memory + ((page << 8) - start) : NULL;
+
+        ctx->readPages[page] = base;
+        ctx->writePages[page] = writable ? base : NULL;
+    }
+}
+
+void GB_BusRemap(EmulationState *ctx)
+{
+    memset(ctx->readPages, 0, sizeof(ctx->readPages));
+    memset(ctx->writePages, 0, sizeof(ctx->writePages));
+
+    // Rom writes stay on the handler (mapper registers, block cache invalidation)
+    GB_BusMapPages(ctx, GB_BANK_00_START, GB_BANK_00_END, ctx->bank_00, 0);
+    GB_BusMapPages(ctx, GB_BANK_NN_START, GB_BANK_NN_END, ctx->bank_nn, 0);
+
+    // Boot rom overlay (0x0000 - 0x00FF)
+    if (ctx->bios_enabled && ctx->bios != NULL)
+    {
+        ctx->readPages[0] = ctx->bios;
+    }
+
+    // Tile data writes stay on the handler (tile cache invalidation), the tile maps are written through the page
+    GB_BusMapPages(ctx, GB_VRAM_START, GB_TILE_DATA_END, ctx->vram, 0);
+    GB_BusMapPages(ctx, GB_TILE_DATA_END + 1, GB_VRAM_END, ctx->vram + (GB_TILE_DATA_END + 1 - GB_VRAM_START), 1);
+    GB_BusMapPages(ctx, GB_WRAM_START, GB_WRAM2_END, ctx->wram, 1);
+    GB_BusMapPages(ctx, GB_ECHO_RAM_START, GB_ECHO_RAM_END, ctx->wram, 1);
+
+    // External ram (mapper), OAM + not usable, IO + HRAM + IE pages don't have a host pointer
+}
+
+void GB_BusMapRomBank(EmulationState *ctx, uint8_t *bank)
+{
+    ctx->bank_nn = bank;
+    GB_BusMapPages(ctx, GB_BANK_NN_START, GB_BANK_NN_END, bank, 0);
+    GB_BlockCacheInvalidate(ctx->blockCache);
+}
+
+uint8_t GB_BusReadHandler(const EmulationState *ctx, uint16_t address)
 {
     if (GB_InAddressRange(GB_BANK_00_START, GB_BANK_00_END, address))
     {
-        if (address > 256)
-        {
-            MNE_Log("BANK_00 read address [%04x];\n", address);
-        }
+        GB_Trace(BUS, "BANK_00 read address [%04x];\n", address);
 
-        return ctx->bios_enabled ? ctx->bios[address] : ctx->bank_00[address]; // lol...
+        return ctx->bios_enabled && address <= 0xFF ? ctx->bios[address] : ctx->bank_00[address]; // lol...
     }
     else if (GB_InAddressRange(GB_BANK_NN_START, GB_BANK_NN_END, address))
     {
+        if (ctx->bank_nn != NULL)
+        {
+            return ctx->bank_nn[address - GB_BANK_NN_START];
+        }
+
         // MB0 GOES HERE...
-        MNE_Log("Not implemented readable GB_BANK_NN %04x\n", address);
+        GB_Log(BUS, DEBUG, "Not implemented readable GB_BANK_NN %04x\n", address);
     }
     else if (GB_InAddressRange(GB_VRAM_START, GB_VRAM_END, address))
     {
-        MNE_Log("VRAM READ!!! %04x\n", address);
+        GB_Trace(BUS, "VRAM READ!!! %04x\n", address);
 
-        return ctx->vram[GB_VRAM_START - address];
+        return ctx->vram[address - GB_VRAM_START];
     }
     else if (GB_InAddressRange(GB_ERAM_START, GB_ERAM_END, address))
     {
-        MNE_Log("Not implemented readable GB_ERAM %04x\n", address);
+        GB_Log(BUS, DEBUG, "Not implemented readable GB_ERAM %04x\n", address);
     }
-    else if (GB_InAddressRange(GB_WRAM_START, GB_WRAM_END, address))
+    else if (GB_InAddressRange(GB_WRAM_START, GB_WRAM2_END, address))
     {
-        MNE_Log("Not implemented readable GB_WRAM %04x\n", address);
-    }
-    else if (GB_InAddressRange(GB_WRAM2_START, GB_WRAM2_END, address))
-    {
-        MNE_Log("Not implemented readable GB_WRAM2 %04x\n", address);
+        return ctx->wram[address - GB_WRAM_START];
     }
     else if (GB_InAddressRange(GB_ECHO_RAM_START, GB_ECHO_RAM_END, address))
     {
-        MNE_Log("Not implemented readable GB_ECHO_RAM %04x\n", address);
+        return ctx->wram[address - GB_ECHO_RAM_START];
     }
     else if (GB_InAddressRange(GB_OAM_START, GB_OAM_END, address))
     {
-        MNE_Log("Not implemented readable OAM %04x\n", address);
+        return ctx->oam[address - GB_OAM_START];
     }
     else if (GB_InAddressRange(GB_NOT_USABLE_RAM_START, GB_NOT_USABLE_RAM_END, address))
     {
-        MNE_Log("Warning, reading from GB_NOT_USABLE_RAM ... %04x\n", address);
+        GB_Log(BUS, WARN, "Warning, reading from GB_NOT_USABLE_RAM ... %04x\n", address);
         return 0xFF;
     }
     else if (GB_InAddressRange(GB_IO_START, GB_IO_END, address))
     {
-        return GB_ReadIO(&ctx->registers, address);
+        return GB_ReadIO(ctx, address);
     }
     else if (GB_InAddressRange(GB_HRAM_START, GB_HRAM_END, address))
     {
-        return ctx->hram[GB_HRAM_START - address];
+        return ctx->hram[address - GB_HRAM_START];
     }
     // INDIVIDUAL ADDRESSES (TODO: FIX THIS TRASH)
     else if (address == GB_IE_REGISTER)
@@ -197,80 +297,87 @@ uint8_t GB_BusRead(const EmulationState *ctx, uint16_t address)
     }
     else
     {
-        MNE_Log("Undefined read access at: %04x\n", address);
+        GB_Log(BUS, ERROR, "Undefined read access at: %04x\n", address);
     }
 
     return 0;
 }
 
-void GB_BusWrite(EmulationState *ctx, uint16_t address, uint8_t value)
+void GB_BusWriteHandler(EmulationState *ctx, uint16_t address, uint8_t value)
 {
     if (GB_InAddressRange(GB_BANK_00_START, GB_BANK_00_END, address))
     {
         // BIOS READ (TODO CHECK BOOT ROM REGISTER TO DISABLE)
         if (ctx->bios_enabled && address <= 0xFF)
         {
-            MNE_Log("Fool u cannot write in this region while the bios is enabled... addrr: %04x\n", address);
+            GB_Log(BUS, WARN, "Fool u cannot write in this region while the bios is enabled... addrr: %04x\n", address);
             return;
         }
-        MNE_Log("BANK_00 WRITE address [%04x]; value[%02x]\n", address, value);
+        GB_Trace(BUS, "BANK_00 WRITE address [%04x]; value[%02x]\n", address, value);
 
 
         ctx->bank_00[address] = value;
+        GB_BlockCacheInvalidate(ctx->blockCache);
     }
     else if (GB_InAddressRange(GB_BANK_NN_START, GB_BANK_NN_END, address))
     {
         // MB0 GOES HERE...
-        MNE_Log("Not implemented writable GB_BANK_NN %04x\n", address);
+        GB_Log(BUS, DEBUG, "Not implemented writable GB_BANK_NN %04x\n", address);
+        GB_BlockCacheInvalidate(ctx->blockCache); // Bank switch
     }
     else if (GB_InAddressRange(GB_VRAM_START, GB_VRAM_END, address))
     {
-        MNE_Log("VRAM WRITE!!! %04x\n", address);
+        GB_Trace(BUS, "VRAM WRITE!!! %04x\n", address);
 
-        ctx->vram[GB_VRAM_START - address] = value;
+        ctx->vram[address - GB_VRAM_START] = value;
+
+        if (address <= GB_TILE_DATA_END && ctx->tileCache != NULL)
+        {
+            GB_TileCacheWrite(ctx->tileCache, address);
+        }
     }
     else if (GB_InAddressRange(GB_ERAM_START, GB_ERAM_END, address))
     {
-        MNE_Log("Not implemented writable GB_ERAM %04x\n", address);
-    }
-    else if (GB_InAddressRange(GB_WRAM_START, GB_WRAM_END, address))
-    {
-        MNE_Log("Not implemented writable GB_WRAM %04x\n", address);
+        GB_Log(BUS, DEBUG, "Not implemented writable GB_ERAM %04x\n", address);
     }
-    else if (GB_InAddressRange(GB_WRAM2_START, GB_WRAM2_END, address))
+    else if (GB_InAddressRange(GB_WRAM_START, GB_WRAM2_END, address))
     {
-        MNE_Log("Not implemented writable GB_WRAM2 %04x\n", address);
+        ctx->wram[address - GB_WRAM_START] = value;
     }
     else if (GB_InAddressRange(GB_ECHO_RAM_START, GB_ECHO_RAM_END, address))
     {
-        MNE_Log("Not implemented writable GB_ECHO_RAM %04x\n", address);
+        ctx->wram[address - GB_ECHO_RAM_START] = value;
     }
     else if (GB_InAddressRange(GB_OAM_START, GB_OAM_END, address))
     {
-        MNE_Log("Not implemented writable OAM %04x\n", address);
+        ctx->oam[address - GB_OAM_START] = value;
     }
     else if (GB_InAddressRange(GB_NOT_USABLE_RAM_START, GB_NOT_USABLE_RAM_END, address))
     {
-        MNE_Log("Not writable GB_NOT_USABLE_RAM range %04x\n", address);
+        GB_Log(BUS, WARN, "Not writable GB_NOT_USABLE_RAM range %04x\n", address);
     }
     else if (GB_InAddressRange(GB_IO_START, GB_IO_END, address))
     {
-        GB_WriteIO(&ctx->registers, address, value);
+        GB_WriteIO(ctx, address, value);
     }
     else if (GB_InAddressRange(GB_HRAM_START, GB_HRAM_END, address))
     {
-        ctx->hram[GB_HRAM_START - address] = value;
+        ctx->hram[address - GB_HRAM_START] = value;
     }
     else if (address == GB_IE_REGISTER) // IE REGISTER
     {
         ctx->registers.IE.value = value;
+        GB_InterruptUpdatePending(ctx);
     }
     else
     {
-        MNE_Log("Undefined writable access at: %04x\n", address);
+        GB_Log(BUS, ERROR, "Undefined writable access at: %04x\n", address);
     }
 }
 
+// r8 encoding (B,C,D,E,H,L,(HL),A) to FILE_8 index, A skips F ((HL) never reaches the file)
+static const uint8_t s_gb_reg8_file_index[8] = {0, 1, 2, 3, 4, 5, 0, 6};
+
 void GB_SetReg8(EmulationState *ctx, uint8_t r, uint8_t value)
 {
     if (r == GB_HL_INDIRECT_OFFSET)
@@ -279,13 +386,7 @@ void GB_SetReg8(EmulationState *ctx, uint8_t r, uint8_t value)
         return;
     }
 
-    // improve (this is to ignore F register in the indexing)
-    if (r == GB_A_OFFSET)
-    {
-        r--;
-    }
-
-    ctx->registers.FILE_8[r] = value;
+    ctx->registers.FILE_8[s_gb_reg8_file_index[r]] = value;
 }
 
 uint8_t GB_GetReg8(EmulationState *ctx, uint8_t r)
@@ -295,13 +396,7 @@ uint8_t GB_GetReg8(EmulationState *ctx, uint8_t r)
         return GB_BusRead(ctx, ctx->registers.HL);
     }
 
-    // improve (this is to ignore F register in the indexing)
-    if (r == GB_A_OFFSET)
-    {
-        r--;
-    }
-
-    return ctx->registers.FILE_8[r];
+    return ctx->registers.FILE_8[s_gb_reg8_file_index[r]];
 }
 
 void GB_SetReg16(EmulationState *ctx, uint8_t r, uint16_t value, uint8_t mode)
@@ -330,7 +425,7 @@ void GB_SetReg16(EmulationState *ctx, uint8_t r, uint16_t value, uint8_t mode)
         break;
 
     default:
-        MNE_Log("ERROR: GB_SetReg16 CANNOT DEDEUCE REGISTER ADDRESSING MODE");
+        GB_Log(CPU, ERROR, "ERROR: GB_SetReg16 CANNOT DEDEUCE REGISTER ADDRESSING MODE\n");
         break;
     }
 }
@@ -356,7 +451,7 @@ uint16_t GB_GetReg16(EmulationState *ctx, uint8_t r, uint8_t mode)
         /* code */
         break;
     default:
-        MNE_Log("ERROR: GB_GetReg16 CANNOT DEDEUCE REGISTER ADDRESSING MODE");
+        GB_Log(CPU, ERROR, "ERROR: GB_GetReg16 CANNOT DEDEUCE REGISTER ADDRESSING MODE\n");
         break;
     }
     
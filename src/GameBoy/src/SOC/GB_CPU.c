@@ -2,68 +2,65 @@
 #include <SOC/GB_Bus.h>
 #include <SOC/GB_Registers.h>
 #include <SOC/GB_Opcodes.h>
+#include <SOC/GB_ALU.h>
 
-#include <minemu/MNE_Log.h>
+#include <Emulation/GB_Log.h>
+
+#include <stddef.h>
 
 /*INSTRUCTIONS TODOS:
 - OPTIMIZATION: CONVERT ALL INSTRUCTIONS WITH R_N, N_R EVEN A_N AND A_R TO SINGLE FUNCTIONS WITH SELECTABLE MODE (REDUCE CODE)
 - IMPLEMENT: DEBUG TOOLS TO PROFILE AND MESURE EXECUTIONS TIMES...
 - OPTIMIZATION: REMOVE UNNECESSARY LOCALS
-- OPTIMIZATION: FLAGS OPERATIONS
+- OPTIMIZATION: FLAGS OPERATIONS (DONE FOR THE 8 BIT ALU, LAZY FLAGS ON GB_ALU.H)
 - OPTIMIZATION: ENSURE MINIMAL INSTRUCTION SIZE IMPLEMENTATION AND COMPILER INTRISICS FOR AVR AND STM32 (CHECK UDISPLAY PROYECT...)
 */
 
 // 8-BIT LOAD INSTRUCTIONS
-uint8_t GB_LD_R_R(EmulationState *ctx)
-{
-    // encoding: b01xxxyyy/various
-    /*
-        R = R
-    */
-    const uint8_t r1 = (ctx->registers.INSTRUCTION & 0x38) >> 3;
-    const uint8_t r2 = (ctx->registers.INSTRUCTION & 0x07);
-
-    GB_SetReg8(ctx, r1, GB_GetReg8(ctx, r2));
-
-    return 4; // instruction clock cycles
-}
-
-uint8_t GB_LD_R_N(EmulationState *ctx)
-{
-    // encoding: 0b00xxx110/various + n
-    /*
-        R = read(PC++)
-    */
-    const uint8_t r = (ctx->registers.INSTRUCTION & 0x38) >> 3;
-
-    GB_SetReg8(ctx, r, GB_BusRead(ctx, ctx->registers.PC++));
-
-    return 8; // instruction clock cycles
-}
-
-uint8_t GB_LD_R_HL(EmulationState *ctx)
-{
-    // encoding: 0b01xxx110/various
-    /*
-        R = read(HL)
-    */
-    const uint8_t r = (ctx->registers.INSTRUCTION & 0x38) >> 3;
-    GB_SetReg8(ctx, r, GB_BusRead(ctx, ctx->registers.HL));
+// LD r,r' operands (GB_LD_R_R_LIST register names), HL is the (HL) memory operand
+#define GB_R8_READ_B(ctx)  (ctx)->registers.B
+#define GB_R8_READ_C(ctx)  (ctx)->registers.C
+#define GB_R8_READ_D(ctx)  (ctx)->registers.D
+#define GB_R8_READ_E(ctx)  (ctx)->registers.E
+#define GB_R8_READ_H(ctx)  (ctx)->registers.H
+#define GB_R8_READ_L(ctx)  (ctx)->registers.L
+#define GB_R8_READ_HL(ctx) GB_BusRead((ctx), (ctx)->registers.HL)
+#define GB_R8_READ_A(ctx)  (ctx)->registers.A
+
+#define GB_R8_WRITE_B(ctx, value)  (ctx)->registers.B = (value)
+#define GB_R8_WRITE_C(ctx, value)  (ctx)->registers.C = (value)
+#define GB_R8_WRITE_D(ctx, value)  (ctx)->registers.D = (value)
+#define GB_R8_WRITE_E(ctx, value)  (ctx)->registers.E = (value)
+#define GB_R8_WRITE_H(ctx, value)  (ctx)->registers.H = (value)
+#define GB_R8_WRITE_L(ctx, value)  (ctx)->registers.L = (value)
+#define GB_R8_WRITE_HL(ctx, value) GB_BusWrite((ctx), (ctx)->registers.HL, (value))
+#define GB_R8_WRITE_A(ctx, value)  (ctx)->registers.A = (value)
+
+// encoding: b01xxxyyy/various
+/*
+    R = R
+*/
+#define GB_LD_R_R_HANDLER(op, dst, src)                          \
+    uint8_t GB_LD_##dst##_##src(EmulationState *ctx)             \
+    {                                                            \
+        GB_R8_WRITE_##dst(ctx, GB_R8_READ_##src(ctx));           \
+        return GB_OPCODE_CYCLES(ctx);                            \
+    }
 
-    return 8;
-}
+GB_LD_R_R_LIST(GB_LD_R_R_HANDLER)
 
-uint8_t GB_LD_HL_R(EmulationState *ctx)
-{
-    // encoding: 0b01110xxx
-    /*
-        write(HL, R)
-    */
-    const uint8_t r = ctx->registers.INSTRUCTION & 0x07;
+// encoding: 0b00xxx110/various + n
+/*
+    R = read(PC++)
+*/
+#define GB_LD_R_N_HANDLER(r, reg)                                     \
+    uint8_t GB_LD_##reg##_N(EmulationState *ctx)                      \
+    {                                                                 \
+        GB_R8_WRITE_##reg(ctx, GB_BusRead(ctx, ctx->registers.PC++)); \
+        return GB_OPCODE_CYCLES(ctx);                                 \
+    }
 
-    GB_SetReg8(ctx, r, GB_BusRead(ctx, ctx->registers.HL));
-    return 8;
-}
+GB_R8_LIST(GB_LD_R_N_HANDLER)
 
 uint8_t GB_LD_HL_N(EmulationState *ctx)
 {
@@ -75,7 +72,7 @@ uint8_t GB_LD_HL_N(EmulationState *ctx)
     const uint8_t n = GB_BusRead(ctx, ctx->registers.PC++);
 
     GB_BusWrite(ctx, ctx->registers.HL, n);
-    return 1; // TODO, PLACEHOLDER TIMING...;
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_LD_A_BC(EmulationState *ctx)
@@ -85,7 +82,7 @@ uint8_t GB_LD_A_BC(EmulationState *ctx)
         A = read(BC)
     */
     ctx->registers.A = GB_BusRead(ctx, ctx->registers.BC);
-    return 1; // TODO, PLACEHOLDER TIMING...;
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_LD_A_DE(EmulationState *ctx)
@@ -95,7 +92,7 @@ uint8_t GB_LD_A_DE(EmulationState *ctx)
         A = read(DE)
     */
     ctx->registers.A = GB_BusRead(ctx, ctx->registers.DE);
-    return 1; // TODO, PLACEHOLDER TIMING...;
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_LD_A_NN(EmulationState *ctx)
@@ -112,7 +109,7 @@ uint8_t GB_LD_A_NN(EmulationState *ctx)
 
     ctx->registers.A = GB_BusRead(ctx, nn);
 
-    return 1; // TODO, PLACEHOLDER TIMING...;
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_LD_BC_A(EmulationState *ctx)
@@ -122,7 +119,7 @@ uint8_t GB_LD_BC_A(EmulationState *ctx)
         write(BC, A)
     */
     GB_BusWrite(ctx, ctx->registers.BC, ctx->registers.A);
-    return 1; // TODO, PLACEHOLDER TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_LD_DE_A(EmulationState *ctx)
@@ -133,7 +130,7 @@ uint8_t GB_LD_DE_A(EmulationState *ctx)
     */
     GB_BusWrite(ctx, ctx->registers.DE, ctx->registers.A);
 
-    return 1; // TODO, PLACEHOLDER TIMING...;
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_LD_NN_A(EmulationState *ctx)
@@ -149,7 +146,7 @@ uint8_t GB_LD_NN_A(EmulationState *ctx)
 
     GB_BusWrite(ctx, nn,  ctx->registers.A);
 
-    return 1; // TODO, PLACEHOLDER TIMING...;
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_LDH_A_N(EmulationState *ctx)
@@ -165,7 +162,7 @@ uint8_t GB_LDH_A_N(EmulationState *ctx)
 
     ctx->registers.A = GB_BusRead(ctx, u16);
 
-    return 1; // TODO, PLACEHOLDER TIMING...;
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_LDH_N_A(EmulationState *ctx)
@@ -180,7 +177,7 @@ uint8_t GB_LDH_N_A(EmulationState *ctx)
     const uint16_t u16 = (uint16_t)(n | (0xFF << 8));
 
     GB_BusWrite(ctx, u16,  ctx->registers.A);
-    return 1; // TODO, PLACEHOLDER TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_LDH_A_C(EmulationState *ctx)
@@ -192,7 +189,7 @@ uint8_t GB_LDH_A_C(EmulationState *ctx)
     const uint16_t u16 = (uint16_t)(ctx->registers.C | (0xFF << 8));
 
     ctx->registers.A = GB_BusRead(ctx, u16);
-    return 1; // TODO, PLACEHOLDER TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 
@@ -205,7 +202,7 @@ uint8_t GB_LDH_C_A(EmulationState *ctx)
     const uint16_t u16 = (uint16_t)(ctx->registers.C | (0xFF << 8));
     GB_BusWrite(ctx, u16, ctx->registers.A);
 
-    return 1; // TODO, PLACEHOLDER TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_LDI_HL_A(EmulationState *ctx)
@@ -216,7 +213,7 @@ uint8_t GB_LDI_HL_A(EmulationState *ctx)
     */
    
     GB_BusWrite(ctx, ctx->registers.HL++, ctx->registers.A);
-    return 2;
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_LDI_A_HL(EmulationState *ctx)
@@ -227,7 +224,7 @@ uint8_t GB_LDI_A_HL(EmulationState *ctx)
     */
 
     ctx->registers.A = GB_BusRead(ctx, ctx->registers.HL++);
-    return 1; // TODO, PLACEHOLDER TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_LDD_HL_A(EmulationState *ctx)
@@ -238,7 +235,7 @@ uint8_t GB_LDD_HL_A(EmulationState *ctx)
     */
 
     GB_BusWrite(ctx, ctx->registers.HL--, ctx->registers.A);
-    return 1; // TODO, PLACEHOLDER TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_LDD_A_HL(EmulationState *ctx)
@@ -249,7 +246,7 @@ uint8_t GB_LDD_A_HL(EmulationState *ctx)
     */
 
     ctx->registers.A = GB_BusRead(ctx, ctx->registers.HL--);
-    return 1; // TODO, PLACEHOLDER TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 // 16 BIT LOAD INSTRUCTIONS
@@ -267,7 +264,7 @@ uint8_t GB_LD_RR_NN(EmulationState *ctx)
     
     GB_SetReg16(ctx, rr, nn, REG16_MODE_SP);
     
-    return 2;
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_LD_NN_SP(EmulationState *ctx)
@@ -292,7 +289,7 @@ uint8_t GB_LD_NN_SP(EmulationState *ctx)
     GB_BusWrite(ctx, indirect_addr, spl);
     GB_BusWrite(ctx, indirect_addr + 1, sph);
     
-    return 1; //TODO: CHECK TIMING!
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_LD_SP_HL(EmulationState *ctx)
@@ -303,7 +300,7 @@ uint8_t GB_LD_SP_HL(EmulationState *ctx)
     */
     ctx->registers.SP = ctx->registers.HL;
     
-    return 1; //TODO: CHECK TIMING!
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_PUSH_RR(EmulationState *ctx)
@@ -315,7 +312,13 @@ uint8_t GB_PUSH_RR(EmulationState *ctx)
         write_memory(addr=SP, data=lsb(BC))
     */
     const uint8_t rr = (ctx->registers.INSTRUCTION & 0x30) >> 4;
-    
+
+    // PUSH AF pushes the real flags
+    if (rr == 3)
+    {
+        GB_FlagsSync(ctx);
+    }
+
     uint16_t drr = GB_GetReg16(ctx, rr, REG16_MODE_AF);
     const uint8_t l = drr & 0xFF;
     const uint8_t h = (drr >> 8) & 0xFF;
@@ -325,7 +328,7 @@ uint8_t GB_PUSH_RR(EmulationState *ctx)
     ctx->registers.SP--;
     GB_BusWrite(ctx, ctx->registers.SP, l);
 
-    return 1; //TODO: CHECK TIMING!
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_POP_RR(EmulationState *ctx)
@@ -335,41 +338,38 @@ uint8_t GB_POP_RR(EmulationState *ctx)
         BC = unsigned_16(lsb=read(SP++), msb=read(SP++))
     */
     const uint8_t rr = (ctx->registers.INSTRUCTION & 0x30) >> 4;
-    
+
+    // POP AF overwrites F, a pending operation would overwrite it back on the next sync
+    if (rr == 3)
+    {
+        GB_FlagsSync(ctx);
+    }
+
     const uint8_t l =  GB_BusRead(ctx,ctx->registers.SP++);
     const uint8_t h =  GB_BusRead(ctx,ctx->registers.SP++);
     GB_SetReg16(ctx, rr,  l | (h << 8), REG16_MODE_AF);
     
-    return 1; //TODO: CHECK TIMING!
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 // 8 BIT ALU INSTRUCTIONS
-uint8_t GB_ADD_A_R(EmulationState *ctx)
-{
-    // encoding: 0b10000xxx
-    /*
-        result, carry_per_bit = A + R (example)
-        A = result
-        flags.Z = 1 if result == 0 else 0
-        flags.N = 0
-        flags.H = 1 if carry_per_bit[3] else 0
-        flags.C = 1 if carry_per_bit[7] else 0
-    */
-    const uint8_t rr = (ctx->registers.INSTRUCTION & 0x07);
-    const uint8_t a = ctx->registers.A;
-    const uint8_t r = GB_GetReg8(ctx, rr);
-
-    const uint16_t sum =  a + r;
-    ctx->registers.A = sum;
-
-    // Flag manipulation
-    ctx->registers.ZERO_FLAG = sum == 0;
-    ctx->registers.N_FLAG = 0;
-    ctx->registers.H_CARRY_FLAG = (a & 0xf) + (r & 0xf) > 0xf;
-    ctx->registers.CARRY_FLAG = sum > 0xFF;
+// encoding: 0b10000xxx
+/*
+    result, carry_per_bit = A + R (example)
+    A = result
+    flags.Z = 1 if result == 0 else 0
+    flags.N = 0
+    flags.H = 1 if carry_per_bit[3] else 0
+    flags.C = 1 if carry_per_bit[7] else 0
+*/
+#define GB_ADD_A_R_HANDLER(r, reg)                                                       \
+    uint8_t GB_ADD_A_##reg(EmulationState *ctx)                                          \
+    {                                                                                    \
+        ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, GB_R8_READ_##reg(ctx), 0); \
+        return GB_OPCODE_CYCLES(ctx);                                                    \
+    }
 
-    return 4;
-}
+GB_R8_LIST(GB_ADD_A_R_HANDLER)
 
 uint8_t GB_ADD_A_N(EmulationState *ctx)
 {
@@ -383,18 +383,10 @@ uint8_t GB_ADD_A_N(EmulationState *ctx)
         flags.H = 1 if carry_per_bit[3] else 0
         flags.C = 1 if carry_per_bit[7] else 0
     */
-
     const uint8_t n = GB_BusRead(ctx, ctx->registers.PC++);
-    const uint16_t sum =  ctx->registers.A + n;
-    ctx->registers.A = sum;
-    
-    ctx->registers.ZERO_FLAG = sum == 0;
-    ctx->registers.N_FLAG = 0;
-    ctx->registers.H_CARRY_FLAG = (n & 0xf) + (ctx->registers.A  & 0xf) > 0xf;
-    ctx->registers.CARRY_FLAG = sum > 0xFF;
+    ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, n, 0);
 
-    //Used to set F reg 
-    return 1; //TODO: CHECK TIMING!
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_ADD_A_HL(EmulationState *ctx)
@@ -409,44 +401,29 @@ uint8_t GB_ADD_A_HL(EmulationState *ctx)
         flags.H = 1 if carry_per_bit[3] else 0
         flags.C = 1 if carry_per_bit[7] else 0
     */
-
     const uint8_t data = GB_BusRead(ctx, ctx->registers.HL);
-    const uint8_t a = ctx->registers.A;
-    const int sum = a + data;
-    ctx->registers.A = sum;
+    ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, data, 0);
 
-    ctx->registers.ZERO_FLAG = sum == 0;
-    ctx->registers.N_FLAG = 0;
-    ctx->registers.H_CARRY_FLAG = (a & 0xf) + (data & 0xf) > 0xf;
-    ctx->registers.CARRY_FLAG = sum > 0xFF;
-
-    return 8;
+    return GB_OPCODE_CYCLES(ctx);
 }
 
-uint8_t GB_ADC_A_R(EmulationState *ctx)
-{
-    //encoding:0b10001xxx
-    /*
-        result, carry_per_bit = A + flags.C + B
-        A = result
-        flags.Z = 1 if result == 0 else 0
-        flags.N = 0
-        flags.H = 1 if carry_per_bit[3] else 0
-        flags.C = 1 if carry_per_bit[7] else 0
-    */
+//encoding:0b10001xxx
+/*
+    result, carry_per_bit = A + flags.C + B
+    A = result
+    flags.Z = 1 if result == 0 else 0
+    flags.N = 0
+    flags.H = 1 if carry_per_bit[3] else 0
+    flags.C = 1 if carry_per_bit[7] else 0
+*/
+#define GB_ADC_A_R_HANDLER(r, reg)                                                                       \
+    uint8_t GB_ADC_A_##reg(EmulationState *ctx)                                                          \
+    {                                                                                                    \
+        ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, GB_R8_READ_##reg(ctx), GB_FlagCarry(ctx)); \
+        return GB_OPCODE_CYCLES(ctx);                                                                    \
+    }
 
-    const uint8_t rr = (ctx->registers.INSTRUCTION & 0x07);
-    const uint8_t value = GB_GetReg8(ctx, rr);
-    const uint16_t sum =  ctx->registers.A + ctx->registers.CARRY_FLAG + value;
-    ctx->registers.A = sum;
-
-    ctx->registers.ZERO_FLAG = sum == 0;
-    ctx->registers.N_FLAG = 0;
-    ctx->registers.H_CARRY_FLAG = (ctx->registers.A & 0xF) + (value & 0xF) + (ctx->registers.CARRY_FLAG > 0xF);
-    ctx->registers.CARRY_FLAG = sum > 0xFF;
-    
-    return 4;
-}
+GB_R8_LIST(GB_ADC_A_R_HANDLER)
 
 uint8_t GB_ADC_A_N(EmulationState *ctx)
 {
@@ -460,18 +437,10 @@ uint8_t GB_ADC_A_N(EmulationState *ctx)
         flags.H = 1 if carry_per_bit[3] else 0
         flags.C = 1 if carry_per_bit[7] else 0
     */
-
     const uint8_t n = GB_BusRead(ctx, ctx->registers.PC++);
+    ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, n, GB_FlagCarry(ctx));
 
-    const uint16_t sum =  ctx->registers.A + ctx->registers.CARRY_FLAG + n;
-    ctx->registers.A = sum;
-
-    ctx->registers.ZERO_FLAG = sum == 0;
-    ctx->registers.N_FLAG = 0;
-    ctx->registers.H_CARRY_FLAG = (ctx->registers.A & 0xF) + (n & 0xF) + (ctx->registers.CARRY_FLAG > 0xF);
-    ctx->registers.CARRY_FLAG = sum > 0xFF;
-
-    return 8;
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_ADC_A_HL(EmulationState *ctx)
@@ -486,46 +455,29 @@ uint8_t GB_ADC_A_HL(EmulationState *ctx)
         flags.H = 1 if carry_per_bit[3] else 0
         flags.C = 1 if carry_per_bit[7] else 0
     */
+    const uint8_t data = GB_BusRead(ctx, ctx->registers.HL);
+    ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, data, GB_FlagCarry(ctx));
 
-    const uint8_t n = GB_BusRead(ctx, ctx->registers.HL);
-    const uint8_t a = ctx->registers.A;
-
-    const int sum =  a + ctx->registers.CARRY_FLAG + n;
-    ctx->registers.A = sum;
-
-    ctx->registers.ZERO_FLAG = sum == 0;
-    ctx->registers.N_FLAG = 0;
-    ctx->registers.H_CARRY_FLAG = ((a & 0xf) + (n & 0xf) + ctx->registers.CARRY_FLAG) > 0xf;
-    ctx->registers.CARRY_FLAG = sum > 0xFF;
-    
-    return 8;
+    return GB_OPCODE_CYCLES(ctx);
 }
 
-uint8_t GB_SUB_R(EmulationState *ctx)
-{
-    // encoding: 0b10010xxx
-    /*
-        result, carry_per_bit = A - B
-        A = result
-        flags.Z = 1 if result == 0 else 0
-        flags.N = 1
-        flags.H = 1 if carry_per_bit[3] else 0
-        flags.C = 1 if carry_per_bit[7] else 0
-    */
-    const uint8_t rr = (ctx->registers.INSTRUCTION & 0x07);
-    const uint8_t a = ctx->registers.A; 
-    const uint8_t data = GB_GetReg8(ctx, rr);
-
-    const int sub =  a - data;
-    ctx->registers.A = sub;
+// encoding: 0b10010xxx
+/*
+    result, carry_per_bit = A - B
+    A = result
+    flags.Z = 1 if result == 0 else 0
+    flags.N = 1
+    flags.H = 1 if carry_per_bit[3] else 0
+    flags.C = 1 if carry_per_bit[7] else 0
+*/
+#define GB_SUB_R_HANDLER(r, reg)                                                         \
+    uint8_t GB_SUB_##reg(EmulationState *ctx)                                            \
+    {                                                                                    \
+        ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, GB_R8_READ_##reg(ctx), 0); \
+        return GB_OPCODE_CYCLES(ctx);                                                    \
+    }
 
-    ctx->registers.ZERO_FLAG = sub == 0;
-    ctx->registers.N_FLAG = 1;
-    ctx->registers.H_CARRY_FLAG = ((a & 0xf) - (data & 0xf)) < 0;
-    ctx->registers.CARRY_FLAG = a < data;
-    
-    return 1; //TODO: CHECK TIMINGS    
-}
+GB_R8_LIST(GB_SUB_R_HANDLER)
 
 uint8_t GB_SUB_N(EmulationState *ctx)
 {
@@ -539,18 +491,10 @@ uint8_t GB_SUB_N(EmulationState *ctx)
         flags.H = 1 if carry_per_bit[3] else 0
         flags.C = 1 if carry_per_bit[7] else 0
     */
-
     const uint8_t n = GB_BusRead(ctx, ctx->registers.PC++);
-    const uint8_t a = ctx->registers.A; 
-    const int sub = ctx->registers.A - n;
-    ctx->registers.A = sub;
-
-    ctx->registers.ZERO_FLAG = sub == 0;
-    ctx->registers.N_FLAG = 1;
-    ctx->registers.H_CARRY_FLAG = ((a & 0xf) - (n & 0xf)) < 0;
-    ctx->registers.CARRY_FLAG = a < n;
-    
-    return 1; //TODO: CHECK TIMINGS!
+    ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, n, 0);
+
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_SUB_HL(EmulationState *ctx)
@@ -565,47 +509,29 @@ uint8_t GB_SUB_HL(EmulationState *ctx)
         flags.H = 1 if carry_per_bit[3] else 0
         flags.C = 1 if carry_per_bit[7] else 0
     */
+    const uint8_t data = GB_BusRead(ctx, ctx->registers.HL);
+    ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, data, 0);
 
-    const uint8_t n = GB_BusRead(ctx, ctx->registers.HL);
-    const uint8_t a = ctx->registers.A; 
-    const int sub =  a - n;
-    ctx->registers.A = sub;
-
-    
-    ctx->registers.ZERO_FLAG = sub == 0;
-    ctx->registers.N_FLAG = 1;
-    ctx->registers.H_CARRY_FLAG = ((a & 0xf) - (n & 0xf)) < 0;
-    ctx->registers.CARRY_FLAG = a < n;
-
-    //Used to set F reg 
-    return 1;//TODO: CHECK TIMINGS
+    return GB_OPCODE_CYCLES(ctx);
 }
 
-uint8_t GB_SBC_A_R(EmulationState *ctx)
-{
-    // encoding: 0b10011xxx
-    /*
-        result, carry_per_bit = A - flags.C - B
-        A = result
-        flags.Z = 1 if result == 0 else 0
-        flags.N = 1
-        flags.H = 1 if carry_per_bit[3] else 0
-        flags.C = 1 if carry_per_bit[7] else 0
-    */
-    const uint8_t rr = GB_GetReg8(ctx,(ctx->registers.INSTRUCTION & 0x07));
-    const uint8_t a = ctx->registers.A;
-    const uint8_t c = ctx->registers.CARRY_FLAG;
-    const int sub =  a - c - rr;
-    ctx->registers.A = sub;
-
-    ctx->registers.ZERO_FLAG = sub == 0;
-    ctx->registers.N_FLAG = 1;
-    ctx->registers.H_CARRY_FLAG = ((a & 0xf) - (rr & 0xf) - c) < 0;
-    ctx->registers.CARRY_FLAG = a < rr;
+// encoding: 0b10011xxx
+/*
+    result, carry_per_bit = A - flags.C - B
+    A = result
+    flags.Z = 1 if result == 0 else 0
+    flags.N = 1
+    flags.H = 1 if carry_per_bit[3] else 0
+    flags.C = 1 if carry_per_bit[7] else 0
+*/
+#define GB_SBC_A_R_HANDLER(r, reg)                                                                       \
+    uint8_t GB_SBC_A_##reg(EmulationState *ctx)                                                          \
+    {                                                                                                    \
+        ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, GB_R8_READ_##reg(ctx), GB_FlagCarry(ctx)); \
+        return GB_OPCODE_CYCLES(ctx);                                                                    \
+    }
 
-    //Used to set F reg 
-    return 1;//TODO: CHECK TIMINGS
-}
+GB_R8_LIST(GB_SBC_A_R_HANDLER)
 
 uint8_t GB_SBC_A_N(EmulationState *ctx)
 {
@@ -619,20 +545,10 @@ uint8_t GB_SBC_A_N(EmulationState *ctx)
         flags.H = 1 if carry_per_bit[3] else 0
         flags.C = 1 if carry_per_bit[7] else 0
     */
-
     const uint8_t n = GB_BusRead(ctx, ctx->registers.PC++);
-    const uint8_t a = ctx->registers.A;
-    const uint8_t c = ctx->registers.CARRY_FLAG;
-
-    const int sub =  a - c - n;
-    ctx->registers.A = sub;
+    ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, n, GB_FlagCarry(ctx));
 
-    ctx->registers.ZERO_FLAG = sub == 0;
-    ctx->registers.N_FLAG = 1;
-    ctx->registers.H_CARRY_FLAG = ((a & 0xf) - (n & 0xf) - c) < 0;
-    ctx->registers.CARRY_FLAG = sub < 0;
-    
-    return 1;//TODO: CHECK TIMINGS
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_SBC_A_HL(EmulationState *ctx) 
@@ -647,38 +563,29 @@ uint8_t GB_SBC_A_HL(EmulationState *ctx)
         flags.H = 1 if carry_per_bit[3] else 0
         flags.C = 1 if carry_per_bit[7] else 0
     */
+    const uint8_t data = GB_BusRead(ctx, ctx->registers.HL);
+    ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, data, GB_FlagCarry(ctx));
 
-    const uint8_t n = GB_BusRead(ctx, ctx->registers.HL);
-    
-    const uint8_t a = ctx->registers.A;
-    const int sub =  a - ctx->registers.CARRY_FLAG - n;
-
-    ctx->registers.A = sub;
-
-    ctx->registers.ZERO_FLAG = sub == 0;
-    ctx->registers.N_FLAG = 1;
-    ctx->registers.H_CARRY_FLAG = ((a & 0xf) - (n & 0xf) - ctx->registers.CARRY_FLAG) < 0;
-    ctx->registers.CARRY_FLAG = sub < 0;
-    
-    return 1; //TODO: CHECK TIMINGS
+    return GB_OPCODE_CYCLES(ctx);
 }
 
-uint8_t GB_AND_R(EmulationState *ctx)
-{
-    // encoding: 0b10100xxx
-    /*
+// encoding: 0b10100xxx
+/*
     result = A & B
     A = result
     flags.Z = 1 if result == 0 else 0
-    */
-    const uint8_t r = (ctx->registers.INSTRUCTION & 0x07);
-    uint8_t and = ctx->registers.A & GB_GetReg8(ctx, r);
-    ctx->registers.A = and;
+    flags.N = 0
+    flags.H = 1
+    flags.C = 0
+*/
+#define GB_AND_R_HANDLER(r, reg)                                                      \
+    uint8_t GB_AND_##reg(EmulationState *ctx)                                         \
+    {                                                                                 \
+        ctx->registers.A = GB_ALU_And8(ctx, ctx->registers.A, GB_R8_READ_##reg(ctx)); \
+        return GB_OPCODE_CYCLES(ctx);                                                 \
+    }
 
-    
-    ctx->registers.ZERO_FLAG = and == 0;
-    return 1; //TODO: CHECK TIMINGS    
-}
+GB_R8_LIST(GB_AND_R_HANDLER)
 
 uint8_t GB_AND_N(EmulationState *ctx)
 {
@@ -693,15 +600,9 @@ uint8_t GB_AND_N(EmulationState *ctx)
     flags.C = 0
     */
     const uint8_t n = GB_BusRead(ctx, ctx->registers.PC++);
-    uint8_t and = ctx->registers.A & n;
-    ctx->registers.A = and;
+    ctx->registers.A = GB_ALU_And8(ctx, ctx->registers.A, n);
 
-    ctx->registers.ZERO_FLAG = and == 0;
-    ctx->registers.N_FLAG = 0;
-    ctx->registers.H_CARRY_FLAG = 1;
-    ctx->registers.CARRY_FLAG = 0;
-
-    return 1;//TODO: CHECK TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_AND_HL(EmulationState *ctx)
@@ -717,21 +618,13 @@ uint8_t GB_AND_HL(EmulationState *ctx)
     flags.C = 0
     */
     const uint8_t data = GB_BusRead(ctx, ctx->registers.HL);
-    uint8_t and = ctx->registers.A & data;
-    ctx->registers.A = and;
+    ctx->registers.A = GB_ALU_And8(ctx, ctx->registers.A, data);
 
-    ctx->registers.ZERO_FLAG = and == 0;
-    ctx->registers.N_FLAG = 0;
-    ctx->registers.H_CARRY_FLAG = 1;
-    ctx->registers.CARRY_FLAG = 0;
-    
-    return 1;//TODO: CHECK TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
-uint8_t GB_XOR_R(EmulationState *ctx)
-{
-    // encoding: 0b10101xxx
-    /*
+// encoding: 0b10101xxx
+/*
     # example: XOR B
     if opcode == 0xB8:
     result = A ^ B
@@ -740,18 +633,15 @@ uint8_t GB_XOR_R(EmulationState *ctx)
     flags.N = 0
     flags.H = 0
     flags.C = 0
-    */
-    const uint8_t r = (ctx->registers.INSTRUCTION & 0x07);
-    uint8_t xor = ctx->registers.A ^ GB_GetReg8(ctx, r);
-    ctx->registers.A = xor;
-
-    ctx->registers.ZERO_FLAG = xor == 0;
-    ctx->registers.N_FLAG = 0;
-    ctx->registers.H_CARRY_FLAG = 0;
-    ctx->registers.CARRY_FLAG = 0;
+*/
+#define GB_XOR_R_HANDLER(r, reg)                                                      \
+    uint8_t GB_XOR_##reg(EmulationState *ctx)                                         \
+    {                                                                                 \
+        ctx->registers.A = GB_ALU_Xor8(ctx, ctx->registers.A, GB_R8_READ_##reg(ctx)); \
+        return GB_OPCODE_CYCLES(ctx);                                                 \
+    }
 
-    return 1; //TODO: CHECK TIMINGS 
-}
+GB_R8_LIST(GB_XOR_R_HANDLER)
 
 uint8_t GB_XOR_N(EmulationState *ctx)
 {
@@ -766,15 +656,9 @@ uint8_t GB_XOR_N(EmulationState *ctx)
         flags.C = 0
     */
     const uint8_t n = GB_BusRead(ctx, ctx->registers.PC++);
-    uint8_t xor = ctx->registers.A ^ n;
-    ctx->registers.A = xor;
-    
-    ctx->registers.ZERO_FLAG = xor == 0;
-    ctx->registers.N_FLAG = 0;
-    ctx->registers.H_CARRY_FLAG = 0;
-    ctx->registers.CARRY_FLAG = 0;
+    ctx->registers.A = GB_ALU_Xor8(ctx, ctx->registers.A, n);
 
-    return 1; //TODO: CHECK TIMINGS 
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_XOR_HL(EmulationState *ctx)
@@ -789,42 +673,29 @@ uint8_t GB_XOR_HL(EmulationState *ctx)
         flags.H = 0
         flags.C = 0
     */
-
     const uint8_t data = GB_BusRead(ctx, ctx->registers.HL);
-    uint8_t xor = ctx->registers.A ^ data;
-    ctx->registers.A = xor;
-   
-    ctx->registers.ZERO_FLAG = xor == 0;
-    ctx->registers.N_FLAG = 0;
-    ctx->registers.H_CARRY_FLAG = 0;
-    ctx->registers.CARRY_FLAG = 0;
+    ctx->registers.A = GB_ALU_Xor8(ctx, ctx->registers.A, data);
 
-    return 1; //TODO: CHECK TIMINGS    
+    return GB_OPCODE_CYCLES(ctx);
 }
 
-uint8_t GB_OR_R(EmulationState *ctx)
-{
-    // encoding: 0b10110xxx
-    /*
-        result = A | B
-        A = result
-        flags.Z = 1 if result == 0 else 0
-        flags.N = 0
-        flags.H = 0
-        flags.C = 0
-    */
-
-    const uint8_t r = (ctx->registers.INSTRUCTION & 0x07);
-    uint8_t or = ctx->registers.A | GB_GetReg8(ctx, r);
-    ctx->registers.A = or;
-    
-    ctx->registers.ZERO_FLAG = or == 0;
-    ctx->registers.N_FLAG = 0;
-    ctx->registers.H_CARRY_FLAG = 0;
-    ctx->registers.CARRY_FLAG = 0;
+// encoding: 0b10110xxx
+/*
+    result = A | B
+    A = result
+    flags.Z = 1 if result == 0 else 0
+    flags.N = 0
+    flags.H = 0
+    flags.C = 0
+*/
+#define GB_OR_R_HANDLER(r, reg)                                                      \
+    uint8_t GB_OR_##reg(EmulationState *ctx)                                         \
+    {                                                                                \
+        ctx->registers.A = GB_ALU_Or8(ctx, ctx->registers.A, GB_R8_READ_##reg(ctx)); \
+        return GB_OPCODE_CYCLES(ctx);                                                \
+    }
 
-    return 1; //TODO: CHECK TIMINGS
-}
+GB_R8_LIST(GB_OR_R_HANDLER)
 
 uint8_t GB_OR_N(EmulationState *ctx)
 {
@@ -839,15 +710,9 @@ uint8_t GB_OR_N(EmulationState *ctx)
         flags.C = 0
     */
     const uint8_t n = GB_BusRead(ctx, ctx->registers.PC++);
-    uint8_t or = ctx->registers.A | n;
-    ctx->registers.A = or;
+    ctx->registers.A = GB_ALU_Or8(ctx, ctx->registers.A, n);
 
-    ctx->registers.ZERO_FLAG = or == 0;
-    ctx->registers.N_FLAG = 0;
-    ctx->registers.H_CARRY_FLAG = 0;
-    ctx->registers.CARRY_FLAG = 0;
-
-    return 1; //TODO: CHECK TIMINGS
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_OR_HL(EmulationState *ctx)
@@ -863,39 +728,27 @@ uint8_t GB_OR_HL(EmulationState *ctx)
         flags.C = 0
     */
     const uint8_t data = GB_BusRead(ctx, ctx->registers.HL);
-    uint8_t or = ctx->registers.A | data;
-    ctx->registers.A = or;
-    
-    ctx->registers.ZERO_FLAG = or == 0;
-    ctx->registers.N_FLAG = 0;
-    ctx->registers.H_CARRY_FLAG = 0;
-    ctx->registers.CARRY_FLAG = 0;
-    
-    //Used to set F reg 
-    return 1;//TODO: CHECK TIMINGS
-}
+    ctx->registers.A = GB_ALU_Or8(ctx, ctx->registers.A, data);
 
-uint8_t GB_CP_R(EmulationState *ctx)
-{
-    // encoding: 0b10111xxx
-    /*
-        result, carry_per_bit = A - B
-        flags.Z = 1 if result == 0 else 0
-        flags.N = 1
-        flags.H = 1 if carry_per_bit[3] else 0
-        flags.C = 1 if carry_per_bit[7] else 0
-    */
-    const uint8_t r = GB_GetReg8(ctx, ctx->registers.INSTRUCTION & 0x07) ;
-    const uint8_t a = ctx->registers.A;
-    const uint8_t sub = a - r;
+    return GB_OPCODE_CYCLES(ctx);
+}
 
-    ctx->registers.ZERO_FLAG = sub == 0;
-    ctx->registers.N_FLAG = 1; 
-    ctx->registers.H_CARRY_FLAG = ((a & 0xf) - (r & 0xf)) < 0;  
-    ctx->registers.CARRY_FLAG = a < r;
+// encoding: 0b10111xxx
+/*
+    result, carry_per_bit = A - B
+    flags.Z = 1 if result == 0 else 0
+    flags.N = 1
+    flags.H = 1 if carry_per_bit[3] else 0
+    flags.C = 1 if carry_per_bit[7] else 0
+*/
+#define GB_CP_R_HANDLER(r, reg)                                       \
+    uint8_t GB_CP_##reg(EmulationState *ctx)                          \
+    {                                                                 \
+        GB_ALU_Sub8(ctx, ctx->registers.A, GB_R8_READ_##reg(ctx), 0); \
+        return GB_OPCODE_CYCLES(ctx);                                 \
+    }
 
-    return 1; //TODO: CHECK TIMING!
-}
+GB_R8_LIST(GB_CP_R_HANDLER)
 
 uint8_t GB_CP_N(EmulationState *ctx)
 {
@@ -908,17 +761,10 @@ uint8_t GB_CP_N(EmulationState *ctx)
         flags.H = 1 if carry_per_bit[3] else 0
         flags.C = 1 if carry_per_bit[7] else 0
     */
-
     const uint8_t n = GB_BusRead(ctx, ctx->registers.PC++);
-    const uint8_t a = ctx->registers.A;
-    const uint8_t sub =  a - n;
-
-    ctx->registers.ZERO_FLAG = sub == 0;
-    ctx->registers.N_FLAG = 1;
-    ctx->registers.H_CARRY_FLAG = ((a & 0xf) - (n & 0xf)) < 0;
-    ctx->registers.CARRY_FLAG = ctx->registers.A < n;
+    GB_ALU_Sub8(ctx, ctx->registers.A, n, 0);
 
-    return 1; //TODO: CHECK TIMINGS
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_CP_HL(EmulationState *ctx)
@@ -932,39 +778,28 @@ uint8_t GB_CP_HL(EmulationState *ctx)
         flags.H = 1 if carry_per_bit[3] else 0
         flags.C = 1 if carry_per_bit[7] else 0
     */
-
     const uint8_t data = GB_BusRead(ctx, ctx->registers.HL);
-    const uint8_t sub =  ctx->registers.A - data;
+    GB_ALU_Sub8(ctx, ctx->registers.A, data, 0);
 
-    ctx->registers.ZERO_FLAG = sub == 0;
-    ctx->registers.N_FLAG = 1; 
-    ctx->registers.H_CARRY_FLAG = sub >0x0F;  
-    ctx->registers.CARRY_FLAG = sub > 0xFF;
-    
-    return 1; // TODO: CHECK  TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
-uint8_t GB_INC_R(EmulationState *ctx)
-{
-    // encoding:0b00xxx100
-    /*
-        result, carry_per_bit = B + 1
-        B = result
-        flags.Z = 1 if result == 0 else 0
-        flags.N = 0
-        flags.H = 1 if carry_per_bit[3] else 0
-    */
-    uint8_t result = 0;
-    const uint8_t r = (ctx->registers.INSTRUCTION & 0x38) >> 3;
-    result = GB_GetReg8(ctx, r);
-    GB_SetReg8(ctx, r, ++result);
-    
-    ctx->registers.ZERO_FLAG = result == 0;
-    ctx->registers.N_FLAG = 0;
-    ctx->registers.H_CARRY_FLAG = result > 0x0F;
-    
-    return 1; // TODO: CHECK  TIMING...
-}
+// encoding:0b00xxx100
+/*
+    result, carry_per_bit = B + 1
+    B = result
+    flags.Z = 1 if result == 0 else 0
+    flags.N = 0
+    flags.H = 1 if carry_per_bit[3] else 0
+*/
+#define GB_INC_R_HANDLER(r, reg)                                         \
+    uint8_t GB_INC_##reg(EmulationState *ctx)                            \
+    {                                                                    \
+        GB_R8_WRITE_##reg(ctx, GB_ALU_Inc8(ctx, GB_R8_READ_##reg(ctx))); \
+        return GB_OPCODE_CYCLES(ctx);                                    \
+    }
+
+GB_R8_LIST(GB_INC_R_HANDLER)
 
 uint8_t GB_INC_HL(EmulationState *ctx)
 {
@@ -977,40 +812,28 @@ uint8_t GB_INC_HL(EmulationState *ctx)
         flags.N = 0
         flags.H = 1 if carry_per_bit[3] else 0
     */
-    uint8_t result = 0;
     const uint8_t data = GB_BusRead(ctx, ctx->registers.HL);
-    result = data + 1; 
-
-    GB_BusWrite(ctx, ctx->registers.HL, result);
+    GB_BusWrite(ctx, ctx->registers.HL, GB_ALU_Inc8(ctx, data));
 
-    ctx->registers.ZERO_FLAG = result == 0;
-    ctx->registers.N_FLAG = 0;
-    ctx->registers.H_CARRY_FLAG = result > 0x0F;
-    
-    return 1; // TODO: CHECK  TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
-uint8_t GB_DEC_R(EmulationState *ctx)
-{
-    // encoding: 0b00xxx101
-    /*
-        result, carry_per_bit = B - 1
-        B = result
-        flags.Z = 1 if result == 0 else 0
-        flags.N = 1
-        flags.H = 1 if carry_per_bit[3] else 0
-    */
-    uint16_t result = 0;
-    const uint8_t r = (ctx->registers.INSTRUCTION & 0x38) >> 3;
-    result = GB_GetReg8(ctx, r) - 1;
-    GB_SetReg8(ctx, r, result & 0xFF);
+// encoding: 0b00xxx101
+/*
+    result, carry_per_bit = B - 1
+    B = result
+    flags.Z = 1 if result == 0 else 0
+    flags.N = 1
+    flags.H = 1 if carry_per_bit[3] else 0
+*/
+#define GB_DEC_R_HANDLER(r, reg)                                         \
+    uint8_t GB_DEC_##reg(EmulationState *ctx)                            \
+    {                                                                    \
+        GB_R8_WRITE_##reg(ctx, GB_ALU_Dec8(ctx, GB_R8_READ_##reg(ctx))); \
+        return GB_OPCODE_CYCLES(ctx);                                    \
+    }
 
-    ctx->registers.ZERO_FLAG = result == 0;
-    ctx->registers.N_FLAG = 1;
-    ctx->registers.H_CARRY_FLAG = (result & 0x0F) == 0x0F;
-        
-    return 1; // TODO: CHECK  TIMING...
-}
+GB_R8_LIST(GB_DEC_R_HANDLER)
 
 uint8_t GB_DEC_HL(EmulationState *ctx)
 {
@@ -1023,28 +846,28 @@ uint8_t GB_DEC_HL(EmulationState *ctx)
         flags.N = 1
         flags.H = 1 if carry_per_bit[3] else 0
     */
-    uint8_t result = 0;
     const uint8_t data = GB_BusRead(ctx, ctx->registers.HL);
-    
-    result = data - 1; 
-    GB_BusWrite(ctx, ctx->registers.HL, result);
+    GB_BusWrite(ctx, ctx->registers.HL, GB_ALU_Dec8(ctx, data));
 
-    ctx->registers.ZERO_FLAG = result == 0;
-    ctx->registers.N_FLAG = 1;
-    ctx->registers.H_CARRY_FLAG = (result & 0x0F) == 0x0F;
-        
-    return 1; // TODO: CHECK  TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_DAA(EmulationState *ctx)
 {
     // encoding: 0b00100111
     /*
-      just flags???
+      A = BCD correction of A (after ADD: +0x06/+0x60, after SUB: -0x06/-0x60)
+      flags.Z = A == 0
+      flags.H = 0
+      flags.C = correction of the high digit (kept after SUB)
     */
-    MNE_Log("[DAA] [NOT IMPLEMENTED]\n");
+    GB_FlagsSync(ctx); // Needs N, H and C
+    const uint16_t entry = gb_daa_table[GB_DAA_INDEX(ctx->registers.A, ctx->registers.N_FLAG, ctx->registers.H_CARRY_FLAG, ctx->registers.CARRY_FLAG)];
+
+    ctx->registers.A = entry & 0xFF;
+    GB_FlagsWrite(ctx, entry >> 8);
 
-    return 1; // TODO: CHECK  TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_CPL(EmulationState *ctx)
@@ -1057,10 +880,11 @@ uint8_t GB_CPL(EmulationState *ctx)
     */
     ctx->registers.A = ~ctx->registers.A;
 
+    GB_FlagsSync(ctx);
     ctx->registers.N_FLAG = 1; 
     ctx->registers.H_CARRY_FLAG = 1; 
 
-    return 1; // TODO: CHECK  TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 // 16 BIT ALU INSTRUCTIONS
@@ -1084,11 +908,12 @@ uint8_t GB_ADD_HL_RR(EmulationState *ctx)
 
     uint32_t result = ctx->registers.HL + rr_value;
 
+    GB_FlagsSync(ctx);
     ctx->registers.H_CARRY_FLAG = (ctx->registers.HL  & 0xfff) + (rr_value & 0xfff) > 0xfff;
     ctx->registers.CARRY_FLAG = result > 0xFFFF;
 
     ctx->registers.HL = result & 0xFFFF;
-    return 1; // TODO: CHECK  TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_INC_RR(EmulationState *ctx)
@@ -1101,7 +926,7 @@ uint8_t GB_INC_RR(EmulationState *ctx)
     const uint16_t rrInc = GB_GetReg16(ctx, rr, REG16_MODE_SP) + 1;
     GB_SetReg16(ctx, rr, rrInc, REG16_MODE_SP);
 
-    return 1; // TODO: CHECK  TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_DEC_RR(EmulationState *ctx)
@@ -1114,7 +939,7 @@ uint8_t GB_DEC_RR(EmulationState *ctx)
     const uint16_t rrDec = GB_GetReg16(ctx, rr, REG16_MODE_SP) - 1;
     GB_SetReg16(ctx, rr, rrDec, REG16_MODE_SP);
 
-    return 1; // TODO: CHECK  TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_ADD_SP_DD(EmulationState *ctx)
@@ -1127,7 +952,7 @@ uint8_t GB_ADD_SP_DD(EmulationState *ctx)
     const short sum =  ctx->registers.SP + dd; // TODO: VERIFY CONVERSION
     ctx->registers.SP = sum;
     
-    return 1; // TODO: CHECK  TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_LD_HL_SP_PLUS_DD(EmulationState *ctx)
@@ -1143,7 +968,7 @@ uint8_t GB_LD_HL_SP_PLUS_DD(EmulationState *ctx)
 
     //Used to set F reg 
     
-    return 1; // TODO: CHECK  TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 // ROTATE AND SHIFT INSTRUCTIONS
@@ -1153,11 +978,11 @@ uint8_t GB_RLCA(EmulationState *ctx)
     /*
         rotate A left trough carry
     */   
-   uint16_t shifted = ctx->registers.A << 1 <<  ctx->registers.CARRY_FLAG;
+   uint16_t shifted = ctx->registers.A << 1 <<  GB_FlagCarry(ctx);
    ctx->registers.A = shifted;
 
     
-    return 1; // TODO: CHECK  TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_RLA(EmulationState *ctx)
@@ -1170,11 +995,12 @@ uint8_t GB_RLA(EmulationState *ctx)
    uint16_t shifted = ctx->registers.A << 1;
    ctx->registers.A = shifted;
    
+    GB_FlagsSync(ctx);
     ctx->registers.ZERO_FLAG = 0;
     ctx->registers.H_CARRY_FLAG = 0;
     ctx->registers.CARRY_FLAG = shifted > 0xFF;
 
-    return 1; // TODO: CHECK  TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_RRCA(EmulationState *ctx)
@@ -1184,6 +1010,7 @@ uint8_t GB_RRCA(EmulationState *ctx)
         rotate right A through carry
     */
     
+    GB_FlagsSync(ctx);
     uint16_t shifted = ctx->registers.A >> 1 >> ctx->registers.CARRY_FLAG;
     ctx->registers.A = shifted;
 
@@ -1191,7 +1018,7 @@ uint8_t GB_RRCA(EmulationState *ctx)
     ctx->registers.H_CARRY_FLAG = 0;
     ctx->registers.CARRY_FLAG = shifted > 0xFF;
     
-    return 1; // TODO: CHECK  TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_RRA(EmulationState *ctx)
@@ -1204,174 +1031,207 @@ uint8_t GB_RRA(EmulationState *ctx)
     ctx->registers.A = shifted;
 
     
+    GB_FlagsSync(ctx);
     ctx->registers.ZERO_FLAG = 0;
     ctx->registers.ZERO_FLAG = 0;
     ctx->registers.H_CARRY_FLAG = 0;
     ctx->registers.CARRY_FLAG = shifted > 0xFF;
     
-    return 1; // TODO: CHECK  TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 // CB PREFIX INSTRUCTIONS STARTS HERE!!!
 // SINGLE BIT OPERATIONS (CB PREFIX)
+// Operands are pre-decoded on the CB dispatch table (see GB_BuildCBDispatchTable), GB_CB_PREFIX resolves the operand byte
 
-uint8_t GB_RLC_R(EmulationState *ctx)
+void GB_RLC_R(EmulationState *ctx, uint8_t *operand, const uint8_t b)
 {
-    // encoding: CB 0x 
+    // encoding: CB 00-07
     /*
-        rotate left r trough carry
+        rotate left r (bit 7 goes to carry and bit 0)
     */
-    MNE_Log("[GB_RLC_R]\n");
+    uint8_t rValue = *operand;
+    const uint8_t carryOut = rValue >> 7;
+    rValue = (rValue << 1) | carryOut;
 
-   return 1; // TODO: CHECK  TIMING...
-}
+    *operand = rValue;
 
+    GB_FlagsSync(ctx);
+    ctx->registers.ZERO_FLAG = rValue == 0;
+    ctx->registers.N_FLAG = 0;
+    ctx->registers.H_CARRY_FLAG = 0;
+    ctx->registers.CARRY_FLAG = carryOut;
+}
 
-uint8_t GB_RL_R(EmulationState *ctx)
+void GB_RL_R(EmulationState *ctx, uint8_t *operand, const uint8_t b)
 {
-    // encoding: CB 1x
-    MNE_Log("[GB_RL_R]\n");
-
-    uint8_t r = ctx->registers.INSTRUCTION & 0x07;
-    uint8_t rValue = GB_GetReg8(ctx, r);
+    // encoding: CB 10-17
+    /*
+        rotate left r trough carry
+    */
+    uint8_t rValue = *operand;
+    GB_FlagsSync(ctx);
     uint8_t carryIn = ctx->registers.CARRY_FLAG;
 
     uint8_t carryOut = (rValue & 0x80) >> 7;
     rValue = (rValue << 1) | carryIn;       
 
     ctx->registers.CARRY_FLAG = carryOut;
-    GB_SetReg8(ctx, r, rValue);
+    *operand = rValue;
 
     ctx->registers.ZERO_FLAG = rValue == 0;
     ctx->registers.H_CARRY_FLAG = 0;
     ctx->registers.N_FLAG = 0;
-
-   return 1; // TODO: CHECK  TIMING...
 }
 
-uint8_t GB_RRC_R(EmulationState *ctx)
+void GB_RRC_R(EmulationState *ctx, uint8_t *operand, const uint8_t b)
 {
-    // encoding: CB 0x
+    // encoding: CB 08-0F
     /*
-        rotate right r
+        rotate right r (bit 0 goes to carry and bit 7)
     */
-    MNE_Log("[GB_RRC_R][NOT IMPLEMENTED]\n");
-
-   return 1; // TODO: CHECK  TIMING...
-}
+    uint8_t rValue = *operand;
+    const uint8_t carryOut = rValue & 0x01;
+    rValue = (rValue >> 1) | (carryOut << 7);
 
+    *operand = rValue;
 
+    GB_FlagsSync(ctx);
+    ctx->registers.ZERO_FLAG = rValue == 0;
+    ctx->registers.N_FLAG = 0;
+    ctx->registers.H_CARRY_FLAG = 0;
+    ctx->registers.CARRY_FLAG = carryOut;
+}
 
-uint8_t GB_RR_R(EmulationState *ctx)
+void GB_RR_R(EmulationState *ctx, uint8_t *operand, const uint8_t b)
 {
-    // encoding: CB 1x
+    // encoding: CB 18-1F
     /*
         rotate right through carry R
     */
-    MNE_Log("[GB_RR_R][NOT IMPLEMENTED]\n");
-
-   return 1; // TODO: CHECK  TIMING...
-}
+    uint8_t rValue = *operand;
+    const uint8_t carryOut = rValue & 0x01;
+    GB_FlagsSync(ctx);
+    rValue = (rValue >> 1) | (ctx->registers.CARRY_FLAG << 7);
 
+    *operand = rValue;
 
+    ctx->registers.ZERO_FLAG = rValue == 0;
+    ctx->registers.N_FLAG = 0;
+    ctx->registers.H_CARRY_FLAG = 0;
+    ctx->registers.CARRY_FLAG = carryOut;
+}
 
-uint8_t GB_SLA_R(EmulationState *ctx)
+void GB_SLA_R(EmulationState *ctx, uint8_t *operand, const uint8_t b)
 {
-    // encoding: CB 2x
+    // encoding: CB 20-27
     /*
         shift left arithmetic (b0=0) r
     */
-    MNE_Log("[GB_SLA_R][NOT IMPLEMENTED]\n");
+    uint8_t rValue = *operand;
+    const uint8_t carryOut = rValue >> 7;
+    rValue = rValue << 1;
 
-   return 1; // TODO: CHECK  TIMING...
-}
+    *operand = rValue;
 
+    GB_FlagsSync(ctx);
+    ctx->registers.ZERO_FLAG = rValue == 0;
+    ctx->registers.N_FLAG = 0;
+    ctx->registers.H_CARRY_FLAG = 0;
+    ctx->registers.CARRY_FLAG = carryOut;
+}
 
-uint8_t GB_SWAP_R(EmulationState *ctx)
+void GB_SWAP_R(EmulationState *ctx, uint8_t *operand, const uint8_t b)
 {
-    // encoding: CB 3x
+    // encoding: CB 30-37
     /*
         exchange low/hi-nibble r
     */
-    MNE_Log("[GB_SWAP_R][NOT IMPLEMENTED]\n");
+    uint8_t rValue = *operand;
+    rValue = (rValue << 4) | (rValue >> 4);
 
-   return 1; // TODO: CHECK  TIMING...
-}
+    *operand = rValue;
 
+    GB_FlagsSync(ctx);
+    ctx->registers.ZERO_FLAG = rValue == 0;
+    ctx->registers.N_FLAG = 0;
+    ctx->registers.H_CARRY_FLAG = 0;
+    ctx->registers.CARRY_FLAG = 0;
+}
 
-uint8_t GB_SRA_R(EmulationState *ctx)
+void GB_SRA_R(EmulationState *ctx, uint8_t *operand, const uint8_t b)
 {
-    // encoding: CB 2x
+    // encoding: CB 28-2F
     /*
         shift right arithmetic (b7=b7) r
     */
-    MNE_Log("[GB_SRA_R][NOT IMPLEMENTED]\n");
+    uint8_t rValue = *operand;
+    const uint8_t carryOut = rValue & 0x01;
+    rValue = (rValue >> 1) | (rValue & 0x80);
 
-   return 1; // TODO: CHECK  TIMING...
-}
+    *operand = rValue;
 
+    GB_FlagsSync(ctx);
+    ctx->registers.ZERO_FLAG = rValue == 0;
+    ctx->registers.N_FLAG = 0;
+    ctx->registers.H_CARRY_FLAG = 0;
+    ctx->registers.CARRY_FLAG = carryOut;
+}
 
-uint8_t GB_SRL_R(EmulationState *ctx)
+void GB_SRL_R(EmulationState *ctx, uint8_t *operand, const uint8_t b)
 {
-    // encoding: CB 3x 
+    // encoding: CB 38-3F
     /*
         shift right logical (b7=0) r
     */
-    MNE_Log("[GB_SRL_R][NOT IMPLEMENTED]\n");
+    uint8_t rValue = *operand;
+    const uint8_t carryOut = rValue & 0x01;
+    rValue = rValue >> 1;
 
-   return 1; // TODO: CHECK  TIMING...
-}
+    *operand = rValue;
 
+    GB_FlagsSync(ctx);
+    ctx->registers.ZERO_FLAG = rValue == 0;
+    ctx->registers.N_FLAG = 0;
+    ctx->registers.H_CARRY_FLAG = 0;
+    ctx->registers.CARRY_FLAG = carryOut;
+}
 
-uint8_t GB_CB_BIT_N_R(EmulationState *ctx)
+void GB_CB_BIT_N_R(EmulationState *ctx, uint8_t *operand, const uint8_t b)
 {
+    // encoding: CB 40-7F
     /*
         test bit n of r
+        flags.Z = 1 if bit n == 0 else 0
+        flags.N = 0
+        flags.H = 1
     */
-    // encoding: 0xCB 0x40
-    MNE_Log("[GB_CB_BIT_N_R]\n");
-    uint8_t r8 = ctx->registers.INSTRUCTION & 0x07;
-    uint8_t b3 = ctx->registers.INSTRUCTION & 0x38 >> 3;
-    uint8_t bitTest = ((GB_GetReg8(ctx, r8) >> b3) & 0x01) == 0x00;
+    const uint8_t bitTest = ((*operand >> b) & 0x01) == 0x00;
 
+    GB_FlagsSync(ctx);
     ctx->registers.ZERO_FLAG = bitTest;
-    ctx->registers.CARRY_FLAG = bitTest > 0x0F;    
-
-   return 1; // TODO: CHECK  TIMING...
+    ctx->registers.N_FLAG = 0;
+    ctx->registers.H_CARRY_FLAG = 1;
 }   
 
-uint8_t GB_CB_RES_N_R(EmulationState *ctx)
+void GB_CB_RES_N_R(EmulationState *ctx, uint8_t *operand, const uint8_t b)
 {
-    // encoding: CB xx
+    // encoding: CB 80-BF
     /*
         reset bit n of r
     */
-    MNE_Log("[GB_CB_RES_N_R]\n");
-
-    uint8_t r8 = ctx->registers.INSTRUCTION & 0x07;
-    uint8_t b3 = ctx->registers.INSTRUCTION & 0x38 >> 3;
-
-    uint8_t clearBit = ((GB_GetReg8(ctx, r8)) & ~(1 << b3));
-    GB_SetReg8(ctx, r8, clearBit);
-
-    return 1; // TODO: CHECK  TIMING...
+    const uint8_t clearBit = *operand & ~(1 << b);
+    *operand = clearBit;
 }
 
-uint8_t GB_CB_SET_N_R(EmulationState *ctx)
+void GB_CB_SET_N_R(EmulationState *ctx, uint8_t *operand, const uint8_t b)
 {
-    // encoding: CB xx
+    // encoding: CB C0-FF
     /*
         set bit n
     */
-    MNE_Log("[GB_CB_SET_N_R]\n");
-
-    uint8_t r8 = ctx->registers.INSTRUCTION & 0x07;
-    uint8_t b3 = ctx->registers.INSTRUCTION & 0x38 >> 3;
-
-    uint8_t setBit = ((GB_GetReg8(ctx, r8)) | (1 << b3));
-    GB_SetReg8(ctx, r8, setBit);
-
-    return 1; // TODO: CHECK  TIMING...
+    const uint8_t setBit = *operand | (1 << b);
+    *operand = setBit;
 }
 
 // CPU CONTROL INSTRUCTIONS
@@ -1383,11 +1243,12 @@ uint8_t GB_CCF(EmulationState *ctx)
         flags.H = 0
         flags.C = ~flags.C
     */
+    GB_FlagsSync(ctx);
     ctx->registers.N_FLAG = 0;
     ctx->registers.H_CARRY_FLAG = 0;
-    ctx->registers.CARRY_FLAG = ~ctx->registers.CARRY_FLAG;     
+    ctx->registers.CARRY_FLAG = !ctx->registers.CARRY_FLAG;
 
-    return 1;
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_SCF(EmulationState *ctx)
@@ -1399,11 +1260,12 @@ uint8_t GB_SCF(EmulationState *ctx)
         flags.C = 1
     */
     
+    GB_FlagsSync(ctx);
     ctx->registers.N_FLAG = 0;
     ctx->registers.H_CARRY_FLAG = 0;
     ctx->registers.CARRY_FLAG = 1;   
 
-   return 1;
+   return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_NOP(EmulationState *ctx)
@@ -1412,7 +1274,7 @@ uint8_t GB_NOP(EmulationState *ctx)
     /*
         no operation
     */
-   return 4;
+   return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_HALT(EmulationState *ctx)
@@ -1421,8 +1283,9 @@ uint8_t GB_HALT(EmulationState *ctx)
     /*
         halt until interrupt occurs (low power)
     */
+   ctx->halted = 1; // The emulation loop skips to the next scheduler event until IE & IF != 0 (GB_StepCpu)
    
-   return 0; // stop the emulation by returning 0
+   return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_STOP(EmulationState *ctx)
@@ -1431,8 +1294,11 @@ uint8_t GB_STOP(EmulationState *ctx)
     /*
         low power standby mode (VERY low power)
     */
+   // TODO: ONLY THE JOYPAD SHOULD WAKE UP THE CPU (AND DIV/LCD STOP), FOR NOW IT SLEEPS SAME AS HALT
+   ctx->registers.PC++; // skip the 00 byte
+   ctx->halted = 1;
 
-   return 0; // stop the emulation by returning 0
+   return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_DI(EmulationState *ctx)
@@ -1443,7 +1309,7 @@ uint8_t GB_DI(EmulationState *ctx)
     */
    ctx->ime = 0x00;
    
-   return 1;
+   return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_EI(EmulationState *ctx)
@@ -1454,7 +1320,7 @@ uint8_t GB_EI(EmulationState *ctx)
     */
    ctx->ime = 0x01;
 
-   return 1;
+   return GB_OPCODE_CYCLES(ctx);
 }
 
 // JUMP INSTRUCTIONS
@@ -1474,7 +1340,7 @@ uint8_t GB_JP_NN(EmulationState *ctx)
     const uint8_t nn_msb = GB_BusRead(ctx, ctx->registers.PC++);
     ctx->registers.PC = (uint16_t)(nn_lsb | (nn_msb << 8));
 
-   return 4;
+   return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_JP_HL(EmulationState *ctx)
@@ -1488,7 +1354,7 @@ uint8_t GB_JP_HL(EmulationState *ctx)
 
    ctx->registers.PC = ctx->registers.HL;
    
-   return 1;
+   return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_JP_CC_NN(EmulationState *ctx)
@@ -1514,10 +1380,11 @@ uint8_t GB_JP_CC_NN(EmulationState *ctx)
         const uint8_t nn_lsb = GB_BusRead(ctx, ctx->registers.PC++);
         const uint8_t nn_msb = GB_BusRead(ctx, ctx->registers.PC++);
         ctx->registers.PC = (uint16_t)(nn_lsb | (nn_msb << 8));
-        return 4;
+        return GB_OPCODE_CYCLES(ctx);
     }
 
-    return 3; // TODO: CHECK  TIMING...
+    ctx->registers.PC += 2; // skip nn
+    return GB_OPCODE_CYCLES_NOT_TAKEN(ctx);
 }
 
 uint8_t GB_JR_E(EmulationState *ctx)
@@ -1532,7 +1399,7 @@ uint8_t GB_JR_E(EmulationState *ctx)
     const int8_t nn_signed = GB_BusRead(ctx, ctx->registers.PC++);
     ctx->registers.PC += nn_signed;
 
-   return 3; 
+   return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_JR_CC_E(EmulationState *ctx)
@@ -1550,10 +1417,10 @@ uint8_t GB_JR_CC_E(EmulationState *ctx)
     if (GB_ResolveCondition(ctx, cc))
     {
         ctx->registers.PC += nn_signed;
-        return 3;
+        return GB_OPCODE_CYCLES(ctx);
     }
 
-    return 2; // TODO: CHECK  TIMING...
+    return GB_OPCODE_CYCLES_NOT_TAKEN(ctx);
 }
 
 uint8_t GB_CALL_NN(EmulationState *ctx)
@@ -1581,7 +1448,7 @@ uint8_t GB_CALL_NN(EmulationState *ctx)
     GB_BusWrite(ctx,ctx->registers.SP, ctx->registers.PC & 0xFF);
     ctx->registers.PC = addr;
 
-    return 6;
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_CALL_CC_NN(EmulationState *ctx)
@@ -1616,10 +1483,11 @@ uint8_t GB_CALL_CC_NN(EmulationState *ctx)
         GB_BusWrite(ctx, ctx->registers.SP--, ctx->registers.PC >> 8);
         GB_BusWrite(ctx, ctx->registers.SP, ctx->registers.PC & 0xFF);
         ctx->registers.PC = addr;
-        return 6;
+        return GB_OPCODE_CYCLES(ctx);
     }
 
-    return 3;
+    ctx->registers.PC += 2; // skip nn
+    return GB_OPCODE_CYCLES_NOT_TAKEN(ctx);
 }
 
 uint8_t GB_RET(EmulationState *ctx)
@@ -1634,7 +1502,7 @@ uint8_t GB_RET(EmulationState *ctx)
     const uint8_t msb = GB_BusRead(ctx, ctx->registers.SP++);
 
     ctx->registers.PC = (uint16_t)(lsb | (msb << 8));
-    return 4;
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_RET_CC(EmulationState *ctx)
@@ -1658,10 +1526,10 @@ uint8_t GB_RET_CC(EmulationState *ctx)
         const uint8_t msb = GB_BusRead(ctx, ctx->registers.SP++);
 
         ctx->registers.PC = (uint16_t)(lsb | (msb << 8));
-        return 5;
+        return GB_OPCODE_CYCLES(ctx);
     }
 
-    return 2;
+    return GB_OPCODE_CYCLES_NOT_TAKEN(ctx);
 }
 
 uint8_t GB_RETI(EmulationState *ctx)
@@ -1681,12 +1549,11 @@ uint8_t GB_RETI(EmulationState *ctx)
     ctx->registers.PC = (uint16_t)(lsb | (msb << 8));
     ctx->ime = 0x01;
 
-    return 4;
+    return GB_OPCODE_CYCLES(ctx);
 }
 
 uint8_t GB_RST_N(EmulationState *ctx)
 {
-    // TODO: IMPLEMENT INTERRUPTS!!!
     /*
        [call to 00,08,10,18,20,28,30,38 interrupt vectors]
         Opcode 0b11xxx111/various
@@ -1700,19 +1567,24 @@ uint8_t GB_RST_N(EmulationState *ctx)
             write_memory(addr=SP, data=lsb(PC))
             PC = unsigned_16(lsb=n, msb=0x00)
     */
+    const uint8_t n = ctx->registers.INSTRUCTION & 0x38;
+    ctx->registers.SP--;
+
+    GB_BusWrite(ctx, ctx->registers.SP--, ctx->registers.PC >> 8);
+    GB_BusWrite(ctx, ctx->registers.SP, ctx->registers.PC & 0xFF);
+    ctx->registers.PC = n;
 
-    return 1; // TODO: CHECK  TIMING...
+    return GB_OPCODE_CYCLES(ctx);
 }
 
-//TODO: MAKE MORE READABLE THIS FUNCTION AND AVOID MOVING CODE INTO FUNCTIONS (TO AVOID STACK OVERFLOWS ON MCU'S)
-uint8_t GB_CB_PREFIX(EmulationState *ctx)
-{
-    const uint8_t cbInstr = GB_BusRead(ctx, ctx->registers.PC++);
-    
-    MNE_Log("%-32s PC:[0x%02X] CB_PREFIX_HANDLER: ", opcode_cb_names[cbInstr], ctx->registers.PC - 1);
+static GameBoyCBInstruction s_gb_cb_dispatch_table[GB_CB_INSTRUCTION_SET_LENGHT];
 
-    ctx->registers.INSTRUCTION = cbInstr;
+// Register operand of a CB entry (offset in the context, resolved by GB_CB_PREFIX)
+#define GB_CB_OPERAND(reg) (uint16_t) offsetof(EmulationState, registers.reg)
 
+// Internal, only built by GB_BuildDispatchTableOnce (GB_Emulation.c) under pthread_once
+void GB_BuildCBDispatchTable()
+{
     /*
         CB prefix instructions:
         there are two groups and they are grouped by mask (0xC0 and 0xF8)
@@ -1737,63 +1609,61 @@ uint8_t GB_CB_PREFIX(EmulationState *ctx)
         srl r8       0  0  1  1  1      Operand (r8) | MASK:0xF8, BASE-OP: 0x38
 
     */
-    
-    if ((cbInstr & 0xC0) != 0x00)
+    static const cbInstructionFnPtrGb shiftGroup[8] = {
+        GB_RLC_R, GB_RRC_R, GB_RL_R, GB_RR_R, GB_SLA_R, GB_SRA_R, GB_SWAP_R, GB_SRL_R
+    };
+    static const cbInstructionFnPtrGb bitGroup[4] = {
+        NULL, GB_CB_BIT_N_R, GB_CB_RES_N_R, GB_CB_SET_N_R
+    };
+
+    // r8 encoding (B,C,D,E,H,L,(HL),A) to the operand register
+    static const uint16_t operands[8] = {
+        GB_CB_OPERAND(B), GB_CB_OPERAND(C), GB_CB_OPERAND(D), GB_CB_OPERAND(E),
+        GB_CB_OPERAND(H), GB_CB_OPERAND(L), GB_CB_OPERAND_HL, GB_CB_OPERAND(A)
+    };
+
+    for (uint16_t cbOpcode = 0x00; cbOpcode < GB_CB_INSTRUCTION_SET_LENGHT; cbOpcode++)
     {
-        uint8_t masked = cbInstr & 0xC0;
-        switch (masked)
-        {
-        case 0x40:
-            GB_CB_BIT_N_R(ctx);
-            break;
-        case 0x80:
-            GB_CB_RES_N_R(ctx);
-            break;
-        case 0xC0:
-            GB_CB_SET_N_R(ctx);
-            break;
-        default:
-            MNE_Log("[CB PREFIX SUB MASK 0xC8 BASE OP CODE NOT FOUND, MASKED VALUE [%04X]", masked);
-            return 0;
-            break;
-        }
+        GameBoyCBInstruction *entry = &s_gb_cb_dispatch_table[cbOpcode];
+        const uint8_t group = (cbOpcode & 0xC0) >> 6;
+
+        entry->operand = operands[cbOpcode & 0x07];
+        entry->b = (cbOpcode & 0x38) >> 3;
+        entry->handler = group == 0 ? shiftGroup[entry->b] : bitGroup[group];
+        entry->writeBack = group != 1; // BIT only reads
+
+        entry->cycles = gb_cb_opcodes_cycles[cbOpcode];
     }
-    else
+}
+
+const GameBoyCBInstruction* GB_DecodeCBInstruction(const uint8_t cbOpcode)
+{
+    return &s_gb_cb_dispatch_table[cbOpcode];
+}
+
+uint8_t GB_CB_PREFIX(EmulationState *ctx)
+{
+    const uint8_t cbInstr = GB_BusRead(ctx, ctx->registers.PC++);
+    const GameBoyCBInstruction *instruction = &s_gb_cb_dispatch_table[cbInstr];
+
+    ctx->registers.INSTRUCTION = cbInstr;
+
+    if (instruction->operand != GB_CB_OPERAND_HL)
+    {
+        instruction->handler(ctx, (uint8_t *) ctx + instruction->operand, instruction->b);
+        return instruction->cycles;
+    }
+
+    // (HL): the handler works on a copy of the byte
+    uint8_t data = GB_BusRead(ctx, ctx->registers.HL);
+    instruction->handler(ctx, &data, instruction->b);
+
+    if (instruction->writeBack)
     {
-        uint8_t masked = cbInstr & 0xF8;
-        switch (masked)
-        {
-        case 0X00:
-            GB_RLC_R(ctx);
-            break;
-        case 0x08:
-            GB_RRC_R(ctx);
-            break;
-        case 0x10:
-            GB_RL_R(ctx);
-            break;
-        case 0x18:
-            GB_RR_R(ctx);
-            break;
-        case 0x20:
-            GB_SLA_R(ctx);
-            break;
-        case 0x28:
-            GB_SRA_R(ctx);
-            break;
-        case 0x30:
-            GB_SWAP_R(ctx);
-            break;
-        case 0x38:
-            GB_SRL_R(ctx);
-            break;
-        default:
-            MNE_Log("[CB PREFIX SUB MASK 0xF8 BASE OP CODE NOT FOUND, MASKED VALUE [%04X]", masked);
-            return 0;
-        }
+        GB_BusWrite(ctx, ctx->registers.HL, data);
     }
 
-    return 1;
+    return instruction->cycles;
 }
 
 uint8_t GB_ResolveCondition(const EmulationState *ctx, uint8_t cc)
@@ -1801,16 +1671,16 @@ uint8_t GB_ResolveCondition(const EmulationState *ctx, uint8_t cc)
     switch (cc)
     {
     case COND_NZ:
-        return !ctx->registers.ZERO_FLAG;
+        return !GB_FlagZero(ctx);
     case COND_Z:
-        return ctx->registers.ZERO_FLAG;
+        return GB_FlagZero(ctx);
     case COND_NC:
-        return !ctx->registers.CARRY_FLAG;
+        return !GB_FlagCarry(ctx);
     case COND_C:
-        return ctx->registers.CARRY_FLAG;
+        return GB_FlagCarry(ctx);
 
     default:
-        MNE_Log("Cannot resolve CC condition(unknow value)");
+        GB_Log(CPU, ERROR, "Cannot resolve CC condition(unknow value)\n");
     }
     return 0;
 }
@@ -0,0 +1,1553 @@
+#include <SOC/GB_CPU_Threaded.h>
+#include <SOC/GB_CPU.h>
+#include <SOC/GB_Bus.h>
+#include <SOC/GB_ALU.h>
+#include <SOC/GB_Opcodes.h>
+#include <Emulation/GB_Emulation.h>
+
+#if defined(__GNUC__)
+
+// Register access with the register index known at compile time (encoding order B,C,D,E,H,L,(HL),A; A skips F same as GB_GetReg8)
+#define GB_T_REG8(r)  ctx->registers.FILE_8[(r) == GB_A_OFFSET ? (r) - 1 : (r)]
+#define GB_T_REG16(rr) (*((rr) == 3 ? &ctx->registers.SP : &ctx->registers.FILE_16[(rr)]))
+
+// Flags are lazy (GB_ALU.h), conditions only evaluate the flag they test
+#define GB_T_CONDITION(cc) ((cc) == COND_NZ ? !GB_FlagZero(ctx) :  \
+                            (cc) == COND_Z  ?  GB_FlagZero(ctx) :  \
+                            (cc) == COND_NC ? !GB_FlagCarry(ctx) : \
+                                               GB_FlagCarry(ctx))
+
+#define GB_T_READ(address)         GB_BusRead(ctx, (address))
+#define GB_T_WRITE(address, value) GB_BusWrite(ctx, (address), (value))
+#define GB_T_FETCH()               GB_BusRead(ctx, ctx->registers.PC++)
+
+#define GB_T_FETCH16(dst)                                    \
+    do                                                       \
+    {                                                        \
+        const uint8_t lsb_ = GB_T_FETCH();                   \
+        const uint8_t msb_ = GB_T_FETCH();                   \
+        (dst) = (uint16_t)(lsb_ | (msb_ << 8));              \
+    } while (0)
+
+#define GB_T_PUSH(value)                                     \
+    do                                                       \
+    {                                                        \
+        const uint16_t value_ = (value);                     \
+        ctx->registers.SP--;                                 \
+        GB_T_WRITE(ctx->registers.SP--, value_ >> 8);        \
+        GB_T_WRITE(ctx->registers.SP, value_ & 0xFF);        \
+    } while (0)
+
+#define GB_T_POP(dst)                                        \
+    do                                                       \
+    {                                                        \
+        const uint8_t lsb_ = GB_T_READ(ctx->registers.SP++); \
+        const uint8_t msb_ = GB_T_READ(ctx->registers.SP++); \
+        (dst) = (uint16_t)(lsb_ | (msb_ << 8));              \
+    } while (0)
+
+#define GB_T_CYCLES(op)           gb_opcodes_cycles[0x##op]
+#define GB_T_CYCLES_NOT_TAKEN(op) gb_opcodes_cycles_not_taken[0x##op]
+
+// Every opcode body starts with GB_T_OP (label + INSTRUCTION register, handlers and tests rely on it) and ends with GB_T_NEXT/GB_T_EXIT
+#define GB_T_OP(op) OP_##op: ctx->registers.INSTRUCTION = 0x##op;
+
+#define GB_T_DISPATCH()                  \
+    opcode = GB_T_FETCH();               \
+    goto *s_dispatch[opcode]
+
+// IE/IF write with IME set ends the batch (same as GB_BlockCacheExecute), the caller dispatches the interrupt
+#define GB_T_NEXT(clock)                                                    \
+    cycles += (clock);                                                      \
+    executed++;                                                             \
+    if (cycles >= budget || (ctx->ime && ctx->interruptPending)) goto exit; \
+    GB_T_DISPATCH()
+
+#define GB_T_EXIT(clock)                 \
+    cycles += (clock);                   \
+    executed++;                          \
+    goto exit
+
+uint32_t GB_RunThreaded(EmulationState *ctx, const uint32_t budget)
+{
+    static const void *const s_dispatch[GB_DISPATCH_TABLE_LENGHT] =
+    {
+        /* 00 */ &&OP_00,      &&OP_01,      &&OP_02,      &&OP_03,      &&OP_04,      &&OP_05,      &&OP_06,      &&OP_HANDLER,
+        /* 08 */ &&OP_HANDLER, &&OP_HANDLER, &&OP_0A,      &&OP_0B,      &&OP_0C,      &&OP_0D,      &&OP_0E,      &&OP_HANDLER,
+        /* 10 */ &&OP_10,      &&OP_11,      &&OP_12,      &&OP_13,      &&OP_14,      &&OP_15,      &&OP_16,      &&OP_HANDLER,
+        /* 18 */ &&OP_18,      &&OP_HANDLER, &&OP_1A,      &&OP_1B,      &&OP_1C,      &&OP_1D,      &&OP_1E,      &&OP_HANDLER,
+        /* 20 */ &&OP_20,      &&OP_21,      &&OP_22,      &&OP_23,      &&OP_24,      &&OP_25,      &&OP_26,      &&OP_HANDLER,
+        /* 28 */ &&OP_28,      &&OP_HANDLER, &&OP_2A,      &&OP_2B,      &&OP_2C,      &&OP_2D,      &&OP_2E,      &&OP_HANDLER,
+        /* 30 */ &&OP_30,      &&OP_31,      &&OP_32,      &&OP_33,      &&OP_34,      &&OP_35,      &&OP_36,      &&OP_HANDLER,
+        /* 38 */ &&OP_38,      &&OP_HANDLER, &&OP_3A,      &&OP_3B,      &&OP_3C,      &&OP_3D,      &&OP_3E,      &&OP_HANDLER,
+        /* 40 */ &&OP_40,      &&OP_41,      &&OP_42,      &&OP_43,      &&OP_44,      &&OP_45,      &&OP_46,      &&OP_47,
+        /* 48 */ &&OP_48,      &&OP_49,      &&OP_4A,      &&OP_4B,      &&OP_4C,      &&OP_4D,      &&OP_4E,      &&OP_4F,
+        /* 50 */ &&OP_50,      &&OP_51,      &&OP_52,      &&OP_53,      &&OP_54,      &&OP_55,      &&OP_56,      &&OP_57,
+        /* 58 */ &&OP_58,      &&OP_59,      &&OP_5A,      &&OP_5B,      &&OP_5C,      &&OP_5D,      &&OP_5E,      &&OP_5F,
+        /* 60 */ &&OP_60,      &&OP_61,      &&OP_62,      &&OP_63,      &&OP_64,      &&OP_65,      &&OP_66,      &&OP_67,
+        /* 68 */ &&OP_68,      &&OP_69,      &&OP_6A,      &&OP_6B,      &&OP_6C,      &&OP_6D,      &&OP_6E,      &&OP_6F,
+        /* 70 */ &&OP_70,      &&OP_71,      &&OP_72,      &&OP_73,      &&OP_74,      &&OP_75,      &&OP_76,      &&OP_77,
+        /* 78 */ &&OP_78,      &&OP_79,      &&OP_7A,      &&OP_7B,      &&OP_7C,      &&OP_7D,      &&OP_7E,      &&OP_7F,
+        /* 80 */ &&OP_80,      &&OP_81,      &&OP_82,      &&OP_83,      &&OP_84,      &&OP_85,      &&OP_86,      &&OP_87,
+        /* 88 */ &&OP_88,      &&OP_89,      &&OP_8A,      &&OP_8B,      &&OP_8C,      &&OP_8D,      &&OP_8E,      &&OP_8F,
+        /* 90 */ &&OP_90,      &&OP_91,      &&OP_92,      &&OP_93,      &&OP_94,      &&OP_95,      &&OP_96,      &&OP_97,
+        /* 98 */ &&OP_98,      &&OP_99,      &&OP_9A,      &&OP_9B,      &&OP_9C,      &&OP_9D,      &&OP_9E,      &&OP_9F,
+        /* A0 */ &&OP_A0,      &&OP_A1,      &&OP_A2,      &&OP_A3,      &&OP_A4,      &&OP_A5,      &&OP_A6,      &&OP_A7,
+        /* A8 */ &&OP_A8,      &&OP_A9,      &&OP_AA,      &&OP_AB,      &&OP_AC,      &&OP_AD,      &&OP_AE,      &&OP_AF,
+        /* B0 */ &&OP_B0,      &&OP_B1,      &&OP_B2,      &&OP_B3,      &&OP_B4,      &&OP_B5,      &&OP_B6,      &&OP_B7,
+        /* B8 */ &&OP_B8,      &&OP_B9,      &&OP_BA,      &&OP_BB,      &&OP_BC,      &&OP_BD,      &&OP_BE,      &&OP_BF,
+        /* C0 */ &&OP_C0,      &&OP_C1,      &&OP_C2,      &&OP_C3,      &&OP_C4,      &&OP_C5,      &&OP_C6,      &&OP_HANDLER,
+        /* C8 */ &&OP_C8,      &&OP_C9,      &&OP_CA,      &&OP_CB,      &&OP_CC,      &&OP_CD,      &&OP_CE,      &&OP_HANDLER,
+        /* D0 */ &&OP_D0,      &&OP_D1,      &&OP_D2,      &&OP_HANDLER, &&OP_D4,      &&OP_D5,      &&OP_D6,      &&OP_HANDLER,
+        /* D8 */ &&OP_D8,      &&OP_D9,      &&OP_DA,      &&OP_HANDLER, &&OP_DC,      &&OP_HANDLER, &&OP_DE,      &&OP_HANDLER,
+        /* E0 */ &&OP_E0,      &&OP_E1,      &&OP_E2,      &&OP_HANDLER, &&OP_HANDLER, &&OP_E5,      &&OP_E6,      &&OP_HANDLER,
+        /* E8 */ &&OP_HANDLER, &&OP_E9,      &&OP_EA,      &&OP_HANDLER, &&OP_HANDLER, &&OP_HANDLER, &&OP_EE,      &&OP_HANDLER,
+        /* F0 */ &&OP_F0,      &&OP_F1,      &&OP_F2,      &&OP_F3,      &&OP_HANDLER, &&OP_F5,      &&OP_F6,      &&OP_HANDLER,
+        /* F8 */ &&OP_HANDLER, &&OP_HANDLER, &&OP_FA,      &&OP_FB,      &&OP_HANDLER, &&OP_HANDLER, &&OP_FE,      &&OP_HANDLER,    };
+
+    uint32_t cycles = 0;
+    uint32_t executed = 0;
+    uint8_t  opcode = 0;
+    uint16_t nn = 0;
+    int8_t   e = 0;
+
+    GB_T_DISPATCH();
+
+    OP_00: // NOP (same unit test behaviour as GB_TickCpu, PC stays and INSTRUCTION is not updated)
+    {
+        ctx->registers.PC--;
+        GB_T_NEXT(1);
+    }
+
+    GB_T_OP(01) // LD BC,nn
+    {
+        GB_T_FETCH16(nn);
+        GB_T_REG16(0) = nn;
+        GB_T_NEXT(GB_T_CYCLES(01));
+    }
+
+    GB_T_OP(02) // LD (BC),A
+    {
+        GB_T_WRITE(ctx->registers.BC, ctx->registers.A);
+        GB_T_NEXT(GB_T_CYCLES(02));
+    }
+
+    GB_T_OP(03) // INC BC
+    {
+        GB_T_REG16(0)++;
+        GB_T_NEXT(GB_T_CYCLES(03));
+    }
+
+    GB_T_OP(04) // INC B
+    {
+        GB_T_REG8(0) = GB_ALU_Inc8(ctx, GB_T_REG8(0));
+        GB_T_NEXT(GB_T_CYCLES(04));
+    }
+
+    GB_T_OP(05) // DEC B
+    {
+        GB_T_REG8(0) = GB_ALU_Dec8(ctx, GB_T_REG8(0));
+        GB_T_NEXT(GB_T_CYCLES(05));
+    }
+
+    GB_T_OP(06) // LD B,n
+    {
+        GB_T_REG8(0) = GB_T_FETCH();
+        GB_T_NEXT(GB_T_CYCLES(06));
+    }
+
+    GB_T_OP(0A) // LD A,(BC)
+    {
+        ctx->registers.A = GB_T_READ(ctx->registers.BC);
+        GB_T_NEXT(GB_T_CYCLES(0A));
+    }
+
+    GB_T_OP(0B) // DEC BC
+    {
+        GB_T_REG16(0)--;
+        GB_T_NEXT(GB_T_CYCLES(0B));
+    }
+
+    GB_T_OP(0C) // INC C
+    {
+        GB_T_REG8(1) = GB_ALU_Inc8(ctx, GB_T_REG8(1));
+        GB_T_NEXT(GB_T_CYCLES(0C));
+    }
+
+    GB_T_OP(0D) // DEC C
+    {
+        GB_T_REG8(1) = GB_ALU_Dec8(ctx, GB_T_REG8(1));
+        GB_T_NEXT(GB_T_CYCLES(0D));
+    }
+
+    GB_T_OP(0E) // LD C,n
+    {
+        GB_T_REG8(1) = GB_T_FETCH();
+        GB_T_NEXT(GB_T_CYCLES(0E));
+    }
+
+    GB_T_OP(10) // STOP
+    {
+        GB_T_EXIT(GB_STOP(ctx)); // skips the 00 byte, the caller fast-forwards the sleeping cpu
+    }
+
+    GB_T_OP(11) // LD DE,nn
+    {
+        GB_T_FETCH16(nn);
+        GB_T_REG16(1) = nn;
+        GB_T_NEXT(GB_T_CYCLES(11));
+    }
+
+    GB_T_OP(12) // LD (DE),A
+    {
+        GB_T_WRITE(ctx->registers.DE, ctx->registers.A);
+        GB_T_NEXT(GB_T_CYCLES(12));
+    }
+
+    GB_T_OP(13) // INC DE
+    {
+        GB_T_REG16(1)++;
+        GB_T_NEXT(GB_T_CYCLES(13));
+    }
+
+    GB_T_OP(14) // INC D
+    {
+        GB_T_REG8(2) = GB_ALU_Inc8(ctx, GB_T_REG8(2));
+        GB_T_NEXT(GB_T_CYCLES(14));
+    }
+
+    GB_T_OP(15) // DEC D
+    {
+        GB_T_REG8(2) = GB_ALU_Dec8(ctx, GB_T_REG8(2));
+        GB_T_NEXT(GB_T_CYCLES(15));
+    }
+
+    GB_T_OP(16) // LD D,n
+    {
+        GB_T_REG8(2) = GB_T_FETCH();
+        GB_T_NEXT(GB_T_CYCLES(16));
+    }
+
+    GB_T_OP(18) // JR e
+    {
+        e = (int8_t) GB_T_FETCH();
+        ctx->registers.PC += e;
+        GB_T_NEXT(GB_T_CYCLES(18));
+    }
+
+    GB_T_OP(1A) // LD A,(DE)
+    {
+        ctx->registers.A = GB_T_READ(ctx->registers.DE);
+        GB_T_NEXT(GB_T_CYCLES(1A));
+    }
+
+    GB_T_OP(1B) // DEC DE
+    {
+        GB_T_REG16(1)--;
+        GB_T_NEXT(GB_T_CYCLES(1B));
+    }
+
+    GB_T_OP(1C) // INC E
+    {
+        GB_T_REG8(3) = GB_ALU_Inc8(ctx, GB_T_REG8(3));
+        GB_T_NEXT(GB_T_CYCLES(1C));
+    }
+
+    GB_T_OP(1D) // DEC E
+    {
+        GB_T_REG8(3) = GB_ALU_Dec8(ctx, GB_T_REG8(3));
+        GB_T_NEXT(GB_T_CYCLES(1D));
+    }
+
+    GB_T_OP(1E) // LD E,n
+    {
+        GB_T_REG8(3) = GB_T_FETCH();
+        GB_T_NEXT(GB_T_CYCLES(1E));
+    }
+
+    GB_T_OP(20) // JR NZ,e
+    {
+        e = (int8_t) GB_T_FETCH();
+        if (GB_T_CONDITION(COND_NZ))
+        {
+            ctx->registers.PC += e;
+            GB_T_NEXT(GB_T_CYCLES(20));
+        }
+        GB_T_NEXT(GB_T_CYCLES_NOT_TAKEN(20));
+    }
+
+    GB_T_OP(21) // LD HL,nn
+    {
+        GB_T_FETCH16(nn);
+        GB_T_REG16(2) = nn;
+        GB_T_NEXT(GB_T_CYCLES(21));
+    }
+
+    GB_T_OP(22) // LD (HL+),A
+    {
+        GB_T_WRITE(ctx->registers.HL++, ctx->registers.A);
+        GB_T_NEXT(GB_T_CYCLES(22));
+    }
+
+    GB_T_OP(23) // INC HL
+    {
+        GB_T_REG16(2)++;
+        GB_T_NEXT(GB_T_CYCLES(23));
+    }
+
+    GB_T_OP(24) // INC H
+    {
+        GB_T_REG8(4) = GB_ALU_Inc8(ctx, GB_T_REG8(4));
+        GB_T_NEXT(GB_T_CYCLES(24));
+    }
+
+    GB_T_OP(25) // DEC H
+    {
+        GB_T_REG8(4) = GB_ALU_Dec8(ctx, GB_T_REG8(4));
+        GB_T_NEXT(GB_T_CYCLES(25));
+    }
+
+    GB_T_OP(26) // LD H,n
+    {
+        GB_T_REG8(4) = GB_T_FETCH();
+        GB_T_NEXT(GB_T_CYCLES(26));
+    }
+
+    GB_T_OP(28) // JR Z,e
+    {
+        e = (int8_t) GB_T_FETCH();
+        if (GB_T_CONDITION(COND_Z))
+        {
+            ctx->registers.PC += e;
+            GB_T_NEXT(GB_T_CYCLES(28));
+        }
+        GB_T_NEXT(GB_T_CYCLES_NOT_TAKEN(28));
+    }
+
+    GB_T_OP(2A) // LD A,(HL+)
+    {
+        ctx->registers.A = GB_T_READ(ctx->registers.HL++);
+        GB_T_NEXT(GB_T_CYCLES(2A));
+    }
+
+    GB_T_OP(2B) // DEC HL
+    {
+        GB_T_REG16(2)--;
+        GB_T_NEXT(GB_T_CYCLES(2B));
+    }
+
+    GB_T_OP(2C) // INC L
+    {
+        GB_T_REG8(5) = GB_ALU_Inc8(ctx, GB_T_REG8(5));
+        GB_T_NEXT(GB_T_CYCLES(2C));
+    }
+
+    GB_T_OP(2D) // DEC L
+    {
+        GB_T_REG8(5) = GB_ALU_Dec8(ctx, GB_T_REG8(5));
+        GB_T_NEXT(GB_T_CYCLES(2D));
+    }
+
+    GB_T_OP(2E) // LD L,n
+    {
+        GB_T_REG8(5) = GB_T_FETCH();
+        GB_T_NEXT(GB_T_CYCLES(2E));
+    }
+
+    GB_T_OP(30) // JR NC,e
+    {
+        e = (int8_t) GB_T_FETCH();
+        if (GB_T_CONDITION(COND_NC))
+        {
+            ctx->registers.PC += e;
+            GB_T_NEXT(GB_T_CYCLES(30));
+        }
+        GB_T_NEXT(GB_T_CYCLES_NOT_TAKEN(30));
+    }
+
+    GB_T_OP(31) // LD SP,nn
+    {
+        GB_T_FETCH16(nn);
+        GB_T_REG16(3) = nn;
+        GB_T_NEXT(GB_T_CYCLES(31));
+    }
+
+    GB_T_OP(32) // LD (HL-),A
+    {
+        GB_T_WRITE(ctx->registers.HL--, ctx->registers.A);
+        GB_T_NEXT(GB_T_CYCLES(32));
+    }
+
+    GB_T_OP(33) // INC SP
+    {
+        GB_T_REG16(3)++;
+        GB_T_NEXT(GB_T_CYCLES(33));
+    }
+
+    GB_T_OP(34) // INC (HL)
+    {
+        GB_T_WRITE(ctx->registers.HL, GB_ALU_Inc8(ctx, GB_T_READ(ctx->registers.HL)));
+        GB_T_NEXT(GB_T_CYCLES(34));
+    }
+
+    GB_T_OP(35) // DEC (HL)
+    {
+        GB_T_WRITE(ctx->registers.HL, GB_ALU_Dec8(ctx, GB_T_READ(ctx->registers.HL)));
+        GB_T_NEXT(GB_T_CYCLES(35));
+    }
+
+    GB_T_OP(36) // LD (HL),n
+    {
+        GB_T_WRITE(ctx->registers.HL, GB_T_FETCH());
+        GB_T_NEXT(GB_T_CYCLES(36));
+    }
+
+    GB_T_OP(38) // JR C,e
+    {
+        e = (int8_t) GB_T_FETCH();
+        if (GB_T_CONDITION(COND_C))
+        {
+            ctx->registers.PC += e;
+            GB_T_NEXT(GB_T_CYCLES(38));
+        }
+        GB_T_NEXT(GB_T_CYCLES_NOT_TAKEN(38));
+    }
+
+    GB_T_OP(3A) // LD A,(HL-)
+    {
+        ctx->registers.A = GB_T_READ(ctx->registers.HL--);
+        GB_T_NEXT(GB_T_CYCLES(3A));
+    }
+
+    GB_T_OP(3B) // DEC SP
+    {
+        GB_T_REG16(3)--;
+        GB_T_NEXT(GB_T_CYCLES(3B));
+    }
+
+    GB_T_OP(3C) // INC A
+    {
+        GB_T_REG8(7) = GB_ALU_Inc8(ctx, GB_T_REG8(7));
+        GB_T_NEXT(GB_T_CYCLES(3C));
+    }
+
+    GB_T_OP(3D) // DEC A
+    {
+        GB_T_REG8(7) = GB_ALU_Dec8(ctx, GB_T_REG8(7));
+        GB_T_NEXT(GB_T_CYCLES(3D));
+    }
+
+    GB_T_OP(3E) // LD A,n
+    {
+        GB_T_REG8(7) = GB_T_FETCH();
+        GB_T_NEXT(GB_T_CYCLES(3E));
+    }
+
+    GB_T_OP(40) // LD B,B
+    {
+        GB_T_REG8(0) = GB_T_REG8(0);
+        GB_T_NEXT(GB_T_CYCLES(40));
+    }
+
+    GB_T_OP(41) // LD B,C
+    {
+        GB_T_REG8(0) = GB_T_REG8(1);
+        GB_T_NEXT(GB_T_CYCLES(41));
+    }
+
+    GB_T_OP(42) // LD B,D
+    {
+        GB_T_REG8(0) = GB_T_REG8(2);
+        GB_T_NEXT(GB_T_CYCLES(42));
+    }
+
+    GB_T_OP(43) // LD B,E
+    {
+        GB_T_REG8(0) = GB_T_REG8(3);
+        GB_T_NEXT(GB_T_CYCLES(43));
+    }
+
+    GB_T_OP(44) // LD B,H
+    {
+        GB_T_REG8(0) = GB_T_REG8(4);
+        GB_T_NEXT(GB_T_CYCLES(44));
+    }
+
+    GB_T_OP(45) // LD B,L
+    {
+        GB_T_REG8(0) = GB_T_REG8(5);
+        GB_T_NEXT(GB_T_CYCLES(45));
+    }
+
+    GB_T_OP(46) // LD B,(HL)
+    {
+        GB_T_REG8(0) = GB_T_READ(ctx->registers.HL);
+        GB_T_NEXT(GB_T_CYCLES(46));
+    }
+
+    GB_T_OP(47) // LD B,A
+    {
+        GB_T_REG8(0) = GB_T_REG8(7);
+        GB_T_NEXT(GB_T_CYCLES(47));
+    }
+
+    GB_T_OP(48) // LD C,B
+    {
+        GB_T_REG8(1) = GB_T_REG8(0);
+        GB_T_NEXT(GB_T_CYCLES(48));
+    }
+
+    GB_T_OP(49) // LD C,C
+    {
+        GB_T_REG8(1) = GB_T_REG8(1);
+        GB_T_NEXT(GB_T_CYCLES(49));
+    }
+
+    GB_T_OP(4A) // LD C,D
+    {
+        GB_T_REG8(1) = GB_T_REG8(2);
+        GB_T_NEXT(GB_T_CYCLES(4A));
+    }
+
+    GB_T_OP(4B) // LD C,E
+    {
+        GB_T_REG8(1) = GB_T_REG8(3);
+        GB_T_NEXT(GB_T_CYCLES(4B));
+    }
+
+    GB_T_OP(4C) // LD C,H
+    {
+        GB_T_REG8(1) = GB_T_REG8(4);
+        GB_T_NEXT(GB_T_CYCLES(4C));
+    }
+
+    GB_T_OP(4D) // LD C,L
+    {
+        GB_T_REG8(1) = GB_T_REG8(5);
+        GB_T_NEXT(GB_T_CYCLES(4D));
+    }
+
+    GB_T_OP(4E) // LD C,(HL)
+    {
+        GB_T_REG8(1) = GB_T_READ(ctx->registers.HL);
+        GB_T_NEXT(GB_T_CYCLES(4E));
+    }
+
+    GB_T_OP(4F) // LD C,A
+    {
+        GB_T_REG8(1) = GB_T_REG8(7);
+        GB_T_NEXT(GB_T_CYCLES(4F));
+    }
+
+    GB_T_OP(50) // LD D,B
+    {
+        GB_T_REG8(2) = GB_T_REG8(0);
+        GB_T_NEXT(GB_T_CYCLES(50));
+    }
+
+    GB_T_OP(51) // LD D,C
+    {
+        GB_T_REG8(2) = GB_T_REG8(1);
+        GB_T_NEXT(GB_T_CYCLES(51));
+    }
+
+    GB_T_OP(52) // LD D,D
+    {
+        GB_T_REG8(2) = GB_T_REG8(2);
+        GB_T_NEXT(GB_T_CYCLES(52));
+    }
+
+    GB_T_OP(53) // LD D,E
+    {
+        GB_T_REG8(2) = GB_T_REG8(3);
+        GB_T_NEXT(GB_T_CYCLES(53));
+    }
+
+    GB_T_OP(54) // LD D,H
+    {
+        GB_T_REG8(2) = GB_T_REG8(4);
+        GB_T_NEXT(GB_T_CYCLES(54));
+    }
+
+    GB_T_OP(55) // LD D,L
+    {
+        GB_T_REG8(2) = GB_T_REG8(5);
+        GB_T_NEXT(GB_T_CYCLES(55));
+    }
+
+    GB_T_OP(56) // LD D,(HL)
+    {
+        GB_T_REG8(2) = GB_T_READ(ctx->registers.HL);
+        GB_T_NEXT(GB_T_CYCLES(56));
+    }
+
+    GB_T_OP(57) // LD D,A
+    {
+        GB_T_REG8(2) = GB_T_REG8(7);
+        GB_T_NEXT(GB_T_CYCLES(57));
+    }
+
+    GB_T_OP(58) // LD E,B
+    {
+        GB_T_REG8(3) = GB_T_REG8(0);
+        GB_T_NEXT(GB_T_CYCLES(58));
+    }
+
+    GB_T_OP(59) // LD E,C
+    {
+        GB_T_REG8(3) = GB_T_REG8(1);
+        GB_T_NEXT(GB_T_CYCLES(59));
+    }
+
+    GB_T_OP(5A) // LD E,D
+    {
+        GB_T_REG8(3) = GB_T_REG8(2);
+        GB_T_NEXT(GB_T_CYCLES(5A));
+    }
+
+    GB_T_OP(5B) // LD E,E
+    {
+        GB_T_REG8(3) = GB_T_REG8(3);
+        GB_T_NEXT(GB_T_CYCLES(5B));
+    }
+
+    GB_T_OP(5C) // LD E,H
+    {
+        GB_T_REG8(3) = GB_T_REG8(4);
+        GB_T_NEXT(GB_T_CYCLES(5C));
+    }
+
+    GB_T_OP(5D) // LD E,L
+    {
+        GB_T_REG8(3) = GB_T_REG8(5);
+        GB_T_NEXT(GB_T_CYCLES(5D));
+    }
+
+    GB_T_OP(5E) // LD E,(HL)
+    {
+        GB_T_REG8(3) = GB_T_READ(ctx->registers.HL);
+        GB_T_NEXT(GB_T_CYCLES(5E));
+    }
+
+    GB_T_OP(5F) // LD E,A
+    {
+        GB_T_REG8(3) = GB_T_REG8(7);
+        GB_T_NEXT(GB_T_CYCLES(5F));
+    }
+
+    GB_T_OP(60) // LD H,B
+    {
+        GB_T_REG8(4) = GB_T_REG8(0);
+        GB_T_NEXT(GB_T_CYCLES(60));
+    }
+
+    GB_T_OP(61) // LD H,C
+    {
+        GB_T_REG8(4) = GB_T_REG8(1);
+        GB_T_NEXT(GB_T_CYCLES(61));
+    }
+
+    GB_T_OP(62) // LD H,D
+    {
+        GB_T_REG8(4) = GB_T_REG8(2);
+        GB_T_NEXT(GB_T_CYCLES(62));
+    }
+
+    GB_T_OP(63) // LD H,E
+    {
+        GB_T_REG8(4) = GB_T_REG8(3);
+        GB_T_NEXT(GB_T_CYCLES(63));
+    }
+
+    GB_T_OP(64) // LD H,H
+    {
+        GB_T_REG8(4) = GB_T_REG8(4);
+        GB_T_NEXT(GB_T_CYCLES(64));
+    }
+
+    GB_T_OP(65) // LD H,L
+    {
+        GB_T_REG8(4) = GB_T_REG8(5);
+        GB_T_NEXT(GB_T_CYCLES(65));
+    }
+
+    GB_T_OP(66) // LD H,(HL)
+    {
+        GB_T_REG8(4) = GB_T_READ(ctx->registers.HL);
+        GB_T_NEXT(GB_T_CYCLES(66));
+    }
+
+    GB_T_OP(67) // LD H,A
+    {
+        GB_T_REG8(4) = GB_T_REG8(7);
+        GB_T_NEXT(GB_T_CYCLES(67));
+    }
+
+    GB_T_OP(68) // LD L,B
+    {
+        GB_T_REG8(5) = GB_T_REG8(0);
+        GB_T_NEXT(GB_T_CYCLES(68));
+    }
+
+    GB_T_OP(69) // LD L,C
+    {
+        GB_T_REG8(5) = GB_T_REG8(1);
+        GB_T_NEXT(GB_T_CYCLES(69));
+    }
+
+    GB_T_OP(6A) // LD L,D
+    {
+        GB_T_REG8(5) = GB_T_REG8(2);
+        GB_T_NEXT(GB_T_CYCLES(6A));
+    }
+
+    GB_T_OP(6B) // LD L,E
+    {
+        GB_T_REG8(5) = GB_T_REG8(3);
+        GB_T_NEXT(GB_T_CYCLES(6B));
+    }
+
+    GB_T_OP(6C) // LD L,H
+    {
+        GB_T_REG8(5) = GB_T_REG8(4);
+        GB_T_NEXT(GB_T_CYCLES(6C));
+    }
+
+    GB_T_OP(6D) // LD L,L
+    {
+        GB_T_REG8(5) = GB_T_REG8(5);
+        GB_T_NEXT(GB_T_CYCLES(6D));
+    }
+
+    GB_T_OP(6E) // LD L,(HL)
+    {
+        GB_T_REG8(5) = GB_T_READ(ctx->registers.HL);
+        GB_T_NEXT(GB_T_CYCLES(6E));
+    }
+
+    GB_T_OP(6F) // LD L,A
+    {
+        GB_T_REG8(5) = GB_T_REG8(7);
+        GB_T_NEXT(GB_T_CYCLES(6F));
+    }
+
+    GB_T_OP(70) // LD (HL),B
+    {
+        GB_T_WRITE(ctx->registers.HL, GB_T_REG8(0));
+        GB_T_NEXT(GB_T_CYCLES(70));
+    }
+
+    GB_T_OP(71) // LD (HL),C
+    {
+        GB_T_WRITE(ctx->registers.HL, GB_T_REG8(1));
+        GB_T_NEXT(GB_T_CYCLES(71));
+    }
+
+    GB_T_OP(72) // LD (HL),D
+    {
+        GB_T_WRITE(ctx->registers.HL, GB_T_REG8(2));
+        GB_T_NEXT(GB_T_CYCLES(72));
+    }
+
+    GB_T_OP(73) // LD (HL),E
+    {
+        GB_T_WRITE(ctx->registers.HL, GB_T_REG8(3));
+        GB_T_NEXT(GB_T_CYCLES(73));
+    }
+
+    GB_T_OP(74) // LD (HL),H
+    {
+        GB_T_WRITE(ctx->registers.HL, GB_T_REG8(4));
+        GB_T_NEXT(GB_T_CYCLES(74));
+    }
+
+    GB_T_OP(75) // LD (HL),L
+    {
+        GB_T_WRITE(ctx->registers.HL, GB_T_REG8(5));
+        GB_T_NEXT(GB_T_CYCLES(75));
+    }
+
+    GB_T_OP(76) // HALT
+    {
+        GB_T_EXIT(GB_HALT(ctx)); // the caller fast-forwards the sleeping cpu
+    }
+
+    GB_T_OP(77) // LD (HL),A
+    {
+        GB_T_WRITE(ctx->registers.HL, GB_T_REG8(7));
+        GB_T_NEXT(GB_T_CYCLES(77));
+    }
+
+    GB_T_OP(78) // LD A,B
+    {
+        GB_T_REG8(7) = GB_T_REG8(0);
+        GB_T_NEXT(GB_T_CYCLES(78));
+    }
+
+    GB_T_OP(79) // LD A,C
+    {
+        GB_T_REG8(7) = GB_T_REG8(1);
+        GB_T_NEXT(GB_T_CYCLES(79));
+    }
+
+    GB_T_OP(7A) // LD A,D
+    {
+        GB_T_REG8(7) = GB_T_REG8(2);
+        GB_T_NEXT(GB_T_CYCLES(7A));
+    }
+
+    GB_T_OP(7B) // LD A,E
+    {
+        GB_T_REG8(7) = GB_T_REG8(3);
+        GB_T_NEXT(GB_T_CYCLES(7B));
+    }
+
+    GB_T_OP(7C) // LD A,H
+    {
+        GB_T_REG8(7) = GB_T_REG8(4);
+        GB_T_NEXT(GB_T_CYCLES(7C));
+    }
+
+    GB_T_OP(7D) // LD A,L
+    {
+        GB_T_REG8(7) = GB_T_REG8(5);
+        GB_T_NEXT(GB_T_CYCLES(7D));
+    }
+
+    GB_T_OP(7E) // LD A,(HL)
+    {
+        GB_T_REG8(7) = GB_T_READ(ctx->registers.HL);
+        GB_T_NEXT(GB_T_CYCLES(7E));
+    }
+
+    GB_T_OP(7F) // LD A,A
+    {
+        GB_T_REG8(7) = GB_T_REG8(7);
+        GB_T_NEXT(GB_T_CYCLES(7F));
+    }
+
+    GB_T_OP(80) // ADD A,B
+    {
+        ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, GB_T_REG8(0), 0);
+        GB_T_NEXT(GB_T_CYCLES(80));
+    }
+
+    GB_T_OP(81) // ADD A,C
+    {
+        ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, GB_T_REG8(1), 0);
+        GB_T_NEXT(GB_T_CYCLES(81));
+    }
+
+    GB_T_OP(82) // ADD A,D
+    {
+        ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, GB_T_REG8(2), 0);
+        GB_T_NEXT(GB_T_CYCLES(82));
+    }
+
+    GB_T_OP(83) // ADD A,E
+    {
+        ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, GB_T_REG8(3), 0);
+        GB_T_NEXT(GB_T_CYCLES(83));
+    }
+
+    GB_T_OP(84) // ADD A,H
+    {
+        ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, GB_T_REG8(4), 0);
+        GB_T_NEXT(GB_T_CYCLES(84));
+    }
+
+    GB_T_OP(85) // ADD A,L
+    {
+        ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, GB_T_REG8(5), 0);
+        GB_T_NEXT(GB_T_CYCLES(85));
+    }
+
+    GB_T_OP(86) // ADD A,(HL)
+    {
+        ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, GB_T_READ(ctx->registers.HL), 0);
+        GB_T_NEXT(GB_T_CYCLES(86));
+    }
+
+    GB_T_OP(87) // ADD A,A
+    {
+        ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, GB_T_REG8(7), 0);
+        GB_T_NEXT(GB_T_CYCLES(87));
+    }
+
+    GB_T_OP(88) // ADC A,B
+    {
+        ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, GB_T_REG8(0), GB_FlagCarry(ctx));
+        GB_T_NEXT(GB_T_CYCLES(88));
+    }
+
+    GB_T_OP(89) // ADC A,C
+    {
+        ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, GB_T_REG8(1), GB_FlagCarry(ctx));
+        GB_T_NEXT(GB_T_CYCLES(89));
+    }
+
+    GB_T_OP(8A) // ADC A,D
+    {
+        ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, GB_T_REG8(2), GB_FlagCarry(ctx));
+        GB_T_NEXT(GB_T_CYCLES(8A));
+    }
+
+    GB_T_OP(8B) // ADC A,E
+    {
+        ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, GB_T_REG8(3), GB_FlagCarry(ctx));
+        GB_T_NEXT(GB_T_CYCLES(8B));
+    }
+
+    GB_T_OP(8C) // ADC A,H
+    {
+        ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, GB_T_REG8(4), GB_FlagCarry(ctx));
+        GB_T_NEXT(GB_T_CYCLES(8C));
+    }
+
+    GB_T_OP(8D) // ADC A,L
+    {
+        ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, GB_T_REG8(5), GB_FlagCarry(ctx));
+        GB_T_NEXT(GB_T_CYCLES(8D));
+    }
+
+    GB_T_OP(8E) // ADC A,(HL)
+    {
+        ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, GB_T_READ(ctx->registers.HL), GB_FlagCarry(ctx));
+        GB_T_NEXT(GB_T_CYCLES(8E));
+    }
+
+    GB_T_OP(8F) // ADC A,A
+    {
+        ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, GB_T_REG8(7), GB_FlagCarry(ctx));
+        GB_T_NEXT(GB_T_CYCLES(8F));
+    }
+
+    GB_T_OP(90) // SUB A,B
+    {
+        ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_REG8(0), 0);
+        GB_T_NEXT(GB_T_CYCLES(90));
+    }
+
+    GB_T_OP(91) // SUB A,C
+    {
+        ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_REG8(1), 0);
+        GB_T_NEXT(GB_T_CYCLES(91));
+    }
+
+    GB_T_OP(92) // SUB A,D
+    {
+        ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_REG8(2), 0);
+        GB_T_NEXT(GB_T_CYCLES(92));
+    }
+
+    GB_T_OP(93) // SUB A,E
+    {
+        ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_REG8(3), 0);
+        GB_T_NEXT(GB_T_CYCLES(93));
+    }
+
+    GB_T_OP(94) // SUB A,H
+    {
+        ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_REG8(4), 0);
+        GB_T_NEXT(GB_T_CYCLES(94));
+    }
+
+    GB_T_OP(95) // SUB A,L
+    {
+        ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_REG8(5), 0);
+        GB_T_NEXT(GB_T_CYCLES(95));
+    }
+
+    GB_T_OP(96) // SUB A,(HL)
+    {
+        ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_READ(ctx->registers.HL), 0);
+        GB_T_NEXT(GB_T_CYCLES(96));
+    }
+
+    GB_T_OP(97) // SUB A,A
+    {
+        ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_REG8(7), 0);
+        GB_T_NEXT(GB_T_CYCLES(97));
+    }
+
+    GB_T_OP(98) // SBC A,B
+    {
+        ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_REG8(0), GB_FlagCarry(ctx));
+        GB_T_NEXT(GB_T_CYCLES(98));
+    }
+
+    GB_T_OP(99) // SBC A,C
+    {
+        ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_REG8(1), GB_FlagCarry(ctx));
+        GB_T_NEXT(GB_T_CYCLES(99));
+    }
+
+    GB_T_OP(9A) // SBC A,D
+    {
+        ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_REG8(2), GB_FlagCarry(ctx));
+        GB_T_NEXT(GB_T_CYCLES(9A));
+    }
+
+    GB_T_OP(9B) // SBC A,E
+    {
+        ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_REG8(3), GB_FlagCarry(ctx));
+        GB_T_NEXT(GB_T_CYCLES(9B));
+    }
+
+    GB_T_OP(9C) // SBC A,H
+    {
+        ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_REG8(4), GB_FlagCarry(ctx));
+        GB_T_NEXT(GB_T_CYCLES(9C));
+    }
+
+    GB_T_OP(9D) // SBC A,L
+    {
+        ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_REG8(5), GB_FlagCarry(ctx));
+        GB_T_NEXT(GB_T_CYCLES(9D));
+    }
+
+    GB_T_OP(9E) // SBC A,(HL)
+    {
+        ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_READ(ctx->registers.HL), GB_FlagCarry(ctx));
+        GB_T_NEXT(GB_T_CYCLES(9E));
+    }
+
+    GB_T_OP(9F) // SBC A,A
+    {
+        ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_REG8(7), GB_FlagCarry(ctx));
+        GB_T_NEXT(GB_T_CYCLES(9F));
+    }
+
+    GB_T_OP(A0) // AND A,B
+    {
+        ctx->registers.A = GB_ALU_And8(ctx, ctx->registers.A, GB_T_REG8(0));
+        GB_T_NEXT(GB_T_CYCLES(A0));
+    }
+
+    GB_T_OP(A1) // AND A,C
+    {
+        ctx->registers.A = GB_ALU_And8(ctx, ctx->registers.A, GB_T_REG8(1));
+        GB_T_NEXT(GB_T_CYCLES(A1));
+    }
+
+    GB_T_OP(A2) // AND A,D
+    {
+        ctx->registers.A = GB_ALU_And8(ctx, ctx->registers.A, GB_T_REG8(2));
+        GB_T_NEXT(GB_T_CYCLES(A2));
+    }
+
+    GB_T_OP(A3) // AND A,E
+    {
+        ctx->registers.A = GB_ALU_And8(ctx, ctx->registers.A, GB_T_REG8(3));
+        GB_T_NEXT(GB_T_CYCLES(A3));
+    }
+
+    GB_T_OP(A4) // AND A,H
+    {
+        ctx->registers.A = GB_ALU_And8(ctx, ctx->registers.A, GB_T_REG8(4));
+        GB_T_NEXT(GB_T_CYCLES(A4));
+    }
+
+    GB_T_OP(A5) // AND A,L
+    {
+        ctx->registers.A = GB_ALU_And8(ctx, ctx->registers.A, GB_T_REG8(5));
+        GB_T_NEXT(GB_T_CYCLES(A5));
+    }
+
+    GB_T_OP(A6) // AND A,(HL)
+    {
+        ctx->registers.A = GB_ALU_And8(ctx, ctx->registers.A, GB_T_READ(ctx->registers.HL));
+        GB_T_NEXT(GB_T_CYCLES(A6));
+    }
+
+    GB_T_OP(A7) // AND A,A
+    {
+        ctx->registers.A = GB_ALU_And8(ctx, ctx->registers.A, GB_T_REG8(7));
+        GB_T_NEXT(GB_T_CYCLES(A7));
+    }
+
+    GB_T_OP(A8) // XOR A,B
+    {
+        ctx->registers.A = GB_ALU_Xor8(ctx, ctx->registers.A, GB_T_REG8(0));
+        GB_T_NEXT(GB_T_CYCLES(A8));
+    }
+
+    GB_T_OP(A9) // XOR A,C
+    {
+        ctx->registers.A = GB_ALU_Xor8(ctx, ctx->registers.A, GB_T_REG8(1));
+        GB_T_NEXT(GB_T_CYCLES(A9));
+    }
+
+    GB_T_OP(AA) // XOR A,D
+    {
+        ctx->registers.A = GB_ALU_Xor8(ctx, ctx->registers.A, GB_T_REG8(2));
+        GB_T_NEXT(GB_T_CYCLES(AA));
+    }
+
+    GB_T_OP(AB) // XOR A,E
+    {
+        ctx->registers.A = GB_ALU_Xor8(ctx, ctx->registers.A, GB_T_REG8(3));
+        GB_T_NEXT(GB_T_CYCLES(AB));
+    }
+
+    GB_T_OP(AC) // XOR A,H
+    {
+        ctx->registers.A = GB_ALU_Xor8(ctx, ctx->registers.A, GB_T_REG8(4));
+        GB_T_NEXT(GB_T_CYCLES(AC));
+    }
+
+    GB_T_OP(AD) // XOR A,L
+    {
+        ctx->registers.A = GB_ALU_Xor8(ctx, ctx->registers.A, GB_T_REG8(5));
+        GB_T_NEXT(GB_T_CYCLES(AD));
+    }
+
+    GB_T_OP(AE) // XOR A,(HL)
+    {
+        ctx->registers.A = GB_ALU_Xor8(ctx, ctx->registers.A, GB_T_READ(ctx->registers.HL));
+        GB_T_NEXT(GB_T_CYCLES(AE));
+    }
+
+    GB_T_OP(AF) // XOR A,A
+    {
+        ctx->registers.A = GB_ALU_Xor8(ctx, ctx->registers.A, GB_T_REG8(7));
+        GB_T_NEXT(GB_T_CYCLES(AF));
+    }
+
+    GB_T_OP(B0) // OR A,B
+    {
+        ctx->registers.A = GB_ALU_Or8(ctx, ctx->registers.A, GB_T_REG8(0));
+        GB_T_NEXT(GB_T_CYCLES(B0));
+    }
+
+    GB_T_OP(B1) // OR A,C
+    {
+        ctx->registers.A = GB_ALU_Or8(ctx, ctx->registers.A, GB_T_REG8(1));
+        GB_T_NEXT(GB_T_CYCLES(B1));
+    }
+
+    GB_T_OP(B2) // OR A,D
+    {
+        ctx->registers.A = GB_ALU_Or8(ctx, ctx->registers.A, GB_T_REG8(2));
+        GB_T_NEXT(GB_T_CYCLES(B2));
+    }
+
+    GB_T_OP(B3) // OR A,E
+    {
+        ctx->registers.A = GB_ALU_Or8(ctx, ctx->registers.A, GB_T_REG8(3));
+        GB_T_NEXT(GB_T_CYCLES(B3));
+    }
+
+    GB_T_OP(B4) // OR A,H
+    {
+        ctx->registers.A = GB_ALU_Or8(ctx, ctx->registers.A, GB_T_REG8(4));
+        GB_T_NEXT(GB_T_CYCLES(B4));
+    }
+
+    GB_T_OP(B5) // OR A,L
+    {
+        ctx->registers.A = GB_ALU_Or8(ctx, ctx->registers.A, GB_T_REG8(5));
+        GB_T_NEXT(GB_T_CYCLES(B5));
+    }
+
+    GB_T_OP(B6) // OR A,(HL)
+    {
+        ctx->registers.A = GB_ALU_Or8(ctx, ctx->registers.A, GB_T_READ(ctx->registers.HL));
+        GB_T_NEXT(GB_T_CYCLES(B6));
+    }
+
+    GB_T_OP(B7) // OR A,A
+    {
+        ctx->registers.A = GB_ALU_Or8(ctx, ctx->registers.A, GB_T_REG8(7));
+        GB_T_NEXT(GB_T_CYCLES(B7));
+    }
+
+    GB_T_OP(B8) // CP A,B
+    {
+        GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_REG8(0), 0);
+        GB_T_NEXT(GB_T_CYCLES(B8));
+    }
+
+    GB_T_OP(B9) // CP A,C
+    {
+        GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_REG8(1), 0);
+        GB_T_NEXT(GB_T_CYCLES(B9));
+    }
+
+    GB_T_OP(BA) // CP A,D
+    {
+        GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_REG8(2), 0);
+        GB_T_NEXT(GB_T_CYCLES(BA));
+    }
+
+    GB_T_OP(BB) // CP A,E
+    {
+        GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_REG8(3), 0);
+        GB_T_NEXT(GB_T_CYCLES(BB));
+    }
+
+    GB_T_OP(BC) // CP A,H
+    {
+        GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_REG8(4), 0);
+        GB_T_NEXT(GB_T_CYCLES(BC));
+    }
+
+    GB_T_OP(BD) // CP A,L
+    {
+        GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_REG8(5), 0);
+        GB_T_NEXT(GB_T_CYCLES(BD));
+    }
+
+    GB_T_OP(BE) // CP A,(HL)
+    {
+        GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_READ(ctx->registers.HL), 0);
+        GB_T_NEXT(GB_T_CYCLES(BE));
+    }
+
+    GB_T_OP(BF) // CP A,A
+    {
+        GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_REG8(7), 0);
+        GB_T_NEXT(GB_T_CYCLES(BF));
+    }
+
+    GB_T_OP(C0) // RET NZ
+    {
+        if (GB_T_CONDITION(COND_NZ))
+        {
+            GB_T_POP(ctx->registers.PC);
+            GB_T_NEXT(GB_T_CYCLES(C0));
+        }
+        GB_T_NEXT(GB_T_CYCLES_NOT_TAKEN(C0));
+    }
+
+    GB_T_OP(C1) // POP BC
+    {
+        GB_T_POP(ctx->registers.FILE_16[0]);
+        GB_T_NEXT(GB_T_CYCLES(C1));
+    }
+
+    GB_T_OP(C2) // JP NZ,nn
+    {
+        if (GB_T_CONDITION(COND_NZ))
+        {
+            GB_T_FETCH16(ctx->registers.PC);
+            GB_T_NEXT(GB_T_CYCLES(C2));
+        }
+        ctx->registers.PC += 2; // skip nn
+        GB_T_NEXT(GB_T_CYCLES_NOT_TAKEN(C2));
+    }
+
+    GB_T_OP(C3) // JP nn
+    {
+        GB_T_FETCH16(ctx->registers.PC);
+        GB_T_NEXT(GB_T_CYCLES(C3));
+    }
+
+    GB_T_OP(C4) // CALL NZ,nn
+    {
+        if (GB_T_CONDITION(COND_NZ))
+        {
+            GB_T_FETCH16(nn);
+            GB_T_PUSH(ctx->registers.PC);
+            ctx->registers.PC = nn;
+            GB_T_NEXT(GB_T_CYCLES(C4));
+        }
+        ctx->registers.PC += 2; // skip nn
+        GB_T_NEXT(GB_T_CYCLES_NOT_TAKEN(C4));
+    }
+
+    GB_T_OP(C5) // PUSH BC
+    {
+        GB_T_PUSH(ctx->registers.FILE_16[0]);
+        GB_T_NEXT(GB_T_CYCLES(C5));
+    }
+
+    GB_T_OP(C6) // ADD A,n
+    {
+        ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, GB_T_FETCH(), 0);
+        GB_T_NEXT(GB_T_CYCLES(C6));
+    }
+
+    GB_T_OP(C8) // RET Z
+    {
+        if (GB_T_CONDITION(COND_Z))
+        {
+            GB_T_POP(ctx->registers.PC);
+            GB_T_NEXT(GB_T_CYCLES(C8));
+        }
+        GB_T_NEXT(GB_T_CYCLES_NOT_TAKEN(C8));
+    }
+
+    GB_T_OP(C9) // RET
+    {
+        GB_T_POP(ctx->registers.PC);
+        GB_T_NEXT(GB_T_CYCLES(C9));
+    }
+
+    GB_T_OP(CA) // JP Z,nn
+    {
+        if (GB_T_CONDITION(COND_Z))
+        {
+            GB_T_FETCH16(ctx->registers.PC);
+            GB_T_NEXT(GB_T_CYCLES(CA));
+        }
+        ctx->registers.PC += 2; // skip nn
+        GB_T_NEXT(GB_T_CYCLES_NOT_TAKEN(CA));
+    }
+
+    GB_T_OP(CB) // CB prefix (flat CB table)
+    {
+        GB_T_NEXT(GB_CB_PREFIX(ctx));
+    }
+
+    GB_T_OP(CC) // CALL Z,nn
+    {
+        if (GB_T_CONDITION(COND_Z))
+        {
+            GB_T_FETCH16(nn);
+            GB_T_PUSH(ctx->registers.PC);
+            ctx->registers.PC = nn;
+            GB_T_NEXT(GB_T_CYCLES(CC));
+        }
+        ctx->registers.PC += 2; // skip nn
+        GB_T_NEXT(GB_T_CYCLES_NOT_TAKEN(CC));
+    }
+
+    GB_T_OP(CD) // CALL nn
+    {
+        GB_T_FETCH16(nn);
+        GB_T_PUSH(ctx->registers.PC);
+        ctx->registers.PC = nn;
+        GB_T_NEXT(GB_T_CYCLES(CD));
+    }
+
+    GB_T_OP(CE) // ADC A,n
+    {
+        ctx->registers.A = GB_ALU_Add8(ctx, ctx->registers.A, GB_T_FETCH(), GB_FlagCarry(ctx));
+        GB_T_NEXT(GB_T_CYCLES(CE));
+    }
+
+    GB_T_OP(D0) // RET NC
+    {
+        if (GB_T_CONDITION(COND_NC))
+        {
+            GB_T_POP(ctx->registers.PC);
+            GB_T_NEXT(GB_T_CYCLES(D0));
+        }
+        GB_T_NEXT(GB_T_CYCLES_NOT_TAKEN(D0));
+    }
+
+    GB_T_OP(D1) // POP DE
+    {
+        GB_T_POP(ctx->registers.FILE_16[1]);
+        GB_T_NEXT(GB_T_CYCLES(D1));
+    }
+
+    GB_T_OP(D2) // JP NC,nn
+    {
+        if (GB_T_CONDITION(COND_NC))
+        {
+            GB_T_FETCH16(ctx->registers.PC);
+            GB_T_NEXT(GB_T_CYCLES(D2));
+        }
+        ctx->registers.PC += 2; // skip nn
+        GB_T_NEXT(GB_T_CYCLES_NOT_TAKEN(D2));
+    }
+
+    GB_T_OP(D4) // CALL NC,nn
+    {
+        if (GB_T_CONDITION(COND_NC))
+        {
+            GB_T_FETCH16(nn);
+            GB_T_PUSH(ctx->registers.PC);
+            ctx->registers.PC = nn;
+            GB_T_NEXT(GB_T_CYCLES(D4));
+        }
+        ctx->registers.PC += 2; // skip nn
+        GB_T_NEXT(GB_T_CYCLES_NOT_TAKEN(D4));
+    }
+
+    GB_T_OP(D5) // PUSH DE
+    {
+        GB_T_PUSH(ctx->registers.FILE_16[1]);
+        GB_T_NEXT(GB_T_CYCLES(D5));
+    }
+
+    GB_T_OP(D6) // SUB A,n
+    {
+        ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_FETCH(), 0);
+        GB_T_NEXT(GB_T_CYCLES(D6));
+    }
+
+    GB_T_OP(D8) // RET C
+    {
+        if (GB_T_CONDITION(COND_C))
+        {
+            GB_T_POP(ctx->registers.PC);
+            GB_T_NEXT(GB_T_CYCLES(D8));
+        }
+        GB_T_NEXT(GB_T_CYCLES_NOT_TAKEN(D8));
+    }
+
+    GB_T_OP(D9) // RETI
+    {
+        GB_T_POP(ctx->registers.PC);
+        ctx->ime = 0x01;
+        GB_T_EXIT(GB_T_CYCLES(D9)); // let the caller service interrupts
+    }
+
+    GB_T_OP(DA) // JP C,nn
+    {
+        if (GB_T_CONDITION(COND_C))
+        {
+            GB_T_FETCH16(ctx->registers.PC);
+            GB_T_NEXT(GB_T_CYCLES(DA));
+        }
+        ctx->registers.PC += 2; // skip nn
+        GB_T_NEXT(GB_T_CYCLES_NOT_TAKEN(DA));
+    }
+
+    GB_T_OP(DC) // CALL C,nn
+    {
+        if (GB_T_CONDITION(COND_C))
+        {
+            GB_T_FETCH16(nn);
+            GB_T_PUSH(ctx->registers.PC);
+            ctx->registers.PC = nn;
+            GB_T_NEXT(GB_T_CYCLES(DC));
+        }
+        ctx->registers.PC += 2; // skip nn
+        GB_T_NEXT(GB_T_CYCLES_NOT_TAKEN(DC));
+    }
+
+    GB_T_OP(DE) // SBC A,n
+    {
+        ctx->registers.A = GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_FETCH(), GB_FlagCarry(ctx));
+        GB_T_NEXT(GB_T_CYCLES(DE));
+    }
+
+    GB_T_OP(E0) // LDH (n),A
+    {
+        GB_T_WRITE(0xFF00 | GB_T_FETCH(), ctx->registers.A);
+        GB_T_NEXT(GB_T_CYCLES(E0));
+    }
+
+    GB_T_OP(E1) // POP HL
+    {
+        GB_T_POP(ctx->registers.FILE_16[2]);
+        GB_T_NEXT(GB_T_CYCLES(E1));
+    }
+
+    GB_T_OP(E2) // LDH (C),A
+    {
+        GB_T_WRITE(0xFF00 | ctx->registers.C, ctx->registers.A);
+        GB_T_NEXT(GB_T_CYCLES(E2));
+    }
+
+    GB_T_OP(E5) // PUSH HL
+    {
+        GB_T_PUSH(ctx->registers.FILE_16[2]);
+        GB_T_NEXT(GB_T_CYCLES(E5));
+    }
+
+    GB_T_OP(E6) // AND A,n
+    {
+        ctx->registers.A = GB_ALU_And8(ctx, ctx->registers.A, GB_T_FETCH());
+        GB_T_NEXT(GB_T_CYCLES(E6));
+    }
+
+    GB_T_OP(E9) // JP HL
+    {
+        ctx->registers.PC = ctx->registers.HL;
+        GB_T_NEXT(GB_T_CYCLES(E9));
+    }
+
+    GB_T_OP(EA) // LD (nn),A
+    {
+        GB_T_FETCH16(nn);
+        GB_T_WRITE(nn, ctx->registers.A);
+        GB_T_NEXT(GB_T_CYCLES(EA));
+    }
+
+    GB_T_OP(EE) // XOR A,n
+    {
+        ctx->registers.A = GB_ALU_Xor8(ctx, ctx->registers.A, GB_T_FETCH());
+        GB_T_NEXT(GB_T_CYCLES(EE));
+    }
+
+    GB_T_OP(F0) // LDH A,(n)
+    {
+        ctx->registers.A = GB_T_READ(0xFF00 | GB_T_FETCH());
+        GB_T_NEXT(GB_T_CYCLES(F0));
+    }
+
+    GB_T_OP(F1) // POP AF
+    {
+        GB_FlagsSync(ctx);
+        GB_T_POP(ctx->registers.FILE_16[3]);
+        GB_T_NEXT(GB_T_CYCLES(F1));
+    }
+
+    GB_T_OP(F2) // LDH A,(C)
+    {
+        ctx->registers.A = GB_T_READ(0xFF00 | ctx->registers.C);
+        GB_T_NEXT(GB_T_CYCLES(F2));
+    }
+
+    GB_T_OP(F3) // DI
+    {
+        ctx->ime = 0x00;
+        GB_T_NEXT(GB_T_CYCLES(F3));
+    }
+
+    GB_T_OP(F5) // PUSH AF
+    {
+        GB_FlagsSync(ctx);
+        GB_T_PUSH(ctx->registers.FILE_16[3]);
+        GB_T_NEXT(GB_T_CYCLES(F5));
+    }
+
+    GB_T_OP(F6) // OR A,n
+    {
+        ctx->registers.A = GB_ALU_Or8(ctx, ctx->registers.A, GB_T_FETCH());
+        GB_T_NEXT(GB_T_CYCLES(F6));
+    }
+
+    GB_T_OP(FA) // LD A,(nn)
+    {
+        GB_T_FETCH16(nn);
+        ctx->registers.A = GB_T_READ(nn);
+        GB_T_NEXT(GB_T_CYCLES(FA));
+    }
+
+    GB_T_OP(FB) // EI
+    {
+        ctx->ime = 0x01;
+        GB_T_EXIT(GB_T_CYCLES(FB)); // let the caller service interrupts
+    }
+
+    GB_T_OP(FE) // CP A,n
+    {
+        GB_ALU_Sub8(ctx, ctx->registers.A, GB_T_FETCH(), 0);
+        GB_T_NEXT(GB_T_CYCLES(FE));
+    }
+
+    OP_HANDLER: // Not inlined, use the function pointer core handler
+    {
+        const GameBoyInstruction *instruction = GB_DecodeInstruction(opcode);
+
+        if (instruction->handler == NULL)
+        {
+            GB_T_EXIT(GB_InvalidInstruction(ctx, opcode));
+        }
+
+        ctx->registers.INSTRUCTION = opcode;
+        GB_T_NEXT(instruction->handler(ctx));
+    }
+
+exit:
+    ctx->instructions += executed;
+    return cycles;
+}
+
+#endif
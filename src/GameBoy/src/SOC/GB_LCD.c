@@ -1,4 +1,7 @@
 #include <SOC/GB_LCD.h>
+#include <SOC/GB_Interrupt.h>
+#include <PPU/GB_PpuTables.h>
+#include <PPU/GB_TileCache.h>
 
 // 160 SEGMENTS AT 108.7 micro seconds.
 // 144 LINES AT 15.66 milli seconds
@@ -17,75 +20,271 @@
 
 //OK FORGIVE ME ABOUT THE STATICS HERE (MIGHT BE NEEDED WHEN EMBEED)
 
-void GB_LCD_Init()
+static const uint16_t s_gb_lcd_mode_lenght[4] = {204, 456, 80, 172};
+
+static void GB_LCD_CompareLY(EmulationState* state)
+{
+    state->registers.LCD_STAT.LYC_LY_COINCIDENCE_FLAG = state->registers.LCD_LY == state->registers.LCD_LYC;
+
+    if (state->registers.LCD_STAT.LYC_LY_COINCIDENCE_FLAG && state->registers.LCD_STAT.LYC_LY_COINCIDENCE_INTERRUPT)
+    {
+        GB_InterruptRequest(state, GB_INTERRUPT_LCD);
+    }
+}
+
+void GB_LCD_SyncPalletes(EmulationState* state)
 {
+    GB_PalleteBuild(&state->palletes[GB_PALLETE_BG], state->registers.LCD_BGP);
+    GB_PalleteBuild(&state->palletes[GB_PALLETE_OBJ0], state->registers.LCD_OBP0);
+    GB_PalleteBuild(&state->palletes[GB_PALLETE_OBJ1], state->registers.LCD_OBP1);
+}
 
+void GB_LCD_Init(EmulationState* state)
+{
+    state->ppuMode = 0; // HBlank
+    state->registers.LCD_STAT.MODE_FLAG = 0;
+    state->renderInterval = 1;
+    state->renderFrame = 1;
+    GB_LCD_SyncPalletes(state);
+    GB_SchedulerSchedule(&state->scheduler, GB_EVENT_PPU_MODE, state->cpuCycles + s_gb_lcd_mode_lenght[0]);
 }
 
-void GB_LCD_Tick(EmulationState* state, uint8_t cycles)
+// Frame skip, skipped frames keep the framebuffer of the last rasterized one
+static void GB_LCD_StartFrame(EmulationState* state)
+{
+    state->ppuFrames++;
+    state->renderFrame = state->renderInterval != 0 && state->ppuFrames % state->renderInterval == 0;
+    state->renderedFrames += state->renderFrame;
+}
+
+void GB_LCD_OnModeEvent(EmulationState* state, const uint64_t deadline)
 {
-    state->ppuCycles += cycles;
     switch (state->ppuMode) {
         case 0: // HBlank
-            if (state->ppuCycles>= 204) {
-                state->ppuCycles-= 204;
-                
-                state->registers.LCD_LY++;
-
-                if (state->registers.LCD_LY == 144) {
-                    state->ppuMode = 1; // VBlank
-                    // Trigger VBlank interrupt
-                } else {
-                    state->ppuMode = 2; // OAM search
-                }
+            state->registers.LCD_LY++;
+
+            if (state->registers.LCD_LY == 144) {
+                state->ppuMode = 1; // VBlank
+                GB_InterruptRequest(state, GB_INTERRUPT_VBLANK);
+            } else {
+                state->ppuMode = 2; // OAM search
             }
+            GB_LCD_CompareLY(state);
             break;
         case 1: // VBlank
-            if (state->ppuCycles>= 456) {
-                state->ppuCycles-= 456;
-                state->registers.LCD_LY++;
-
-                if (state->registers.LCD_LY > 153) {
-                    state->registers.LCD_LY = 0;
-                    state->ppuMode = 2; // OAM search
-                }
+            state->registers.LCD_LY++;
+
+            if (state->registers.LCD_LY > 153) {
+                state->registers.LCD_LY = 0;
+                state->windowLine = 0;
+                state->ppuMode = 2; // OAM search
+                GB_LCD_StartFrame(state);
             }
+            GB_LCD_CompareLY(state);
             break;
         case 2: // OAM search
-            if (state->ppuCycles>= 80) {
-                state->ppuCycles-= 80;
-                state->ppuMode = 3; // Drawing pixels
-            }
+            state->ppuMode = 3; // Drawing pixels
             break;
         case 3: // Drawing pixels
-            if (state->ppuCycles >= 172) {
-                state->ppuCycles-= 172;
-                GB_RenderScanLine(state);
-                state->ppuMode = 0; // HBlank
-            }
+            if (state->renderFrame) GB_RenderScanLine(state);
+            state->ppuMode = 0; // HBlank
             break;
     }
+
+    // STAT mode interrupts (mode 3 doesn't have one)
+    const uint8_t modeChanged = state->registers.LCD_STAT.MODE_FLAG != state->ppuMode;
+    state->registers.LCD_STAT.MODE_FLAG = state->ppuMode;
+
+    if (modeChanged &&
+        ((state->ppuMode == 0 && state->registers.LCD_STAT.MODE_0_HBLANK_INTERRUPT) ||
+         (state->ppuMode == 1 && state->registers.LCD_STAT.MODE_1_VBLANK_INTERRUPT) ||
+         (state->ppuMode == 2 && state->registers.LCD_STAT.MODE_2_OAM_INTERRUPT)))
+    {
+        GB_InterruptRequest(state, GB_INTERRUPT_LCD);
+    }
+
+    // Next mode change relative to this deadline (overshoot of the last instruction is kept)
+    GB_SchedulerSchedule(&state->scheduler, GB_EVENT_PPU_MODE, deadline + s_gb_lcd_mode_lenght[state->ppuMode]);
 }
 
+// Tile (0-383) of a bg/window tile index (0x8000 unsigned or 0x9000 signed addressing)
+static inline uint16_t GB_LCD_MapTile(const EmulationState* state, const uint8_t tile)
+{
+    return (state->registers.LCD_CONTROL.value & GB_LCDC_TILE_DATA) ? tile : 256 + (int8_t) tile;
+}
+
+// Color indices of a tile row, from the tile cache (decoded from vram when there isn't one)
+static inline void GB_LCD_TileRow(EmulationState* state, uint8_t *pixels, const uint16_t tile, const uint8_t row)
+{
+    if (state->tileCache != NULL)
+    {
+        memcpy(pixels, GB_TileCacheRow(state->tileCache, state->vram, tile, row), GB_TILE_ROW_PIXELS);
+        return;
+    }
+
+    const uint8_t *data = &state->vram[tile * GB_TILE_BYTES + row * 2];
+    GB_DecodeTileRow(pixels, data[0], data[1]);
+}
+
+// Tiles of one tile map row starting at column (the map wraps every 32 tiles), y is the pixel row in the map
+static void GB_LCD_DecodeMapRow(EmulationState* state, uint8_t *pixels, const uint16_t map, const uint8_t y,
+                                const uint8_t column, const uint8_t tiles)
+{
+    const uint8_t *mapRow = &state->vram[map - GB_VRAM_START + (y >> 3) * GB_TILE_MAP_WIDTH];
+
+    for (uint8_t i = 0; i < tiles; i++)
+    {
+        const uint16_t tile = GB_LCD_MapTile(state, mapRow[(column + i) & (GB_TILE_MAP_WIDTH - 1)]);
+        GB_LCD_TileRow(state, &pixels[i * GB_TILE_ROW_PIXELS], tile, y & 7);
+    }
+}
 
 void GB_RenderScanLine(EmulationState* state)
 {
-  // get the propper row of pixels using LY (18 tiles or 144 pixels (288 bytes wide))
-  // check addresing mode (signed(0x8000) or unsigned(0x9000))
-  // get the tile id deduced by the adressing mode
-  // based on tile id get the tile data (16 bytes wide) and decode the pallete
-  // based on what the decoded values gave, render into the screen using the green shades array
+    const uint8_t ly = state->registers.LCD_LY;
+
+    if (state->framebuffer == NULL || ly >= GB_DISPLAY_HEIGHT)
+    {
+        return;
+    }
+
+    uint8_t *line = &state->framebuffer[ly * GB_DISPLAY_WIDHT];
+    const uint8_t lcdc = state->registers.LCD_CONTROL.value;
+
+    // Display off, blank (lightest shade) line
+    if (!(lcdc & GB_LCDC_LCD_ENABLE))
+    {
+        memset(line, 0, GB_DISPLAY_WIDHT);
+        return;
+    }
+
+    uint8_t colors[GB_DISPLAY_WIDHT];
+
+    if (lcdc & GB_LCDC_BG_WINDOW_ENABLE)
+    {
+        GB_DrawBackground(state, colors);
+        GB_DrawWindow(state, colors);
+    }
+    else
+    {
+        memset(colors, 0, sizeof(colors));
+    }
+
+    const GB_PalleteTable *bgp = &state->palletes[GB_PALLETE_BG];
+
+    for (uint8_t x = 0; x < GB_DISPLAY_WIDHT; x += 2)
+    {
+        memcpy(&line[x], bgp->pairs[GB_PALLETE_PAIR(colors[x], colors[x + 1])], 2);
+    }
+
+    if (lcdc & GB_LCDC_OBJ_ENABLE)
+    {
+        GB_DrawObjects(state, line, colors);
+    }
 }
 
-void GB_DrawBackground()
+void GB_DrawBackground(EmulationState* state, uint8_t *colors)
 {
+    // One extra tile for the SCX fine scroll
+    uint8_t pixels[GB_DISPLAY_WIDHT + GB_TILE_ROW_PIXELS];
+
+    const uint16_t map = (state->registers.LCD_CONTROL.value & GB_LCDC_BG_TILE_MAP) ? GB_TILE_MAP_1 : GB_TILE_MAP_0;
+    const uint8_t y = state->registers.LCD_SCY + state->registers.LCD_LY;
+    const uint8_t scx = state->registers.LCD_SCX;
 
+    GB_LCD_DecodeMapRow(state, pixels, map, y, scx >> 3, sizeof(pixels) / GB_TILE_ROW_PIXELS);
+    memcpy(colors, &pixels[scx & 7], GB_DISPLAY_WIDHT);
 }
 
-void GB_DrawWindow()
+void GB_DrawWindow(EmulationState* state, uint8_t *colors)
 {
+    const GB_Registers *registers = &state->registers;
+
+    // WX 0-6 start the window before the left edge, 167 and up leave it out of the screen
+    if (!(registers->LCD_CONTROL.value & GB_LCDC_WINDOW_ENABLE) || registers->LCD_LY < registers->LCD_WY || registers->LCD_WX > 166)
+    {
+        return;
+    }
+
+    uint8_t pixels[GB_DISPLAY_WIDHT + GB_TILE_ROW_PIXELS];
+
+    const uint16_t map = (registers->LCD_CONTROL.value & GB_LCDC_WINDOW_TILE_MAP) ? GB_TILE_MAP_1 : GB_TILE_MAP_0;
+    const uint8_t skip = registers->LCD_WX < 7 ? 7 - registers->LCD_WX : 0;
+    const uint8_t start = registers->LCD_WX < 7 ? 0 : registers->LCD_WX - 7;
+    const uint8_t width = GB_DISPLAY_WIDHT - start;
+
+    GB_LCD_DecodeMapRow(state, pixels, map, state->windowLine, 0, (skip + width + GB_TILE_ROW_PIXELS - 1) / GB_TILE_ROW_PIXELS);
+    memcpy(&colors[start], &pixels[skip], width);
+
+    state->windowLine++;
 }
 
-void GB_DrawObjects()
+void GB_DrawObjects(EmulationState* state, uint8_t *line, const uint8_t *colors)
 {
+    const uint8_t ly = state->registers.LCD_LY;
+    const uint8_t height = (state->registers.LCD_CONTROL.value & GB_LCDC_OBJ_SIZE) ? 16 : 8;
+
+    // First 10 objects of OAM on this line, insertion sorted by X (same X keeps the OAM order)
+    uint8_t selected[GB_OBJ_PER_LINE];
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < GB_OBJ_COUNT && count < GB_OBJ_PER_LINE; i++)
+    {
+        const int16_t top = state->oam[i * 4] - 16;
+
+        if (ly < top || ly >= top + height)
+        {
+            continue;
+        }
+
+        uint8_t slot = count++;
+
+        for (; slot > 0 && state->oam[selected[slot - 1] * 4 + 1] > state->oam[i * 4 + 1]; slot--)
+        {
+            selected[slot] = selected[slot - 1];
+        }
+
+        selected[slot] = i;
+    }
+
+    // Highest priority first, a pixel belongs to the first object with a visible color there (even behind the BG)
+    uint8_t owned[GB_DISPLAY_WIDHT] = {0};
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        const uint8_t *object = &state->oam[selected[i] * 4];
+        const uint8_t attributes = object[3];
+        const int16_t x = object[1] - 8;
+
+        uint8_t row = ly - (object[0] - 16);
+        row = (attributes & GB_OBJ_Y_FLIP) ? height - 1 - row : row;
+
+        // 8x16 objects ignore bit 0 of the tile index (rows 8-15 are the next tile)
+        const uint8_t tile = height == 16 ? object[2] & 0xFE : object[2];
+
+        uint8_t pixels[GB_TILE_ROW_PIXELS];
+        GB_LCD_TileRow(state, pixels, tile + (row >> 3), row & 7);
+
+        const uint8_t *shades = state->palletes[(attributes & GB_OBJ_PALETTE) ? GB_PALLETE_OBJ1 : GB_PALLETE_OBJ0].shades;
+
+        for (uint8_t p = 0; p < GB_TILE_ROW_PIXELS; p++)
+        {
+            const int16_t px = x + ((attributes & GB_OBJ_X_FLIP) ? 7 - p : p);
+            const uint8_t color = pixels[p];
+
+            if (px < 0 || px >= GB_DISPLAY_WIDHT || color == 0 || owned[px])
+            {
+                continue;
+            }
+
+            owned[px] = 1;
+
+            if ((attributes & GB_OBJ_BG_PRIORITY) && colors[px] != 0)
+            {
+                continue;
+            }
+
+            line[px] = shades[color];
+        }
+    }
 }
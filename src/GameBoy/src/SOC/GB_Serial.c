@@ -0,0 +1,37 @@
+#include <SOC/GB_Serial.h>
+#include <SOC/GB_Interrupt.h>
+
+uint8_t GB_Serial_Read(const EmulationState *state, const uint16_t address)
+{
+    return address == GB_SB_REGISTER ? state->serialData : state->serialControl | 0x7E;
+}
+
+void GB_Serial_Write(EmulationState *state, const uint16_t address, const uint8_t value)
+{
+    if (address == GB_SB_REGISTER)
+    {
+        state->serialData = value;
+        return;
+    }
+
+    state->serialControl = value & 0x81;
+
+    // Transfer start + internal clock
+    if ((value & 0x81) == 0x81)
+    {
+        GB_SchedulerSchedule(&state->scheduler, GB_EVENT_SERIAL, state->cpuCycles + GB_SERIAL_BIT_CYCLES * 8);
+    }
+    else
+    {
+        GB_SchedulerCancel(&state->scheduler, GB_EVENT_SERIAL);
+    }
+}
+
+void GB_Serial_OnTransferEnd(EmulationState *state, const uint64_t deadline)
+{
+    (void)deadline;
+
+    state->serialData = 0xFF;
+    state->serialControl &= 0x7F;
+    GB_InterruptRequest(state, GB_INTERRUPT_SERIAL);
+}
@@ -0,0 +1,131 @@
+#include <SOC/GB_Timer.h>
+#include <SOC/GB_Interrupt.h>
+
+static const uint16_t s_gb_timer_periods[4] = {1024, 16, 64, 256};
+
+static uint16_t GB_Timer_Period(const EmulationState *state)
+{
+    return s_gb_timer_periods[state->timer.tac & 0x03];
+}
+
+// Folds the TIMA increments since timaBase into tima (keeps the phase of the current increment)
+static void GB_Timer_Sync(EmulationState *state)
+{
+    if (!(state->timer.tac & GB_TAC_ENABLE))
+    {
+        return;
+    }
+
+    const uint64_t ticks = (state->cpuCycles - state->timer.timaBase) / GB_Timer_Period(state);
+
+    state->timer.tima += (uint8_t)ticks;
+    state->timer.timaBase += ticks * GB_Timer_Period(state);
+}
+
+static void GB_Timer_Schedule(EmulationState *state)
+{
+    if (!(state->timer.tac & GB_TAC_ENABLE))
+    {
+        GB_SchedulerCancel(&state->scheduler, GB_EVENT_TIMER_OVERFLOW);
+        return;
+    }
+
+    const uint64_t deadline = state->timer.timaBase + (uint64_t)(0x100 - state->timer.tima) * GB_Timer_Period(state);
+    GB_SchedulerSchedule(&state->scheduler, GB_EVENT_TIMER_OVERFLOW, deadline);
+}
+
+void GB_Timer_Reset(EmulationState *state)
+{
+    state->timer.divBase = state->cpuCycles;
+    state->timer.timaBase = state->cpuCycles;
+    state->timer.tima = 0;
+    state->timer.tma = 0;
+    state->timer.tac = 0;
+
+    GB_Timer_Schedule(state);
+}
+
+uint8_t GB_Timer_Read(const EmulationState *state, const uint16_t address)
+{
+    switch (address)
+    {
+    case GB_DIV_REGISTER:
+        return (uint8_t)((state->cpuCycles - state->timer.divBase) >> 8);
+
+    case GB_TIMA_REGISTER:
+        if (state->timer.tac & GB_TAC_ENABLE)
+        {
+            // Never wraps here, the overflow event is dispatched before the clock reaches 0x100 increments
+            return state->timer.tima + (uint8_t)((state->cpuCycles - state->timer.timaBase) / GB_Timer_Period(state));
+        }
+        return state->timer.tima;
+
+    case GB_TMA_REGISTER:
+        return state->timer.tma;
+
+    case GB_TAC_REGISTER:
+        return state->timer.tac | 0xF8;
+    }
+
+    return 0xFF;
+}
+
+void GB_Timer_Write(EmulationState *state, const uint16_t address, const uint8_t value)
+{
+    switch (address)
+    {
+    case GB_DIV_REGISTER:
+        state->timer.divBase = state->cpuCycles;
+        break;
+
+    case GB_TIMA_REGISTER:
+        GB_Timer_Sync(state);
+        state->timer.tima = value;
+        GB_Timer_Schedule(state);
+        break;
+
+    case GB_TMA_REGISTER:
+        state->timer.tma = value;
+        break;
+
+    case GB_TAC_REGISTER:
+        GB_Timer_Sync(state);
+
+        if (!(state->timer.tac & GB_TAC_ENABLE))
+        {
+            state->timer.timaBase = state->cpuCycles; // Starts counting now
+        }
+
+        state->timer.tac = value & 0x07;
+        GB_Timer_Schedule(state);
+        break;
+    }
+}
+
+void GB_Timer_OnOverflow(EmulationState *state, const uint64_t deadline)
+{
+    state->timer.tima = state->timer.tma;
+    state->timer.timaBase = deadline;
+    GB_InterruptRequest(state, GB_INTERRUPT_TIMER);
+
+    GB_Timer_Schedule(state);
+}
+
+uint64_t GB_Timer_NextChange(const EmulationState *state, const uint16_t address)
+{
+    switch (address)
+    {
+    case GB_DIV_REGISTER:
+        return state->timer.divBase + ((((state->cpuCycles - state->timer.divBase) >> 8) + 1) << 8);
+
+    case GB_TIMA_REGISTER:
+        if (state->timer.tac & GB_TAC_ENABLE)
+        {
+            const uint16_t period = GB_Timer_Period(state);
+            return state->timer.timaBase + ((state->cpuCycles - state->timer.timaBase) / period + 1) * period;
+        }
+        break;
+    }
+
+    return UINT64_MAX;
+}
@@ -19,17 +19,16 @@ TEST(Chip8_CPU, opcodeTest)
     bool executionStatus = true;
 
     emulator = &Chip8Emulator;
-    MNE_New(context, 1, CC8_Memory);
-    emulator->SetEmulationContext((void *) context);
-    programSize = emulator->LoadProgram(TEST_ROOM_PATH);
+    context = static_cast<CC8_Memory *>(emulator->CreateInstance());
+    programSize = emulator->LoadProgram(context, TEST_ROOM_PATH);
     executionStatus = programSize > 0;
     
     // Program size is just an reference for max execution limit (thus due to data in the code...)
     for (; executionCount < programSize; executionCount++)
     {
         // Step emulation
-        emulator->TickEmulation();
-        emulator->TickTimers();
+        emulator->RunCycles(context, 1);
+        emulator->TickTimers(context);
         
         // Check if processed op code was executed right testing against invalid opcode and nop (not expecting any of those)
         if (context->INSTRUCTION == CC8_INVALID_INSTRUCTION || context->INSTRUCTION == 0)
@@ -39,7 +38,8 @@ TEST(Chip8_CPU, opcodeTest)
         }
     }
 
-    emulator->QuitProgram();
+    emulator->QuitProgram(context);
+    emulator->DestroyInstance(context);
     MNE_Log("Instructions executed [%li] of [%li]\n", executionCount, programSize);
     EXPECT_TRUE(executionStatus);
 }
\ No newline at end of file
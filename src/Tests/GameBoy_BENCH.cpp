@@ -0,0 +1,1106 @@
+/*
+GAME BOY BENCHMARKS:
+    - Not real unit tests, they only print throughput numbers (instructions/second) to compare implementations.
+    - Workload is the boot rom (long running loops: vram clear, logo decompression, scrolling...)
+*/
+
+#define BIOS_PATH "../../../roms/gameboy/bios.gb"
+#define GB_DEBUG
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C"
+{
+#include <minemu.h>
+#include <Emulation/GB_Emulation.h>
+}
+
+// Executed instructions recorded from the boot rom and number of times the recording is replayed
+#define BENCH_TRACE_LENGHT 4096
+#define BENCH_REPLAY_COUNT 500
+
+// Frames of the boot rom run through GB_TickCpu with each decoder
+#define BENCH_DECODE_FRAMES 60
+
+// One frame worth of clock cycles (154 lines * 456 cycles) and frames executed by the core benchmarks
+#define BENCH_FRAME_CYCLES 70224
+#define BENCH_THREADED_FRAMES 30
+
+// Independent machines running the boot rom at the same time (one per thread)
+#define BENCH_INSTANCES 4
+
+// Frames of the ALU loop used by the lazy flags benchmark
+#define BENCH_ALU_FRAMES 10
+
+// Frames of the copy loop used by the superinstructions benchmark and opcode pairs printed from its profile
+#define BENCH_FUSION_FRAMES 10
+#define BENCH_PAIR_REPORT_LENGHT 8
+
+// Frames of the boot rom run with the opcode profiler, rows printed from its report and CSV written by the test
+#define BENCH_PROFILER_FRAMES 30
+#define BENCH_PROFILER_REPORT_LENGHT 8
+#define BENCH_PROFILER_CSV_PATH "gb_bench_profile.csv"
+
+// Frames rendered by the scanline benchmark (random tiles, maps and objects)
+#define BENCH_RENDER_FRAMES 2000
+
+// Passes of the PPU kernels benchmark (whole tile data decoded / whole frame expanded to RGBA per pass)
+#define BENCH_PPU_KERNEL_PASSES 2000
+
+// Frames run by the frame skip benchmark for every render interval (copy loop on top of the render scene)
+#define BENCH_FRAME_SKIP_FRAMES 600
+
+// Operand sets evaluated by the ALU tables benchmark
+#define BENCH_ALU_TABLE_EVALUATIONS (1 << 22)
+
+typedef GameBoyInstruction *(*DecodeFnPtr)(const uint8_t opcode);
+
+class GameBoyBenchmark : public testing::Test
+{
+protected:
+    EmulationState *emulationCtx;
+
+    void SetUp() override
+    {
+        emulationCtx = static_cast<EmulationState *>(GB_CreateInstance());
+        GB_Initialize(emulationCtx, 0, NULL);
+    }
+
+    void TearDown() override
+    {
+        GB_QuitProgram(emulationCtx);
+        GB_DestroyInstance(emulationCtx);
+    }
+};
+
+bool LoadBios(EmulationState *emulationCtx)
+{
+    std::ifstream biosFile(BIOS_PATH, std::ios::binary);
+
+    if (!biosFile.is_open())
+    {
+        return false;
+    }
+
+    std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(biosFile)), std::istreambuf_iterator<char>());
+
+    for (size_t i = 0; i < buffer.size(); i++)
+    {
+        emulationCtx->bank_00[i] = buffer[i];
+    }
+
+    emulationCtx->registers.PC = 0;
+    return true;
+}
+
+// Runs the boot rom and records every executed opcode (this is the workload used to compare decoders)
+std::vector<uint8_t> RecordOpcodeTrace(EmulationState *emulationCtx)
+{
+    std::vector<uint8_t> trace;
+
+    for (int i = 0; i < BENCH_TRACE_LENGHT; i++)
+    {
+        const uint8_t opcode = GB_BusRead(emulationCtx, emulationCtx->registers.PC);
+
+        if (GB_TickEmulation(emulationCtx) == 0)
+        {
+            break;
+        }
+        trace.push_back(opcode);
+    }
+
+    return trace;
+}
+
+double MeasureDecoder(const std::vector<uint8_t> &trace, DecodeFnPtr decode)
+{
+    uintptr_t checksum = 0;
+    const auto begin = std::chrono::steady_clock::now();
+
+    for (int replay = 0; replay < BENCH_REPLAY_COUNT; replay++)
+    {
+        for (const uint8_t opcode : trace)
+        {
+            checksum += (uintptr_t) decode(opcode)->handler;
+        }
+    }
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    EXPECT_NE(checksum, 0u);
+
+    return (double)(trace.size() * BENCH_REPLAY_COUNT) / elapsed.count();
+}
+
+// Runs the function pointer core the same way GB_TickEmulation does (one instruction per tick)
+void RunFnPtrCycles(EmulationState *emulationCtx, const uint64_t cycles)
+{
+    const uint64_t target = emulationCtx->cpuCycles + cycles;
+
+    while (emulationCtx->cpuCycles < target)
+    {
+        uint16_t currentCycles = GB_HandleInterrupts(emulationCtx);
+        currentCycles += GB_TickCpu(emulationCtx);
+
+        GB_AdvanceClock(emulationCtx, currentCycles);
+    }
+}
+
+void ResetEmulation(EmulationState *emulationCtx)
+{
+    GB_QuitProgram(emulationCtx);
+    GB_Initialize(emulationCtx, 0, NULL);
+}
+
+TEST_F(GameBoyBenchmark, DISPATCH_TABLE)
+{
+    ASSERT_TRUE(LoadBios(emulationCtx));
+
+    const std::vector<uint8_t> trace = RecordOpcodeTrace(emulationCtx);
+    ASSERT_FALSE(trace.empty());
+
+    // Both decoders must agree for every opcode
+    for (uint16_t opcode = 0; opcode < GB_DISPATCH_TABLE_LENGHT; opcode++)
+    {
+        EXPECT_EQ(GB_FetchInstruction(opcode), GB_DecodeInstruction(opcode)) << "OPCODE: " << opcode;
+    }
+
+    const double linearScan = MeasureDecoder(trace, GB_FetchInstruction);
+    const double dispatchTable = MeasureDecoder(trace, GB_DecodeInstruction);
+
+    MNE_Log("[BENCHMARK] DECODE LINEAR MASK SCAN: %.2f M instructions/second\n", linearScan / 1e6);
+    MNE_Log("[BENCHMARK] DECODE DISPATCH TABLE:   %.2f M instructions/second (x%.2f)\n", dispatchTable / 1e6, dispatchTable / linearScan);
+
+    // End to end: the boot rom executed by GB_TickCpu with the mask scan, then with the table (same instructions)
+    const uint64_t cycles = (uint64_t)BENCH_FRAME_CYCLES * BENCH_DECODE_FRAMES;
+
+    ResetEmulation(emulationCtx);
+    ASSERT_TRUE(LoadBios(emulationCtx));
+    emulationCtx->linearDecode = 1;
+
+    auto begin = std::chrono::steady_clock::now();
+    RunFnPtrCycles(emulationCtx, cycles);
+    const std::chrono::duration<double> scanElapsed = std::chrono::steady_clock::now() - begin;
+
+    const GB_Registers scanRegisters = emulationCtx->registers;
+    const uint64_t scanInstructions = emulationCtx->instructions;
+
+    ResetEmulation(emulationCtx);
+    ASSERT_TRUE(LoadBios(emulationCtx));
+    emulationCtx->linearDecode = 0;
+
+    begin = std::chrono::steady_clock::now();
+    RunFnPtrCycles(emulationCtx, cycles);
+    const std::chrono::duration<double> tableElapsed = std::chrono::steady_clock::now() - begin;
+
+    EXPECT_EQ(scanInstructions, emulationCtx->instructions);
+    EXPECT_EQ(0, memcmp(&scanRegisters, &emulationCtx->registers, sizeof(GB_Registers)));
+
+    const double scanRate = (double)scanInstructions / scanElapsed.count();
+    const double tableRate = (double)scanInstructions / tableElapsed.count();
+
+    MNE_Log("[BENCHMARK] BOOT ROM MASK SCAN:      %.2f M instructions/second\n", scanRate / 1e6);
+    MNE_Log("[BENCHMARK] BOOT ROM DISPATCH TABLE: %.2f M instructions/second (x%.2f)\n", tableRate / 1e6, tableRate / scanRate);
+}
+
+// Runs the threaded core the same way GB_TickEmulation does on GB_THREADED_CORE builds (batches end on scheduler events)
+void RunThreadedCycles(EmulationState *emulationCtx, const uint64_t cycles)
+{
+    const uint64_t target = emulationCtx->cpuCycles + cycles;
+
+    while (emulationCtx->cpuCycles < target)
+    {
+        uint32_t budget = GB_CyclesUntilNextEvent(emulationCtx);
+
+        if (budget > target - emulationCtx->cpuCycles)
+        {
+            budget = (uint32_t)(target - emulationCtx->cpuCycles);
+        }
+
+        uint16_t currentCycles = GB_HandleInterrupts(emulationCtx);
+        currentCycles += GB_RunThreaded(emulationCtx, budget);
+
+        GB_AdvanceClock(emulationCtx, currentCycles);
+    }
+}
+
+// Runs the block cache the same way GB_TickEmulation does on GB_CACHED_CORE builds (one block or one instruction per tick)
+void RunCachedCycles(EmulationState *emulationCtx, const uint64_t cycles)
+{
+    const uint64_t target = emulationCtx->cpuCycles + cycles;
+
+    while (emulationCtx->cpuCycles < target)
+    {
+        uint32_t budget = GB_CyclesUntilNextEvent(emulationCtx);
+
+        if (budget > target - emulationCtx->cpuCycles)
+        {
+            budget = (uint32_t)(target - emulationCtx->cpuCycles);
+        }
+
+        uint16_t blockCycles = 0;
+        uint16_t currentCycles = GB_HandleInterrupts(emulationCtx);
+        currentCycles += GB_BlockCacheRun(emulationCtx, (uint16_t)budget, &blockCycles) ? blockCycles : GB_TickCpu(emulationCtx);
+
+        GB_AdvanceClock(emulationCtx, currentCycles);
+    }
+}
+
+#ifdef GB_JIT
+// Runs the JIT the same way GB_TickEmulation does on GB_JIT builds
+void RunJitCycles(EmulationState *emulationCtx, const uint64_t cycles)
+{
+    const uint64_t target = emulationCtx->cpuCycles + cycles;
+
+    while (emulationCtx->cpuCycles < target)
+    {
+        uint32_t budget = GB_CyclesUntilNextEvent(emulationCtx);
+
+        if (budget > target - emulationCtx->cpuCycles)
+        {
+            budget = (uint32_t)(target - emulationCtx->cpuCycles);
+        }
+
+        uint16_t blockCycles = 0;
+        uint16_t currentCycles = GB_HandleInterrupts(emulationCtx);
+        currentCycles += GB_JitRun(emulationCtx, (uint16_t)budget, &blockCycles) ? blockCycles : GB_TickCpu(emulationCtx);
+
+        GB_AdvanceClock(emulationCtx, currentCycles);
+    }
+}
+#endif
+
+// Function pointer core writing the flags into F after every instruction (what the eager ALU did)
+void RunEagerFlagsCycles(EmulationState *emulationCtx, const uint64_t cycles)
+{
+    const uint64_t target = emulationCtx->cpuCycles + cycles;
+
+    while (emulationCtx->cpuCycles < target)
+    {
+        uint16_t currentCycles = GB_HandleInterrupts(emulationCtx);
+        currentCycles += GB_TickCpu(emulationCtx);
+        GB_FlagsSync(emulationCtx);
+
+        GB_AdvanceClock(emulationCtx, currentCycles);
+    }
+}
+
+// ALU bound loop: every flag producing instruction is followed by another one, conditions and PUSH/POP AF read them
+void LoadAluLoop(EmulationState *emulationCtx)
+{
+    const uint8_t program[] = {
+        0x06, 0x00, // LD B,0
+        0x81,       // loop: ADD A,C
+        0xAA,       // XOR D
+        0x93,       // SUB E
+        0x24,       // INC H
+        0x89,       // ADC A,C
+        0xA5,       // AND L
+        0x9A,       // SBC A,D
+        0xB0,       // OR B
+        0x0D,       // DEC C
+        0xFE, 0x12, // CP 0x12
+        0x38, 0x01, // JR C,+1
+        0x14,       // INC D
+        0x04,       // INC B
+        0x20, 0xEF, // JR NZ,loop
+        0x1C,       // INC E
+        0xF5,       // PUSH AF
+        0xF1,       // POP AF
+        0x18, 0xEA, // JR loop
+    };
+
+    memcpy(emulationCtx->bank_00, program, sizeof(program));
+    GB_BlockCacheInvalidate(emulationCtx->blockCache);
+
+    emulationCtx->registers.PC = 0;
+    emulationCtx->registers.SP = 0xFFFE;
+}
+
+// Block copy and delay loops made of the fused sequences (GB_Fusion.h)
+void LoadCopyLoop(EmulationState *emulationCtx)
+{
+    const uint8_t program[] = {
+        0x21, 0x00, 0xC0, // LD HL,0xC000
+        0x11, 0x00, 0xC1, // LD DE,0xC100
+        0x01, 0x80, 0x00, // LD BC,0x0080
+        0x2A,             // copy: LD A,(HL+)
+        0x12,             // LD (DE),A
+        0x13,             // INC DE
+        0x0B,             // DEC BC
+        0x78,             // LD A,B
+        0xB1,             // OR C
+        0x20, 0xF8,       // JR NZ,copy
+        0x06, 0x10,       // LD B,0x10
+        0x05,             // delay: DEC B
+        0x20, 0xFD,       // JR NZ,delay
+        0x18, 0xE8,       // JR 0x0000
+    };
+
+    memcpy(emulationCtx->bank_00, program, sizeof(program));
+    GB_BlockCacheInvalidate(emulationCtx->blockCache);
+
+    emulationCtx->registers.PC = 0;
+    emulationCtx->registers.SP = 0xFFFE;
+}
+
+// Enables the timer interrupt and requests it with IME already set, the vector keeps B in C and counts the dispatches in D
+void LoadInterruptProgram(EmulationState *emulationCtx)
+{
+    const uint8_t program[] = {
+        0x31, 0xFE, 0xFF, // LD SP,0xFFFE
+        0xFB,             // EI
+        0x3E, 0x04,       // LD A,0x04
+        0xE0, 0xFF,       // LDH (IE),A
+        0xE0, 0x0F,       // LDH (IF),A
+        0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, // INC B (x10)
+        0x18, 0xFE,       // JR -2
+    };
+    const uint8_t timerVector[] = {
+        0x48,             // LD C,B
+        0x14,             // INC D
+        0xD9,             // RETI
+    };
+
+    memcpy(emulationCtx->bank_00, program, sizeof(program));
+    memcpy(emulationCtx->bank_00 + 0x50, timerVector, sizeof(timerVector));
+    GB_BlockCacheInvalidate(emulationCtx->blockCache);
+
+    emulationCtx->registers.PC = 0;
+}
+
+TEST_F(GameBoyBenchmark, THREADED_CORE)
+{
+    ASSERT_TRUE(LoadBios(emulationCtx));
+
+    // Function pointer core (reference)
+    auto begin = std::chrono::steady_clock::now();
+    RunFnPtrCycles(emulationCtx, BENCH_FRAME_CYCLES);
+    const std::chrono::duration<double> fnPtrElapsed = std::chrono::steady_clock::now() - begin;
+
+    const GB_Registers fnPtrRegisters = emulationCtx->registers;
+    const uint64_t fnPtrInstructions = emulationCtx->instructions;
+    const uint64_t fnPtrCycles = emulationCtx->cpuCycles;
+    std::vector<uint8_t> fnPtrVram(emulationCtx->vram, emulationCtx->vram + GB_VRAM_SIZE);
+    std::vector<uint8_t> fnPtrHram(emulationCtx->hram, emulationCtx->hram + GB_HRAM_SIZE);
+
+    // Threaded core from the same initial state must end on the same state
+    ResetEmulation(emulationCtx);
+    ASSERT_TRUE(LoadBios(emulationCtx));
+    RunThreadedCycles(emulationCtx, BENCH_FRAME_CYCLES);
+
+    EXPECT_EQ(fnPtrCycles, emulationCtx->cpuCycles);
+    EXPECT_EQ(fnPtrInstructions, emulationCtx->instructions);
+    EXPECT_EQ(fnPtrRegisters.PC, emulationCtx->registers.PC);
+    EXPECT_EQ(fnPtrRegisters.SP, emulationCtx->registers.SP);
+    EXPECT_EQ(fnPtrRegisters.INSTRUCTION, emulationCtx->registers.INSTRUCTION);
+    EXPECT_EQ(0, memcmp(&fnPtrRegisters, &emulationCtx->registers, sizeof(GB_Registers)));
+    EXPECT_EQ(0, memcmp(fnPtrVram.data(), emulationCtx->vram, GB_VRAM_SIZE));
+    EXPECT_EQ(0, memcmp(fnPtrHram.data(), emulationCtx->hram, GB_HRAM_SIZE));
+
+    // The boot rom never sets IME: an interrupt requested with IME set has to be taken before the next instruction
+    const uint64_t interruptCycles[] = {200, BENCH_FRAME_CYCLES};
+
+    for (const uint64_t cycles : interruptCycles)
+    {
+        ResetEmulation(emulationCtx);
+        LoadInterruptProgram(emulationCtx);
+        RunFnPtrCycles(emulationCtx, cycles);
+
+        const GB_Registers interruptRegisters = emulationCtx->registers;
+        const uint64_t interruptInstructions = emulationCtx->instructions;
+        const uint8_t interruptIme = emulationCtx->ime;
+
+        EXPECT_EQ(1, interruptRegisters.D) << "TIMER INTERRUPT MUST BE TAKEN ONCE";
+        EXPECT_EQ(0, interruptRegisters.C) << "INTERRUPT MUST BE TAKEN BEFORE INC B";
+
+        ResetEmulation(emulationCtx);
+        LoadInterruptProgram(emulationCtx);
+        RunThreadedCycles(emulationCtx, cycles);
+
+        EXPECT_EQ(interruptInstructions, emulationCtx->instructions) << "CYCLES: " << cycles;
+        EXPECT_EQ(interruptIme, emulationCtx->ime) << "CYCLES: " << cycles;
+        EXPECT_EQ(0, memcmp(&interruptRegisters, &emulationCtx->registers, sizeof(GB_Registers))) << "CYCLES: " << cycles;
+    }
+
+    // Threaded core throughput over a longer run
+    ResetEmulation(emulationCtx);
+    ASSERT_TRUE(LoadBios(emulationCtx));
+    emulationCtx->linearDecode = 0;
+
+    begin = std::chrono::steady_clock::now();
+    RunThreadedCycles(emulationCtx, (uint64_t)BENCH_FRAME_CYCLES * BENCH_THREADED_FRAMES);
+    const std::chrono::duration<double> threadedElapsed = std::chrono::steady_clock::now() - begin;
+
+    const double fnPtr = (double)fnPtrInstructions / fnPtrElapsed.count();
+    const double threaded = (double)emulationCtx->instructions / threadedElapsed.count();
+
+    MNE_Log("[BENCHMARK] FUNCTION POINTER CORE: %.2f M instructions/second\n", fnPtr / 1e6);
+    MNE_Log("[BENCHMARK] THREADED CORE:         %.2f M instructions/second (x%.2f)\n", threaded / 1e6, threaded / fnPtr);
+}
+
+TEST_F(GameBoyBenchmark, BLOCK_CACHE)
+{
+    ASSERT_TRUE(LoadBios(emulationCtx));
+
+    // Function pointer core (reference)
+    auto begin = std::chrono::steady_clock::now();
+    RunFnPtrCycles(emulationCtx, BENCH_FRAME_CYCLES);
+    const std::chrono::duration<double> fnPtrElapsed = std::chrono::steady_clock::now() - begin;
+
+    const GB_Registers fnPtrRegisters = emulationCtx->registers;
+    const uint64_t fnPtrInstructions = emulationCtx->instructions;
+    std::vector<uint8_t> fnPtrVram(emulationCtx->vram, emulationCtx->vram + GB_VRAM_SIZE);
+
+    // Same frame through the block cache
+    ResetEmulation(emulationCtx);
+    ASSERT_TRUE(LoadBios(emulationCtx));
+
+    if (emulationCtx->blockCache == NULL)
+    {
+        emulationCtx->blockCache = GB_BlockCacheCreate();
+    }
+
+    begin = std::chrono::steady_clock::now();
+    RunCachedCycles(emulationCtx, BENCH_FRAME_CYCLES);
+    const std::chrono::duration<double> cachedElapsed = std::chrono::steady_clock::now() - begin;
+
+    EXPECT_EQ(fnPtrInstructions, emulationCtx->instructions);
+    EXPECT_EQ(0, memcmp(&fnPtrRegisters, &emulationCtx->registers, sizeof(GB_Registers)));
+    EXPECT_EQ(0, memcmp(fnPtrVram.data(), emulationCtx->vram, GB_VRAM_SIZE));
+
+    const GB_BlockCacheStats *stats = &emulationCtx->blockCache->stats;
+    EXPECT_GT(stats->hits, 0u);
+
+    const double fnPtr = (double)fnPtrInstructions / fnPtrElapsed.count();
+    const double cached = (double)emulationCtx->instructions / cachedElapsed.count();
+
+    MNE_Log("[BENCHMARK] FUNCTION POINTER CORE: %.2f M instructions/second\n", fnPtr / 1e6);
+    MNE_Log("[BENCHMARK] BLOCK CACHE:           %.2f M instructions/second (x%.2f)\n", cached / 1e6, cached / fnPtr);
+    // Hit rate and block lenght stats are printed by GB_QuitProgram (GB_DEBUG)
+}
+
+#ifdef GB_JIT
+TEST_F(GameBoyBenchmark, JIT)
+{
+    ASSERT_TRUE(LoadBios(emulationCtx));
+    ASSERT_NE(nullptr, emulationCtx->jit);
+
+    // Function pointer core (reference)
+    auto begin = std::chrono::steady_clock::now();
+    RunFnPtrCycles(emulationCtx, BENCH_FRAME_CYCLES);
+    const std::chrono::duration<double> fnPtrElapsed = std::chrono::steady_clock::now() - begin;
+
+    const GB_Registers fnPtrRegisters = emulationCtx->registers;
+    const uint64_t fnPtrInstructions = emulationCtx->instructions;
+    std::vector<uint8_t> fnPtrVram(emulationCtx->vram, emulationCtx->vram + GB_VRAM_SIZE);
+
+    // Lockstep: every native block is checked against the interpreter
+    ResetEmulation(emulationCtx);
+    ASSERT_TRUE(LoadBios(emulationCtx));
+    GB_JitSetLockstep(emulationCtx->jit, 1);
+    RunJitCycles(emulationCtx, BENCH_FRAME_CYCLES);
+
+    const GB_JitStats *stats = GB_JitGetStats(emulationCtx->jit);
+    EXPECT_GT(stats->compiled, 0u);
+    EXPECT_GT(stats->lockstepBlocks, 0u);
+    EXPECT_EQ(0u, stats->lockstepMismatches);
+
+    // Native only run must end on the reference state
+    ResetEmulation(emulationCtx);
+    ASSERT_TRUE(LoadBios(emulationCtx));
+    emulationCtx->linearDecode = 0;
+
+    begin = std::chrono::steady_clock::now();
+    RunJitCycles(emulationCtx, BENCH_FRAME_CYCLES);
+    const std::chrono::duration<double> jitElapsed = std::chrono::steady_clock::now() - begin;
+
+    EXPECT_EQ(fnPtrInstructions, emulationCtx->instructions);
+    EXPECT_EQ(0, memcmp(&fnPtrRegisters, &emulationCtx->registers, sizeof(GB_Registers)));
+    EXPECT_EQ(0, memcmp(fnPtrVram.data(), emulationCtx->vram, GB_VRAM_SIZE));
+
+    const double fnPtr = (double)fnPtrInstructions / fnPtrElapsed.count();
+    const double jit = (double)emulationCtx->instructions / jitElapsed.count();
+
+    MNE_Log("[BENCHMARK] FUNCTION POINTER CORE: %.2f M instructions/second\n", fnPtr / 1e6);
+    MNE_Log("[BENCHMARK] JIT:                   %.2f M instructions/second (x%.2f)\n", jit / 1e6, jit / fnPtr);
+}
+#endif
+
+TEST_F(GameBoyBenchmark, LAZY_FLAGS)
+{
+    const uint64_t cycles = (uint64_t)BENCH_FRAME_CYCLES * BENCH_ALU_FRAMES;
+
+    // Flags materialized after every instruction (reference)
+    LoadAluLoop(emulationCtx);
+
+    auto begin = std::chrono::steady_clock::now();
+    RunEagerFlagsCycles(emulationCtx, cycles);
+    const std::chrono::duration<double> eagerElapsed = std::chrono::steady_clock::now() - begin;
+
+    const GB_Registers eagerRegisters = emulationCtx->registers;
+    const uint64_t eagerInstructions = emulationCtx->instructions;
+
+    // Lazy flags, only synced by the conditions, PUSH/POP AF and the end of the run
+    ResetEmulation(emulationCtx);
+    LoadAluLoop(emulationCtx);
+
+    begin = std::chrono::steady_clock::now();
+    RunFnPtrCycles(emulationCtx, cycles);
+    GB_FlagsSync(emulationCtx);
+    const std::chrono::duration<double> lazyElapsed = std::chrono::steady_clock::now() - begin;
+
+    EXPECT_EQ(eagerInstructions, emulationCtx->instructions);
+    EXPECT_EQ(0, memcmp(&eagerRegisters, &emulationCtx->registers, sizeof(GB_Registers)));
+
+    const double eager = (double)eagerInstructions / eagerElapsed.count();
+    const double lazy = (double)emulationCtx->instructions / lazyElapsed.count();
+
+    MNE_Log("[BENCHMARK] EAGER FLAGS: %.2f M instructions/second\n", eager / 1e6);
+    MNE_Log("[BENCHMARK] LAZY FLAGS:  %.2f M instructions/second (x%.2f)\n", lazy / 1e6, lazy / eager);
+}
+
+// Flags computed with branches (what GB_FlagsSync and GB_DAA did before the tables), F layout
+uint8_t BranchyAddFlags(const uint8_t a, const uint8_t b, const uint8_t carry)
+{
+    return (((a & 0x0F) + (b & 0x0F) + carry) > 0x0F) << 5;
+}
+
+uint8_t BranchySubFlags(const uint8_t a, const uint8_t b, const uint8_t carry)
+{
+    return 0x40 | (((a & 0x0F) - (b & 0x0F) - carry) < 0) << 5;
+}
+
+uint8_t BranchyIncFlags(const uint8_t value)
+{
+    return ((uint8_t)(value + 1) == 0) << 7 | ((value & 0x0F) == 0x0F) << 5;
+}
+
+uint8_t BranchyDecFlags(const uint8_t value)
+{
+    return ((uint8_t)(value - 1) == 0) << 7 | 0x40 | ((value & 0x0F) == 0x00) << 5;
+}
+
+uint16_t BranchyDaa(uint8_t a, const uint8_t n, const uint8_t h, uint8_t c)
+{
+    if (n)
+    {
+        if (c) a -= 0x60;
+        if (h) a -= 0x06;
+    }
+    else
+    {
+        if (c || a > 0x99)
+        {
+            a += 0x60;
+            c = 1;
+        }
+        if (h || (a & 0x0F) > 0x09) a += 0x06;
+    }
+
+    return a | ((a == 0) << 7 | n << 6 | c << 4) << 8;
+}
+
+TEST_F(GameBoyBenchmark, ALU_TABLES)
+{
+    // Generated tables against the branchy reference (every index)
+    for (uint16_t index = 0; index < GB_DAA_TABLE_LENGHT; index++)
+    {
+        ASSERT_EQ(BranchyDaa(index & 0xFF, (index >> 8) & 1, (index >> 9) & 1, (index >> 10) & 1), gb_daa_table[index]) << index;
+    }
+
+    for (uint16_t value = 0; value < GB_INC_DEC_TABLE_LENGHT; value++)
+    {
+        ASSERT_EQ(BranchyIncFlags(value), gb_inc_flags[value]) << value;
+        ASSERT_EQ(BranchyDecFlags(value), gb_dec_flags[value]) << value;
+    }
+
+    for (uint16_t index = 0; index < GB_ADD_SUB_TABLE_LENGHT; index++)
+    {
+        const uint8_t a = index >> 5, b = (index >> 1) & 0x0F, carry = index & 1;
+
+        ASSERT_EQ(BranchyAddFlags(a, b, carry), gb_add_flags[GB_ADD_SUB_INDEX(a, b, carry)]) << index;
+        ASSERT_EQ(BranchySubFlags(a, b, carry), gb_sub_flags[GB_ADD_SUB_INDEX(a, b, carry)]) << index;
+    }
+
+    // Same pseudo random operands for both paths (xorshift), the checksums keep the work alive
+    std::vector<uint32_t> operands(BENCH_ALU_TABLE_EVALUATIONS);
+    uint32_t seed = 0x2545F491;
+
+    for (uint32_t &operand : operands)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        operand = seed;
+    }
+
+    uint32_t branchyChecksum = 0;
+    auto begin = std::chrono::steady_clock::now();
+
+    for (const uint32_t operand : operands)
+    {
+        const uint8_t a = operand, b = operand >> 8, carry = (operand >> 16) & 1;
+
+        branchyChecksum += BranchyDaa(a, (operand >> 17) & 1, (operand >> 18) & 1, carry);
+        branchyChecksum += BranchyAddFlags(a, b, carry) + BranchySubFlags(a, b, carry);
+        branchyChecksum += BranchyIncFlags(b) + BranchyDecFlags(b);
+    }
+
+    const std::chrono::duration<double> branchyElapsed = std::chrono::steady_clock::now() - begin;
+
+    uint32_t tableChecksum = 0;
+    begin = std::chrono::steady_clock::now();
+
+    for (const uint32_t operand : operands)
+    {
+        const uint8_t a = operand, b = operand >> 8, carry = (operand >> 16) & 1;
+
+        tableChecksum += gb_daa_table[GB_DAA_INDEX(a, operand >> 17, operand >> 18, carry)];
+        tableChecksum += gb_add_flags[GB_ADD_SUB_INDEX(a, b, carry)] + gb_sub_flags[GB_ADD_SUB_INDEX(a, b, carry)];
+        tableChecksum += gb_inc_flags[b] + gb_dec_flags[b];
+    }
+
+    const std::chrono::duration<double> tableElapsed = std::chrono::steady_clock::now() - begin;
+
+    EXPECT_EQ(branchyChecksum, tableChecksum);
+
+    // Five evaluations (DAA, ADD, SUB, INC, DEC) per operand set
+    const double evaluations = 5.0 * BENCH_ALU_TABLE_EVALUATIONS;
+    const double branchy = branchyElapsed.count() * 1e9 / evaluations;
+    const double table = tableElapsed.count() * 1e9 / evaluations;
+
+    MNE_Log("[BENCHMARK] BRANCHY ALU FLAGS: %.2f ns/instruction\n", branchy);
+    MNE_Log("[BENCHMARK] ALU TABLES:        %.2f ns/instruction (x%.2f)\n", table, branchy / table);
+}
+
+TEST_F(GameBoyBenchmark, FUSION)
+{
+    const uint64_t cycles = (uint64_t)BENCH_FRAME_CYCLES * BENCH_FUSION_FRAMES;
+
+    // Opcode pairs of the workload (function pointer core, every instruction is single stepped)
+    LoadCopyLoop(emulationCtx);
+    emulationCtx->pairProfile = GB_PairProfileCreate();
+    RunFnPtrCycles(emulationCtx, cycles);
+
+    GB_PairProfilePrintReport(emulationCtx->pairProfile, BENCH_PAIR_REPORT_LENGHT);
+    GB_PairProfileDestroy(emulationCtx->pairProfile);
+    emulationCtx->pairProfile = NULL;
+
+    // Block cache without superinstructions (reference)
+    ResetEmulation(emulationCtx);
+    if (emulationCtx->blockCache == NULL)
+    {
+        emulationCtx->blockCache = GB_BlockCacheCreate();
+    }
+    GB_BlockCacheSetFusions(emulationCtx->blockCache, 0);
+    LoadCopyLoop(emulationCtx);
+
+    auto begin = std::chrono::steady_clock::now();
+    RunCachedCycles(emulationCtx, cycles);
+    GB_FlagsSync(emulationCtx);
+    const std::chrono::duration<double> plainElapsed = std::chrono::steady_clock::now() - begin;
+
+    const GB_Registers plainRegisters = emulationCtx->registers;
+    const uint64_t plainInstructions = emulationCtx->instructions;
+    const uint64_t plainCycles = emulationCtx->cpuCycles;
+    std::vector<uint8_t> plainWram(emulationCtx->wram, emulationCtx->wram + GB_WRAM_SIZE);
+
+    // Default superinstructions
+    ResetEmulation(emulationCtx);
+    if (emulationCtx->blockCache == NULL)
+    {
+        emulationCtx->blockCache = GB_BlockCacheCreate();
+    }
+    GB_BlockCacheSetFusions(emulationCtx->blockCache, GB_FUSION_DEFAULT);
+    LoadCopyLoop(emulationCtx);
+
+    begin = std::chrono::steady_clock::now();
+    RunCachedCycles(emulationCtx, cycles);
+    GB_FlagsSync(emulationCtx);
+    const std::chrono::duration<double> fusedElapsed = std::chrono::steady_clock::now() - begin;
+
+    EXPECT_EQ(plainInstructions, emulationCtx->instructions);
+    EXPECT_EQ(plainCycles, emulationCtx->cpuCycles) << "FUSED HANDLERS MUST KEEP THE CYCLE ACCOUNTING";
+    EXPECT_EQ(0, memcmp(&plainRegisters, &emulationCtx->registers, sizeof(GB_Registers)));
+    EXPECT_EQ(0, memcmp(plainWram.data(), emulationCtx->wram, GB_WRAM_SIZE));
+
+    const GB_BlockCacheStats *stats = &emulationCtx->blockCache->stats;
+    EXPECT_GT(stats->fusions[GB_FUSION_LDI_A_HL_LD_DE_A], 0u);
+    EXPECT_GT(stats->fusions[GB_FUSION_LD_A_B_OR_C_JR_NZ], 0u);
+    EXPECT_GT(stats->fusions[GB_FUSION_DEC_B_JR_NZ], 0u);
+
+    const double plain = (double)plainInstructions / plainElapsed.count();
+    const double fused = (double)emulationCtx->instructions / fusedElapsed.count();
+
+    MNE_Log("[BENCHMARK] BLOCK CACHE:        %.2f M instructions/second\n", plain / 1e6);
+    MNE_Log("[BENCHMARK] SUPERINSTRUCTIONS:  %.2f M instructions/second (x%.2f)\n", fused / 1e6, fused / plain);
+}
+
+TEST_F(GameBoyBenchmark, PROFILER)
+{
+    const uint64_t cycles = (uint64_t)BENCH_FRAME_CYCLES * BENCH_PROFILER_FRAMES;
+
+    // Profiler off (reference, it only costs the profiling test)
+    ASSERT_TRUE(LoadBios(emulationCtx));
+
+    auto begin = std::chrono::steady_clock::now();
+    GB_RunCycles(emulationCtx, cycles);
+    const std::chrono::duration<double> plainElapsed = std::chrono::steady_clock::now() - begin;
+
+    const GB_Registers plainRegisters = emulationCtx->registers;
+    const uint64_t plainInstructions = emulationCtx->instructions;
+    const uint64_t plainCycles = emulationCtx->cpuCycles;
+
+    // Same run profiled
+    ResetEmulation(emulationCtx);
+    ASSERT_TRUE(LoadBios(emulationCtx));
+    GB_SetProfiling(emulationCtx, 1);
+
+    begin = std::chrono::steady_clock::now();
+    GB_RunCycles(emulationCtx, cycles);
+    const std::chrono::duration<double> profiledElapsed = std::chrono::steady_clock::now() - begin;
+
+    EXPECT_EQ(plainInstructions, emulationCtx->instructions);
+    EXPECT_EQ(plainCycles, emulationCtx->cpuCycles);
+    EXPECT_EQ(0, memcmp(&plainRegisters, &emulationCtx->registers, sizeof(GB_Registers)));
+
+    // Every instruction and cycle is attributed to one opcode (CB ones on their own table)
+    const GB_Profiler *profiler = emulationCtx->profiler;
+    GB_ProfilerEntry total = {};
+
+    for (int opcode = 0; opcode < GB_PROFILER_TABLE_LENGHT; opcode++)
+    {
+        total.executions += profiler->opcodes[opcode].executions + profiler->cbOpcodes[opcode].executions;
+        total.cycles += profiler->opcodes[opcode].cycles + profiler->cbOpcodes[opcode].cycles;
+    }
+
+    EXPECT_EQ(plainInstructions, total.executions);
+    EXPECT_EQ(plainCycles - emulationCtx->haltedCycles, total.cycles);
+    EXPECT_EQ(0u, profiler->opcodes[0xCB].executions);
+    EXPECT_GT(profiler->cbOpcodes[0x11].executions, 0u) << "RL C (logo decompression)";
+
+    // Paused, the counters are kept
+    const uint64_t pausedExecutions = profiler->opcodes[0xC5].executions;
+    GB_SetProfiling(emulationCtx, 0);
+    GB_RunCycles(emulationCtx, BENCH_FRAME_CYCLES);
+    EXPECT_EQ(pausedExecutions, profiler->opcodes[0xC5].executions);
+
+    GB_ProfilerPrintReport(profiler, BENCH_PROFILER_REPORT_LENGHT);
+    EXPECT_TRUE(GB_ProfilerWriteCsv(profiler, BENCH_PROFILER_CSV_PATH));
+
+    std::ifstream csv(BENCH_PROFILER_CSV_PATH);
+    std::string header;
+    std::getline(csv, header);
+    EXPECT_EQ("kind,code,name,executions,cycles,nanoseconds,ns_per_execution", header);
+    csv.close();
+    remove(BENCH_PROFILER_CSV_PATH);
+
+    // Only the report of the test (QuitProgram would print and write it again)
+    GB_ProfilerDestroy(emulationCtx->profiler);
+    emulationCtx->profiler = NULL;
+
+    const double plain = (double)plainInstructions / plainElapsed.count();
+    const double profiled = (double)plainInstructions / profiledElapsed.count();
+
+    MNE_Log("[BENCHMARK] PROFILER OFF: %.2f M instructions/second\n", plain / 1e6);
+    MNE_Log("[BENCHMARK] PROFILER ON:  %.2f M instructions/second (x%.2f)\n", profiled / 1e6, profiled / plain);
+}
+
+// Random vram/oam with the window and 8x16 objects on, every layer of the scanline renderer has work
+void LoadRenderScene(EmulationState *emulationCtx)
+{
+    uint32_t seed = 0xC0FFEE;
+
+    for (int i = 0; i < GB_VRAM_SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        emulationCtx->vram[i] = seed >> 16;
+    }
+
+    for (int i = 0; i < GB_OAM_SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        emulationCtx->oam[i] = seed >> 16;
+    }
+
+    GB_TileCacheInvalidate(emulationCtx->tileCache);
+
+    emulationCtx->registers.LCD_CONTROL.value = 0xE7;
+    emulationCtx->registers.LCD_SCX = 13;
+    emulationCtx->registers.LCD_SCY = 200;
+    emulationCtx->registers.LCD_WX = 87;
+    emulationCtx->registers.LCD_WY = 72;
+    emulationCtx->registers.LCD_BGP = 0xE4;
+    emulationCtx->registers.LCD_OBP0 = 0xD2;
+    emulationCtx->registers.LCD_OBP1 = 0x1B;
+    GB_LCD_SyncPalletes(emulationCtx);
+}
+
+// Renders BENCH_RENDER_FRAMES frames, returns the seconds
+double RenderFrames(EmulationState *emulationCtx)
+{
+    auto begin = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < BENCH_RENDER_FRAMES; frame++)
+    {
+        emulationCtx->windowLine = 0;
+
+        for (int ly = 0; ly < GB_DISPLAY_HEIGHT; ly++)
+        {
+            emulationCtx->registers.LCD_LY = ly;
+            GB_RenderScanLine(emulationCtx);
+        }
+    }
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    return elapsed.count();
+}
+
+TEST_F(GameBoyBenchmark, RENDER)
+{
+    LoadRenderScene(emulationCtx);
+
+    // Every tile row decoded on every use (reference)
+    GB_TileCache *tileCache = emulationCtx->tileCache;
+    emulationCtx->tileCache = NULL;
+
+    const double decodeElapsed = RenderFrames(emulationCtx);
+    std::vector<uint8_t> decodeFrame(emulationCtx->framebuffer, emulationCtx->framebuffer + GB_DISPLAY_WIDHT * GB_DISPLAY_HEIGHT);
+
+    // Decoded tile cache (static scene, only the first uses decode)
+    emulationCtx->tileCache = tileCache;
+
+    const double cachedElapsed = RenderFrames(emulationCtx);
+
+    EXPECT_EQ(0, memcmp(decodeFrame.data(), emulationCtx->framebuffer, decodeFrame.size()));
+    EXPECT_LE(tileCache->stats.decodes, (uint64_t)GB_TILE_COUNT);
+
+    const double lines = (double)BENCH_RENDER_FRAMES * GB_DISPLAY_HEIGHT;
+
+    GB_TileCachePrintStats(tileCache);
+    MNE_Log("[BENCHMARK] SCANLINE RENDERER: %.2f ns/line %.0f frames/second\n", decodeElapsed * 1e9 / lines,
+            BENCH_RENDER_FRAMES / decodeElapsed);
+    MNE_Log("[BENCHMARK] TILE CACHE:        %.2f ns/line %.0f frames/second (x%.2f)\n", cachedElapsed * 1e9 / lines,
+            BENCH_RENDER_FRAMES / cachedElapsed, decodeElapsed / cachedElapsed);
+}
+
+TEST_F(GameBoyBenchmark, PPU_KERNELS)
+{
+    const GB_PpuKernels *reference = GB_PpuKernelsGet(GB_PPU_SIMD_SCALAR);
+    const uint32_t palette[4] = {0x9BBC0FFF, 0x8BAC0FFF, 0x306230FF, 0x0F380FFF};
+
+    // Every (low, high) bitplane pair as a tile row, random shades as a frame
+    std::vector<uint8_t> rows(0x10000 * 2);
+    std::vector<uint8_t> shades(GB_DISPLAY_WIDHT * GB_DISPLAY_HEIGHT);
+    uint32_t seed = 0xC0FFEE;
+
+    for (uint32_t pair = 0; pair < 0x10000; pair++)
+    {
+        rows[pair * 2] = pair & 0xFF;
+        rows[pair * 2 + 1] = pair >> 8;
+    }
+
+    for (uint8_t &shade : shades)
+    {
+        seed = seed * 1103515245 + 12345;
+        shade = (seed >> 16) & 3;
+    }
+
+    std::vector<uint8_t> referenceIndices(0x10000 * GB_TILE_ROW_PIXELS);
+    std::vector<uint32_t> referencePixels(shades.size());
+    reference->decodeRows(referenceIndices.data(), rows.data(), 0x10000);
+    reference->expand(referencePixels.data(), shades.data(), palette, shades.size());
+
+    double scalarDecode = 0.0;
+    double scalarExpand = 0.0;
+
+    for (int level = GB_PPU_SIMD_SCALAR; level < GB_PPU_SIMD_COUNT; level++)
+    {
+        const GB_PpuKernels *kernels = GB_PpuKernelsGet((GB_PpuSimdLevel)level);
+
+        if (kernels == NULL)
+        {
+            MNE_Log("[BENCHMARK] PPU KERNELS %s: not supported by this host\n", level == GB_PPU_SIMD_SSE2 ? "SSE2" : "AVX2");
+            continue;
+        }
+
+        // Odd counts also run the scalar tails
+        std::vector<uint8_t> indices(referenceIndices.size());
+        std::vector<uint32_t> pixels(shades.size());
+
+        kernels->decodeRows(indices.data(), rows.data(), 0x10000);
+        kernels->expand(pixels.data(), shades.data(), palette, shades.size());
+        EXPECT_EQ(referenceIndices, indices) << kernels->name;
+        EXPECT_EQ(referencePixels, pixels) << kernels->name;
+
+        std::fill(indices.begin(), indices.end(), 0xFF);
+        kernels->decodeRows(indices.data(), rows.data(), 7);
+        EXPECT_EQ(0, memcmp(referenceIndices.data(), indices.data(), 7 * GB_TILE_ROW_PIXELS)) << kernels->name;
+        EXPECT_EQ(0xFF, indices[7 * GB_TILE_ROW_PIXELS]) << kernels->name;
+
+        kernels->expand(pixels.data(), shades.data(), palette, 0);
+        kernels->expand(pixels.data(), shades.data(), palette, 23);
+        EXPECT_EQ(0, memcmp(referencePixels.data(), pixels.data(), 23 * sizeof(uint32_t))) << kernels->name;
+
+        // Timed separately: vram tile data decoded / frame expanded to RGBA, checksums keep the work alive
+        uint32_t checksum = 0;
+        auto begin = std::chrono::steady_clock::now();
+
+        for (int pass = 0; pass < BENCH_PPU_KERNEL_PASSES; pass++)
+        {
+            kernels->decodeRows(indices.data(), &rows[(pass & 0xFF) * 2], GB_TILE_COUNT * GB_TILE_ROW_PIXELS);
+            checksum += indices[pass & 0xFF];
+        }
+
+        const std::chrono::duration<double> decodeElapsed = std::chrono::steady_clock::now() - begin;
+        begin = std::chrono::steady_clock::now();
+
+        for (int pass = 0; pass < BENCH_PPU_KERNEL_PASSES; pass++)
+        {
+            kernels->expand(pixels.data(), shades.data(), palette, shades.size());
+            checksum += pixels[pass];
+        }
+
+        const std::chrono::duration<double> expandElapsed = std::chrono::steady_clock::now() - begin;
+        EXPECT_NE(0u, checksum);
+
+        if (level == GB_PPU_SIMD_SCALAR)
+        {
+            scalarDecode = decodeElapsed.count();
+            scalarExpand = expandElapsed.count();
+        }
+
+        // Per 8 pixel span (one tile row decoded / 8 framebuffer pixels expanded)
+        const double decodeSpans = (double)BENCH_PPU_KERNEL_PASSES * GB_TILE_COUNT * GB_TILE_ROW_PIXELS;
+        const double expandSpans = (double)BENCH_PPU_KERNEL_PASSES * shades.size() / GB_TILE_ROW_PIXELS;
+
+        MNE_Log("[BENCHMARK] PPU KERNELS %-6s DECODE: %.2f ns/span (x%.2f) EXPAND: %.2f ns/span (x%.2f)%s\n", kernels->name,
+                decodeElapsed.count() * 1e9 / decodeSpans, scalarDecode / decodeElapsed.count(),
+                expandElapsed.count() * 1e9 / expandSpans, scalarExpand / expandElapsed.count(),
+                kernels == GB_PpuSelectKernels() ? " SELECTED" : "");
+    }
+}
+
+TEST_F(GameBoyBenchmark, FRAME_SKIP)
+{
+    // Every frame (reference), one out of four, none
+    const uint16_t intervals[] = {1, 4, 0};
+
+    GB_Registers referenceRegisters;
+    uint64_t referenceCycles = 0;
+    uint64_t referenceInstructions = 0;
+    std::vector<uint8_t> referenceFrame;
+    double referenceElapsed = 0.0;
+
+    for (const uint16_t interval : intervals)
+    {
+        ResetEmulation(emulationCtx);
+        LoadCopyLoop(emulationCtx);
+        LoadRenderScene(emulationCtx);
+
+        // Every STAT source on, the requests pile up in IF (IE is 0)
+        emulationCtx->registers.LCD_STAT.value = 0x78;
+        emulationCtx->registers.LCD_LYC = 0x40;
+        GB_SetRenderInterval(emulationCtx, interval);
+
+        auto begin = std::chrono::steady_clock::now();
+
+        for (int frame = 0; frame < BENCH_FRAME_SKIP_FRAMES; frame++)
+        {
+            GB_RunFrame(emulationCtx);
+        }
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+        const uint64_t frames = emulationCtx->ppuFrames;
+
+        EXPECT_EQ(interval ? frames / interval : 0, emulationCtx->renderedFrames) << interval;
+
+        if (interval == 1)
+        {
+            referenceRegisters = emulationCtx->registers;
+            referenceCycles = emulationCtx->cpuCycles;
+            referenceInstructions = emulationCtx->instructions;
+            referenceFrame.assign(emulationCtx->framebuffer, emulationCtx->framebuffer + GB_DISPLAY_WIDHT * GB_DISPLAY_HEIGHT);
+            referenceElapsed = elapsed.count();
+        }
+        else
+        {
+            // Same LY/STAT/IF and cpu state, only the rasterization is skipped
+            EXPECT_EQ(0, memcmp(&referenceRegisters, &emulationCtx->registers, sizeof(GB_Registers))) << interval;
+            EXPECT_EQ(referenceCycles, emulationCtx->cpuCycles) << interval;
+            EXPECT_EQ(referenceInstructions, emulationCtx->instructions) << interval;
+
+            // Static scene, a skipping run still holds the same picture (nothing at all without rasterization)
+            const std::vector<uint8_t> blank(referenceFrame.size(), 0);
+            EXPECT_EQ(interval ? referenceFrame : blank,
+                      std::vector<uint8_t>(emulationCtx->framebuffer, emulationCtx->framebuffer + referenceFrame.size())) << interval;
+        }
+
+        MNE_Log("[BENCHMARK] RENDER INTERVAL %u: %llu/%llu FRAMES RASTERIZED %.0f frames/second (x%.2f)\n", interval,
+                (unsigned long long)emulationCtx->renderedFrames, (unsigned long long)frames,
+                BENCH_FRAME_SKIP_FRAMES / elapsed.count(), referenceElapsed / elapsed.count());
+    }
+
+    EXPECT_TRUE(referenceRegisters.IF.LCD && referenceRegisters.IF.VBLANK);
+}
+
+TEST_F(GameBoyBenchmark, INSTANCES)
+{
+    ASSERT_TRUE(LoadBios(emulationCtx));
+
+    // Single instance (reference)
+    auto begin = std::chrono::steady_clock::now();
+    GB_RunCycles(emulationCtx, (uint64_t)BENCH_FRAME_CYCLES * BENCH_THREADED_FRAMES);
+    const std::chrono::duration<double> singleElapsed = std::chrono::steady_clock::now() - begin;
+
+    // Same workload on independent instances, one per thread (no shared mutable state between them)
+    EmulationState *instances[BENCH_INSTANCES];
+    std::vector<std::thread> workers;
+
+    for (int i = 0; i < BENCH_INSTANCES; i++)
+    {
+        instances[i] = static_cast<EmulationState *>(GB_CreateInstance());
+        GB_Initialize(instances[i], 0, NULL);
+        ASSERT_TRUE(LoadBios(instances[i]));
+    }
+
+    begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_INSTANCES; i++)
+    {
+        EmulationState *instance = instances[i];
+        workers.emplace_back([instance]() { GB_RunCycles(instance, (uint64_t)BENCH_FRAME_CYCLES * BENCH_THREADED_FRAMES); });
+    }
+
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    const std::chrono::duration<double> instancesElapsed = std::chrono::steady_clock::now() - begin;
+
+    uint64_t instructions = 0;
+    for (int i = 0; i < BENCH_INSTANCES; i++)
+    {
+        EXPECT_EQ(emulationCtx->cpuCycles, instances[i]->cpuCycles);
+        EXPECT_EQ(emulationCtx->instructions, instances[i]->instructions);
+        EXPECT_EQ(0, memcmp(&emulationCtx->registers, &instances[i]->registers, sizeof(GB_Registers)));
+        EXPECT_EQ(0, memcmp(emulationCtx->vram, instances[i]->vram, GB_VRAM_SIZE));
+
+        instructions += instances[i]->instructions;
+        GB_QuitProgram(instances[i]);
+        GB_DestroyInstance(instances[i]);
+    }
+
+    const double single = (double)emulationCtx->instructions / singleElapsed.count();
+    const double parallel = (double)instructions / instancesElapsed.count();
+
+    MNE_Log("[BENCHMARK] 1 INSTANCE:  %.2f M instructions/second\n", single / 1e6);
+    MNE_Log("[BENCHMARK] %d INSTANCES: %.2f M instructions/second (x%.2f)\n", BENCH_INSTANCES, parallel / 1e6, parallel / single);
+}
@@ -18,6 +18,7 @@ RESOURCES:
 #include <gtest/gtest.h>
 #include <stdlib.h>
 #include <fstream>
+#include <vector>
 
 extern "C"
 {
@@ -37,6 +38,15 @@ void CPU_ALU_Tests_16bit(const Emulation *emulator, EmulationState *emulationCtx
 void CPU_Jumps_Tests(const Emulation *emulator, EmulationState *emulationCtx);
 void CPU_BIOS_Test(const Emulation *emulator, EmulationState *emulationCtx);
 
+void Bus_Page_Tests(EmulationState *emulationCtx);
+void Scheduler_Tests(EmulationState *emulationCtx);
+void CPU_Halt_Tests(const Emulation *emulator, EmulationState *emulationCtx);
+void CPU_Idle_Loop_Tests(const Emulation *emulator, EmulationState *emulationCtx);
+void CPU_LD_R_R_Tests(EmulationState *emulationCtx);
+void CPU_R8_Operand_Tests(EmulationState *emulationCtx);
+void CPU_Interrupt_Tests(EmulationState *emulationCtx);
+void PPU_ScanLine_Tests(EmulationState *emulationCtx);
+
 class GameBoyFixture : public testing::Test
 {
 protected:
@@ -46,18 +56,16 @@ protected:
     void SetUp() override
     {
         // Initialize the emulation API
-        MNE_New(emulationCtx, 1, EmulationState);
-
         emulator = &GameBoyEmulator;
-        emulator->SetEmulationContext(static_cast<void *>(emulationCtx));
-        emulator->Initialize(NULL, NULL);
+        emulationCtx = static_cast<EmulationState *>(emulator->CreateInstance());
+        emulator->Initialize(emulationCtx, 0, NULL);
     }
 
     void TearDown() override
     {
         // Dispose emulation resources here
-        emulator->QuitProgram();
-        MNE_Delete(emulationCtx);
+        emulator->QuitProgram(emulationCtx);
+        emulator->DestroyInstance(emulationCtx);
     }
 };
 
@@ -78,22 +86,21 @@ void RunProgram(const Emulation *emulator, EmulationState *emulationCtx, const u
             emulationCtx->bank_00[i] = 0;
         }
     }
+    GB_BlockCacheInvalidate(emulationCtx->blockCache); // Program written without the bus
 
     // Restart pc
     emulationCtx->registers.PC = 0;
 
     // Process instructions...
-    // Iterations != program lenght so, for the  moment im iterating the emulation 4096 cycles to avoid any problems related to not executing all instructions.... (fix me)
-    for (int i = 0; i < 4096; i++)
+    // Cycles != program lenght so, for the  moment im running the emulation 4096 * 4 cycles to avoid any problems related to not executing all instructions.... (fix me)
+    const uint64_t budget = 4096 * 4;
+
+    // The cpu stopped before consuming the budget (invalid instruction, HALT and STOP sleep through it)
+    if (emulator->RunCycles(emulationCtx, budget) < budget)
     {
-        // Step emulation (if clock cycles == 0 is an error)
-        if (emulator->TickEmulation() == 0) 
-        {
-            // Check if processed op code was executed fine
-            EXPECT_TRUE(emulationCtx->registers.INSTRUCTION != GB_INVALID_INSTRUCTION);
-            MNE_Log("-----------------PROGRAM ERROR-----------------\n");
-            break;
-        }
+        // Check if processed op code was executed fine
+        EXPECT_TRUE(emulationCtx->registers.INSTRUCTION != GB_INVALID_INSTRUCTION);
+        MNE_Log("-----------------PROGRAM ERROR-----------------\n");
     }
 
     MNE_Log("----------------PROGRAM END------------------\n");
@@ -218,6 +225,8 @@ void CPU_ALU_Tests_8bit(const Emulation *emulator, EmulationState *emulationCtx)
     constexpr uint8_t xorInstruction[] = {0x3E, testValue, 0xAF}; // XOR A, A
     constexpr uint8_t orInstruction[] = {0x3E, testValue, 0xB7};  // OR A, A
     constexpr uint8_t cpInstruction[] = {0x3E, testValue, 0xBF};  // CP A, A
+    constexpr uint8_t daaAddInstruction[] = {0x3E, 0x45, 0xC6, 0x38, 0x27}; // LD A, 0x45 ; ADD A, 0x38 ; DAA
+    constexpr uint8_t daaSubInstruction[] = {0x3E, 0x42, 0xD6, 0x09, 0x27}; // LD A, 0x42 ; SUB A, 0x09 ; DAA
 
     // ALU instructions
     // ADD (testOverflowValue +testOverflowValue) = (510 & 0xFF) = 254, carry = 1
@@ -248,6 +257,13 @@ void CPU_ALU_Tests_8bit(const Emulation *emulator, EmulationState *emulationCtx)
     RunProgram(emulator, emulationCtx, cpInstruction, sizeof(cpInstruction));
 
     EXPECT_TRUE(emulationCtx->registers.ZERO_FLAG) << "CP A, A";
+
+    // BCD: 45 + 38 = 83, 42 - 09 = 33
+    RunProgram(emulator, emulationCtx, daaAddInstruction, sizeof(daaAddInstruction));
+    EXPECT_TRUE(emulationCtx->registers.A == 0x83) << "DAA (ADD)";
+
+    RunProgram(emulator, emulationCtx, daaSubInstruction, sizeof(daaSubInstruction));
+    EXPECT_TRUE(emulationCtx->registers.A == 0x33) << "DAA (SUB)";
 }
 
 void CPU_ALU_Tests_16bit(const Emulation *emulator, EmulationState *emulationCtx)
@@ -321,6 +337,552 @@ void CPU_BIOS_Test(const Emulation *emulator, EmulationState *emulationCtx)
     EXPECT_TRUE(emulationCtx->registers.INSTRUCTION == 0xE0) << "Last instruction must be (0xE0):	[LD (0xFF00+0x50),A	; 0x00fe;turn off DMG rom]";
 }
 
+void Bus_Page_Tests(EmulationState *emulationCtx)
+{
+    // Pointer pages (wram + echo ram mirror)
+    GB_BusWrite(emulationCtx, 0xC123, 0x42);
+    EXPECT_TRUE(emulationCtx->wram[0x123] == 0x42) << "WRAM WRITE MUST LAND ON THE WRAM BUFFER";
+    EXPECT_TRUE(GB_BusRead(emulationCtx, 0xE123) == 0x42) << "ECHO RAM MUST MIRROR WRAM";
+
+    GB_BusWrite(emulationCtx, 0xFDFF, 0x24);
+    EXPECT_TRUE(GB_BusRead(emulationCtx, 0xDDFF) == 0x24) << "ECHO RAM WRITES MUST MIRROR WRAM";
+
+    // Handler pages (io, hram, ie)
+    GB_BusWrite(emulationCtx, GB_SCY_REGISTER, 0x10);
+    EXPECT_TRUE(emulationCtx->registers.LCD_SCY == 0x10) << "IO PAGE MUST GO THROUGH THE IO HANDLER";
+
+    GB_BusWrite(emulationCtx, GB_HRAM_START, 0x99);
+    EXPECT_TRUE(GB_BusRead(emulationCtx, GB_HRAM_START) == 0x99);
+
+    // Rom writes go through the handler, reads are served by the page
+    GB_BusWrite(emulationCtx, 0x0150, 0x77);
+    EXPECT_TRUE(GB_BusRead(emulationCtx, 0x0150) == 0x77);
+    EXPECT_TRUE(emulationCtx->writePages[0x01] == NULL) << "ROM PAGES MUST NOT BE WRITABLE THROUGH A POINTER";
+
+    // Bank switch only swaps the pages
+    uint8_t bank[GB_ROM_SIZE] = {};
+    bank[0x0010] = 0x5A;
+
+    EXPECT_TRUE(emulationCtx->readPages[0x40] == NULL) << "NO MAPPER, NO BANK NN PAGES";
+    GB_BusMapRomBank(emulationCtx, bank);
+    EXPECT_TRUE(GB_BusRead(emulationCtx, 0x4010) == 0x5A);
+    GB_BusMapRomBank(emulationCtx, NULL);
+    EXPECT_TRUE(emulationCtx->readPages[0x40] == NULL);
+
+    // 32 KB rom (no mapper) maps its second bank, a header-less program unmaps it
+    std::vector<uint8_t> rom(GB_ROM_SIZE * 2, 0x00);
+    rom[GB_ROM_SIZE + 0x0010] = 0xA5;
+
+    GB_PopulateMemory(emulationCtx, rom.data(), rom.size());
+    EXPECT_TRUE(GB_BusRead(emulationCtx, 0x4010) == 0xA5) << "32 KB ROM BANK 01 MUST BE MAPPED";
+
+    GB_PopulateMemory(emulationCtx, rom.data(), 0x100);
+    EXPECT_TRUE(emulationCtx->readPages[0x40] == NULL);
+}
+
+TEST_F(GameBoyFixture, BUS_PAGES)
+{
+    Bus_Page_Tests(emulationCtx);
+}
+
+void Scheduler_Tests(EmulationState *emulationCtx)
+{
+    GB_Scheduler scheduler;
+    GB_Event event;
+
+    // Earliest deadline first, rescheduling moves the event, cancel removes it
+    GB_SchedulerReset(&scheduler);
+    GB_SchedulerSchedule(&scheduler, GB_EVENT_SERIAL, 300);
+    GB_SchedulerSchedule(&scheduler, GB_EVENT_PPU_MODE, 100);
+    GB_SchedulerSchedule(&scheduler, GB_EVENT_DMA, 200);
+    GB_SchedulerSchedule(&scheduler, GB_EVENT_SERIAL, 50);
+    GB_SchedulerCancel(&scheduler, GB_EVENT_DMA);
+
+    EXPECT_TRUE(GB_SchedulerNextDeadline(&scheduler) == 50);
+    EXPECT_FALSE(GB_SchedulerPopDue(&scheduler, 49, &event));
+    EXPECT_TRUE(GB_SchedulerPopDue(&scheduler, 1000, &event) && event.type == GB_EVENT_SERIAL);
+    EXPECT_TRUE(GB_SchedulerPopDue(&scheduler, 1000, &event) && event.type == GB_EVENT_PPU_MODE);
+    EXPECT_FALSE(GB_SchedulerPopDue(&scheduler, 1000, &event)) << "CANCELED EVENTS MUST NOT BE DISPATCHED";
+
+    // TIMA overflow (TAC = enabled, 16 cycles per increment) requests the timer interrupt and reloads TMA
+    GB_BusWrite(emulationCtx, GB_TMA_REGISTER, 0xF0);
+    GB_BusWrite(emulationCtx, GB_TIMA_REGISTER, 0xFE);
+    GB_BusWrite(emulationCtx, GB_TAC_REGISTER, GB_TAC_ENABLE | 0x01);
+
+    GB_AdvanceClock(emulationCtx, 16);
+    EXPECT_TRUE(GB_BusRead(emulationCtx, GB_TIMA_REGISTER) == 0xFF);
+    EXPECT_FALSE(emulationCtx->registers.IF.TIMER);
+
+    GB_AdvanceClock(emulationCtx, 16);
+    EXPECT_TRUE(GB_BusRead(emulationCtx, GB_TIMA_REGISTER) == 0xF0);
+    EXPECT_TRUE(emulationCtx->registers.IF.TIMER) << "TIMA OVERFLOW MUST REQUEST THE TIMER INTERRUPT";
+
+    // A whole frame walks LY through every line and requests VBLANK once
+    emulationCtx->registers.IF.VBLANK = 0;
+    const uint8_t ly = emulationCtx->registers.LCD_LY;
+
+    for (int i = 0; i < 70224 / 4; i++)
+    {
+        GB_AdvanceClock(emulationCtx, 4);
+    }
+
+    EXPECT_TRUE(emulationCtx->registers.LCD_LY == ly) << "LY MUST WRAP AFTER 154 LINES";
+    EXPECT_TRUE(emulationCtx->registers.IF.VBLANK);
+}
+
+TEST_F(GameBoyFixture, SCHEDULER)
+{
+    Scheduler_Tests(emulationCtx);
+}
+
+void CPU_Halt_Tests(const Emulation *emulator, EmulationState *emulationCtx)
+{
+    constexpr uint8_t haltInstruction[] = {0x76}; // HALT
+
+    // Without enabled interrupts the cpu sleeps for the whole budget, skipping from event to event
+    GB_BusWrite(emulationCtx, GB_IE_REGISTER, 0x00);
+    RunProgram(emulator, emulationCtx, haltInstruction, sizeof(haltInstruction));
+
+    EXPECT_TRUE(emulationCtx->halted) << "HALT MUST PUT THE CPU TO SLEEP";
+    EXPECT_TRUE(emulationCtx->registers.PC == 0x01);
+    EXPECT_TRUE(emulationCtx->haltedCycles + gb_opcodes_cycles[0x76] >= emulationCtx->cpuCycles) << "HALTED CYCLES MUST BE SKIPPED";
+    EXPECT_TRUE(GB_HaltedRatio(emulationCtx) > 0.9);
+
+    // VBLANK wakes it up even with IME = 0 (no interrupt handler call)
+    GB_BusWrite(emulationCtx, GB_IE_REGISTER, 0x01);
+    emulator->RunCycles(emulationCtx, GB_FRAME_CYCLES);
+
+    EXPECT_FALSE(emulationCtx->halted) << "VBLANK MUST WAKE UP THE CPU";
+    EXPECT_TRUE(emulationCtx->registers.IF.VBLANK);
+    EXPECT_TRUE(emulationCtx->registers.PC == 0x01);
+
+    // STOP (10 00) sleeps the same way (no joypad yet) and skips its second byte
+    constexpr uint8_t stopInstruction[] = {0x10, 0x00}; // STOP
+
+    GB_BusWrite(emulationCtx, GB_IE_REGISTER, 0x00);
+    RunProgram(emulator, emulationCtx, stopInstruction, sizeof(stopInstruction));
+
+    EXPECT_TRUE(emulationCtx->halted) << "STOP MUST PUT THE CPU TO SLEEP";
+    EXPECT_TRUE(emulationCtx->registers.PC == 0x02) << "STOP IS TWO BYTES LONG";
+}
+
+TEST_F(GameBoyFixture, HALT)
+{
+    CPU_Halt_Tests(emulator, emulationCtx);
+}
+
+void CPU_Idle_Loop_Tests(const Emulation *emulator, EmulationState *emulationCtx)
+{
+    // Waits for LY == 0x10 then halts (IE = 0, sleeps until the end of the budget)
+    constexpr uint8_t pollLY[] = {0xF0, 0x44, 0xFE, 0x10, 0x20, 0xFA, 0x76}; // LDH A,(LY); CP 0x10; JR NZ,-6; HALT
+
+    // Same program single stepped on a second instance without idle loop detection
+    EmulationState *reference = static_cast<EmulationState *>(emulator->CreateInstance());
+    emulator->Initialize(reference, 0, NULL);
+    GB_IdleLoopCacheDestroy(reference->idleLoops);
+    reference->idleLoops = NULL;
+
+    RunProgram(emulator, emulationCtx, pollLY, sizeof(pollLY));
+    RunProgram(emulator, reference, pollLY, sizeof(pollLY));
+
+    const GB_IdleLoop *loop = &emulationCtx->idleLoops->loops[0];
+
+    EXPECT_TRUE(loop->state == GB_IDLE_LOOP_ACCEPTED) << "LY POLLING LOOP MUST BE DETECTED";
+    EXPECT_TRUE(loop->start == 0x00 && loop->end == 0x05 && loop->polledAddress == GB_LY_REGISTER);
+    EXPECT_TRUE(loop->skips > 0 && emulationCtx->idleLoops->skippedCycles > 0);
+
+    // Skipping whole iterations has to end exactly where the single stepped loop did
+    EXPECT_TRUE(emulationCtx->halted && emulationCtx->registers.PC == 0x07);
+    EXPECT_TRUE(emulationCtx->registers.A == 0x10);
+    EXPECT_TRUE(emulationCtx->cpuCycles == reference->cpuCycles);
+    EXPECT_TRUE(emulationCtx->instructions == reference->instructions) << "SKIPPED ITERATIONS MUST BE COUNTED";
+    EXPECT_TRUE(emulationCtx->haltedCycles == reference->haltedCycles) << "THE LOOP MUST EXIT ON THE SAME CYCLE";
+    EXPECT_TRUE(memcmp(&emulationCtx->registers, &reference->registers, sizeof(GB_Registers)) == 0);
+
+    emulator->QuitProgram(reference);
+    emulator->DestroyInstance(reference);
+}
+
+TEST_F(GameBoyFixture, IDLE_LOOP)
+{
+    CPU_Idle_Loop_Tests(emulator, emulationCtx);
+}
+
+void CPU_LD_R_R_Tests(EmulationState *emulationCtx)
+{
+    // Every specialized LD r,r' handler against the generic r8 operand access (GB_GetReg8/GB_SetReg8)
+    const uint8_t registers[] = {0x11, 0x22, 0x33, 0x44, 0x80, 0xFF, 0x00, 0x77}; // B,C,D,E,H,L,-,A (HL = 0xFF80)
+
+    for (uint16_t opcode = 0x40; opcode < 0x80; opcode++)
+    {
+        GameBoyInstruction *instruction = GB_DecodeInstruction(opcode);
+
+        if (opcode == 0x76)
+        {
+            EXPECT_TRUE(instruction->handler == (instructionFnPtrGb) GB_HALT);
+            continue;
+        }
+
+        const uint8_t dst = (opcode >> 3) & 0x07;
+        const uint8_t src = opcode & 0x07;
+        emulationCtx->registers.INSTRUCTION = opcode;
+
+        for (uint8_t r = 0; r < 8; r++)
+        {
+            if (r != GB_HL_INDIRECT_OFFSET) GB_SetReg8(emulationCtx, r, registers[r]);
+        }
+        GB_BusWrite(emulationCtx, GB_HRAM_START, 0x66);
+        GB_SetReg8(emulationCtx, dst, GB_GetReg8(emulationCtx, src));
+
+        const GB_Registers expected = emulationCtx->registers;
+        const uint8_t expectedMemory = GB_BusRead(emulationCtx, GB_HRAM_START);
+
+        for (uint8_t r = 0; r < 8; r++)
+        {
+            if (r != GB_HL_INDIRECT_OFFSET) GB_SetReg8(emulationCtx, r, registers[r]);
+        }
+        GB_BusWrite(emulationCtx, GB_HRAM_START, 0x66);
+
+        EXPECT_TRUE(instruction->handler(emulationCtx) == gb_opcodes_cycles[opcode]) << std::hex << opcode;
+        EXPECT_TRUE(memcmp(&expected, &emulationCtx->registers, sizeof(GB_Registers)) == 0) << std::hex << opcode;
+        EXPECT_TRUE(expectedMemory == GB_BusRead(emulationCtx, GB_HRAM_START)) << std::hex << opcode;
+    }
+}
+
+TEST_F(GameBoyFixture, LD_R_R)
+{
+    CPU_LD_R_R_Tests(emulationCtx);
+}
+
+// Runs one (CB prefixed when cb) instruction from WRAM with the given registers, carry set and (HL) = memory
+static void RunR8Instruction(EmulationState *emulationCtx, const uint8_t *registers, const uint8_t memory, const uint8_t opcode, const uint8_t cb)
+{
+    for (uint8_t r = 0; r < 8; r++)
+    {
+        if (r != GB_HL_INDIRECT_OFFSET) GB_SetReg8(emulationCtx, r, registers[r]);
+    }
+    GB_FlagsWrite(emulationCtx, 0x10);
+    GB_BusWrite(emulationCtx, emulationCtx->registers.HL, memory);
+
+    emulationCtx->registers.PC = GB_WRAM_START;
+    GB_BusWrite(emulationCtx, GB_WRAM_START, opcode);
+    emulationCtx->registers.INSTRUCTION = cb ? 0xCB : opcode;
+
+    if (cb)
+    {
+        GB_CB_PREFIX(emulationCtx);
+    }
+    else
+    {
+        GB_DecodeInstruction(opcode)->handler(emulationCtx);
+    }
+    GB_FlagsSync(emulationCtx);
+}
+
+void CPU_R8_Operand_Tests(EmulationState *emulationCtx)
+{
+    // Register operand handlers (GB_R8_LIST and the CB operands) against the (HL) encoding of the same operation
+    constexpr uint8_t registers[8] = {0x13, 0x80, 0x0F, 0xFE, 0xFF, 0x80, 0x00, 0x3C}; // HL = 0xFF80 (HRAM)
+
+    for (uint8_t cb = 0; cb < 2; cb++)
+    {
+        for (uint16_t opcode = 0x00; opcode < 0x100; opcode++)
+        {
+            const uint8_t alu = !cb && opcode >= 0x80 && opcode < 0xC0;
+            const uint8_t incDec = !cb && opcode < 0x40 && ((opcode & 0x07) == 0x04 || (opcode & 0x07) == 0x05);
+            const uint8_t r = cb || alu ? opcode & 0x07 : (opcode >> 3) & 0x07;
+
+            if (!(cb || alu || incDec) || r == GB_HL_INDIRECT_OFFSET)
+            {
+                continue;
+            }
+
+            const uint8_t hlOpcode = cb || alu ? (opcode & 0xF8) | GB_HL_INDIRECT_OFFSET : (opcode & 0xC7) | GB_HL_INDIRECT_OFFSET << 3;
+
+            RunR8Instruction(emulationCtx, registers, registers[r], hlOpcode, cb);
+            const uint8_t expectedA = emulationCtx->registers.A;
+            const uint8_t expectedF = emulationCtx->registers.F;
+            const uint8_t expectedOperand = GB_BusRead(emulationCtx, emulationCtx->registers.HL);
+
+            RunR8Instruction(emulationCtx, registers, registers[r], opcode, cb);
+
+            EXPECT_TRUE(emulationCtx->registers.F == expectedF) << (cb ? "CB " : "") << std::hex << opcode;
+            EXPECT_TRUE(alu ? emulationCtx->registers.A == expectedA : GB_GetReg8(emulationCtx, r) == expectedOperand) << (cb ? "CB " : "") << std::hex << opcode;
+        }
+    }
+}
+
+TEST_F(GameBoyFixture, R8_OPERANDS)
+{
+    CPU_R8_Operand_Tests(emulationCtx);
+}
+
+void CPU_Interrupt_Tests(EmulationState *emulationCtx)
+{
+    emulationCtx->registers.PC = 0x1234;
+    emulationCtx->registers.SP = 0xFFFE;
+    emulationCtx->ime = 1;
+
+    // VBLANK is requested but not enabled, TIMER wins over SERIAL
+    GB_BusWrite(emulationCtx, GB_IE_REGISTER, GB_INTERRUPT_TIMER | GB_INTERRUPT_SERIAL);
+    GB_BusWrite(emulationCtx, GB_IF_REGISTER, GB_INTERRUPT_VBLANK | GB_INTERRUPT_SERIAL);
+    GB_InterruptRequest(emulationCtx, GB_INTERRUPT_TIMER);
+    EXPECT_TRUE(emulationCtx->interruptPending);
+
+    EXPECT_EQ(GB_INTERRUPT_DISPATCH_CYCLES, GB_HandleInterrupts(emulationCtx));
+    EXPECT_EQ(20, GB_INTERRUPT_DISPATCH_CYCLES) << "DISPATCH IS 5 M-CYCLES";
+    EXPECT_TRUE(emulationCtx->registers.PC == 0x50) << "TIMER VECTOR";
+    EXPECT_TRUE(emulationCtx->registers.IF.value == (GB_INTERRUPT_VBLANK | GB_INTERRUPT_SERIAL));
+    EXPECT_TRUE(emulationCtx->ime == 0);
+    EXPECT_TRUE(GB_BusRead(emulationCtx, 0xFFFC) == 0x34 && GB_BusRead(emulationCtx, 0xFFFD) == 0x12) << "PC MUST BE PUSHED";
+
+    // IME = 0 keeps the request pending
+    EXPECT_TRUE(GB_HandleInterrupts(emulationCtx) == 0);
+    EXPECT_TRUE(emulationCtx->registers.PC == 0x50);
+
+    emulationCtx->ime = 1;
+    EXPECT_EQ(GB_INTERRUPT_DISPATCH_CYCLES, GB_HandleInterrupts(emulationCtx));
+    EXPECT_TRUE(emulationCtx->registers.PC == 0x58) << "SERIAL VECTOR";
+    EXPECT_TRUE(GB_BusRead(emulationCtx, 0xFFFA) == 0x50 && GB_BusRead(emulationCtx, 0xFFFB) == 0x00) << "TIMER VECTOR MUST BE PUSHED";
+
+    // Only the disabled VBLANK request is left, nothing is dispatched (PC and SP untouched)
+    emulationCtx->ime = 1;
+    EXPECT_FALSE(emulationCtx->interruptPending);
+    EXPECT_TRUE(GB_HandleInterrupts(emulationCtx) == 0);
+    EXPECT_TRUE(emulationCtx->registers.PC == 0x58 && emulationCtx->registers.SP == 0xFFFA);
+
+    GB_BusWrite(emulationCtx, GB_IE_REGISTER, GB_INTERRUPT_VBLANK);
+    EXPECT_TRUE(emulationCtx->interruptPending);
+    EXPECT_EQ(GB_INTERRUPT_DISPATCH_CYCLES, GB_HandleInterrupts(emulationCtx));
+    EXPECT_TRUE(emulationCtx->registers.PC == 0x40) << "VBLANK VECTOR";
+    EXPECT_TRUE(emulationCtx->registers.SP == 0xFFF8) << "SP";
+    EXPECT_TRUE(GB_BusRead(emulationCtx, 0xFFF8) == 0x58 && GB_BusRead(emulationCtx, 0xFFF9) == 0x00) << "SERIAL VECTOR MUST BE PUSHED";
+    EXPECT_FALSE(emulationCtx->interruptPending);
+}
+
+TEST_F(GameBoyFixture, INTERRUPTS)
+{
+    CPU_Interrupt_Tests(emulationCtx);
+}
+
+// Bit at a time color index of a tile map pixel (reference for the decode table)
+static uint8_t ReferenceMapColor(const EmulationState *emulationCtx, const uint16_t map, const uint8_t x, const uint8_t y)
+{
+    const uint8_t tile = emulationCtx->vram[map - GB_VRAM_START + (y / 8) * GB_TILE_MAP_WIDTH + x / 8];
+    const uint16_t address = (emulationCtx->registers.LCD_CONTROL.value & GB_LCDC_TILE_DATA) ? 0x8000 + tile * 16 : 0x9000 + (int8_t)tile * 16;
+    const uint8_t low = emulationCtx->vram[address - GB_VRAM_START + (y % 8) * 2];
+    const uint8_t high = emulationCtx->vram[address - GB_VRAM_START + (y % 8) * 2 + 1];
+    const uint8_t bit = 7 - x % 8;
+
+    return ((low >> bit) & 1) | (((high >> bit) & 1) << 1);
+}
+
+// Straight per pixel renderer of one line (windowLine is the window row of this line)
+static void ReferenceScanLine(const EmulationState *emulationCtx, uint8_t *line, const uint8_t windowLine, uint8_t *windowVisible)
+{
+    const GB_Registers *registers = &emulationCtx->registers;
+    const uint8_t lcdc = registers->LCD_CONTROL.value;
+    const uint8_t ly = registers->LCD_LY;
+    const uint8_t height = (lcdc & GB_LCDC_OBJ_SIZE) ? 16 : 8;
+
+    *windowVisible = (lcdc & GB_LCDC_BG_WINDOW_ENABLE) && (lcdc & GB_LCDC_WINDOW_ENABLE) && ly >= registers->LCD_WY && registers->LCD_WX <= 166;
+
+    // Objects on the line in OAM order (first 10)
+    std::vector<int> objects;
+    for (int i = 0; i < GB_OBJ_COUNT && objects.size() < GB_OBJ_PER_LINE; i++)
+    {
+        const int top = emulationCtx->oam[i * 4] - 16;
+        if (ly >= top && ly < top + height) objects.push_back(i);
+    }
+
+    for (int x = 0; x < GB_DISPLAY_WIDHT; x++)
+    {
+        uint8_t color = 0;
+
+        if (lcdc & GB_LCDC_BG_WINDOW_ENABLE)
+        {
+            if (*windowVisible && x >= registers->LCD_WX - 7)
+            {
+                const uint16_t map = (lcdc & GB_LCDC_WINDOW_TILE_MAP) ? GB_TILE_MAP_1 : GB_TILE_MAP_0;
+                color = ReferenceMapColor(emulationCtx, map, x - (registers->LCD_WX - 7), windowLine);
+            }
+            else
+            {
+                const uint16_t map = (lcdc & GB_LCDC_BG_TILE_MAP) ? GB_TILE_MAP_1 : GB_TILE_MAP_0;
+                color = ReferenceMapColor(emulationCtx, map, (x + registers->LCD_SCX) & 0xFF, (ly + registers->LCD_SCY) & 0xFF);
+            }
+        }
+
+        line[x] = (registers->LCD_BGP >> (color * 2)) & 3;
+
+        if (!(lcdc & GB_LCDC_OBJ_ENABLE)) continue;
+
+        // Smallest X wins, then the OAM index
+        int winner = -1;
+        uint8_t winnerColor = 0;
+
+        for (const int i : objects)
+        {
+            const uint8_t *object = &emulationCtx->oam[i * 4];
+            const int column = x - (object[1] - 8);
+
+            if (column < 0 || column > 7) continue;
+
+            int row = ly - (object[0] - 16);
+            if (object[3] & GB_OBJ_Y_FLIP) row = height - 1 - row;
+
+            const uint8_t tile = height == 16 ? object[2] & 0xFE : object[2];
+            const uint8_t low = emulationCtx->vram[tile * 16 + row * 2];
+            const uint8_t high = emulationCtx->vram[tile * 16 + row * 2 + 1];
+            const uint8_t bit = (object[3] & GB_OBJ_X_FLIP) ? column : 7 - column;
+            const uint8_t objectColor = ((low >> bit) & 1) | (((high >> bit) & 1) << 1);
+
+            if (objectColor != 0 && (winner < 0 || object[1] < emulationCtx->oam[winner * 4 + 1]))
+            {
+                winner = i;
+                winnerColor = objectColor;
+            }
+        }
+
+        if (winner >= 0 && !((emulationCtx->oam[winner * 4 + 3] & GB_OBJ_BG_PRIORITY) && color != 0))
+        {
+            const uint8_t palette = (emulationCtx->oam[winner * 4 + 3] & GB_OBJ_PALETTE) ? registers->LCD_OBP1 : registers->LCD_OBP0;
+            line[x] = (palette >> (winnerColor * 2)) & 3;
+        }
+    }
+}
+
+// Renders the 144 lines of a frame and compares every one of them with the reference
+static void ExpectFrameMatchesReference(EmulationState *emulationCtx)
+{
+    GB_Registers *registers = &emulationCtx->registers;
+    const uint8_t lcdc = registers->LCD_CONTROL.value;
+    uint8_t windowLine = 0;
+
+    emulationCtx->windowLine = 0;
+
+    for (int ly = 0; ly < GB_DISPLAY_HEIGHT; ly++)
+    {
+        uint8_t expected[GB_DISPLAY_WIDHT];
+        uint8_t windowVisible = 0;
+
+        registers->LCD_LY = ly;
+        GB_RenderScanLine(emulationCtx);
+
+        if (lcdc & GB_LCDC_LCD_ENABLE)
+        {
+            ReferenceScanLine(emulationCtx, expected, windowLine, &windowVisible);
+        }
+        else
+        {
+            memset(expected, 0, sizeof(expected));
+        }
+
+        windowLine += windowVisible;
+
+        EXPECT_TRUE(memcmp(expected, &emulationCtx->framebuffer[ly * GB_DISPLAY_WIDHT], GB_DISPLAY_WIDHT) == 0)
+            << "LCDC: " << std::hex << (int)lcdc << " LY: " << std::dec << ly;
+    }
+
+    EXPECT_TRUE(emulationCtx->windowLine == windowLine) << "WINDOW LINE ONLY COUNTS THE LINES WITH THE WINDOW";
+}
+
+void PPU_ScanLine_Tests(EmulationState *emulationCtx)
+{
+    // Random tiles, maps and objects (same seed every run)
+    uint32_t seed = 0x1234567;
+    auto random = [&seed]() { seed = seed * 1103515245 + 12345; return (uint8_t)(seed >> 16); };
+
+    for (int i = 0; i < GB_VRAM_SIZE; i++) emulationCtx->vram[i] = random();
+
+    // Objects around the screen, a few on the same X to check the OAM order
+    for (int i = 0; i < GB_OBJ_COUNT; i++)
+    {
+        emulationCtx->oam[i * 4] = random() % 170;
+        emulationCtx->oam[i * 4 + 1] = i % 8 == 0 ? 40 : random() % 176;
+        emulationCtx->oam[i * 4 + 2] = random();
+        emulationCtx->oam[i * 4 + 3] = random() & 0xF0;
+    }
+
+    GB_Registers *registers = &emulationCtx->registers;
+    registers->LCD_BGP = 0xE4;
+    registers->LCD_OBP0 = 0xD2;
+    registers->LCD_OBP1 = 0x1B;
+    GB_LCD_SyncPalletes(emulationCtx);
+
+    // LCDC, SCX, SCY, WX, WY
+    const uint8_t configurations[][5] = {
+        {0x91, 0, 0, 0, 0},      // boot rom setup (bg, 0x8000 tile data)
+        {0x83, 13, 200, 0, 0},   // bg + 8x8 objects, 0x9000 tile data, fine scroll
+        {0xE7, 251, 77, 47, 30}, // window on map 1, 8x16 objects
+        {0xB3, 3, 5, 3, 100},    // window starting before the left edge
+        {0xFF, 100, 255, 166, 0},// everything, window on the last column
+        {0xE6, 8, 8, 7, 0},      // bg/window off, objects only
+        {0x01, 0, 0, 7, 0},      // display off (blank)
+    };
+
+    // Random vram written behind the bus
+    GB_TileCacheInvalidate(emulationCtx->tileCache);
+
+    for (const auto &configuration : configurations)
+    {
+        registers->LCD_CONTROL.value = configuration[0];
+        registers->LCD_SCX = configuration[1];
+        registers->LCD_SCY = configuration[2];
+        registers->LCD_WX = configuration[3];
+        registers->LCD_WY = configuration[4];
+
+        ExpectFrameMatchesReference(emulationCtx);
+    }
+
+    // Tile cache: every tile is decoded once, bus writes only dirty the tile they hit (tile maps don't)
+    GB_TileCache *cache = emulationCtx->tileCache;
+    EXPECT_TRUE(cache->stats.decodes <= GB_TILE_COUNT);
+    EXPECT_TRUE(cache->stats.hits > cache->stats.decodes);
+
+    GB_TileCacheDecode(cache, emulationCtx->vram, 0);
+    GB_TileCacheDecode(cache, emulationCtx->vram, 300);
+    const uint64_t invalidations = cache->stats.invalidations;
+
+    GB_BusWrite(emulationCtx, 0x8000, 0xFF);
+    GB_BusWrite(emulationCtx, 0x8001, 0x00);
+    GB_BusWrite(emulationCtx, 0x92C0, 0xAA);
+    GB_BusWrite(emulationCtx, GB_TILE_MAP_0, 0x01);
+    EXPECT_TRUE(cache->dirty[0] && cache->dirty[300]);
+    EXPECT_TRUE(cache->stats.invalidations == invalidations + 2) << "TWO TILES WRITTEN";
+    EXPECT_TRUE(GB_BusRead(emulationCtx, 0x92C0) == 0xAA && GB_BusRead(emulationCtx, GB_TILE_MAP_0) == 0x01);
+
+    const uint64_t decodes = cache->stats.decodes;
+    const uint8_t *row = GB_TileCacheRow(cache, emulationCtx->vram, 0, 0);
+    EXPECT_TRUE(cache->stats.decodes == decodes + 1);
+    EXPECT_TRUE(row[0] == 1 && row[7] == 1) << "LOW PLANE 0xFF, HIGH PLANE 0x00";
+
+    // Same frame as the reference after the writes
+    registers->LCD_CONTROL.value = 0xE7;
+    ExpectFrameMatchesReference(emulationCtx);
+
+    // Palette writes through the bus rebuild their tables, the next frame uses them without a sync
+    GB_BusWrite(emulationCtx, GB_BGP_REGISTER, 0x1B);
+    GB_BusWrite(emulationCtx, GB_OBP0_REGISTER, 0xE4);
+    GB_BusWrite(emulationCtx, GB_OBP1_REGISTER, 0x6C);
+    EXPECT_TRUE(emulationCtx->palletes[GB_PALLETE_BG].shades[0] == 3 && emulationCtx->palletes[GB_PALLETE_BG].shades[3] == 0);
+    EXPECT_TRUE(emulationCtx->palletes[GB_PALLETE_OBJ1].pairs[GB_PALLETE_PAIR(1, 2)][0] == 3);
+    EXPECT_TRUE(emulationCtx->palletes[GB_PALLETE_OBJ1].pairs[GB_PALLETE_PAIR(1, 2)][1] == 2);
+    EXPECT_TRUE(GB_BusRead(emulationCtx, GB_OBP1_REGISTER) == 0x6C);
+    ExpectFrameMatchesReference(emulationCtx);
+
+    // Shades are mapped to the green palette by GB_OnRender
+    std::vector<uint32_t> pixels(GB_DISPLAY_WIDHT * GB_DISPLAY_HEIGHT);
+    emulationCtx->framebuffer[0] = 3;
+    GB_OnRender(emulationCtx, pixels.data(), GB_DISPLAY_WIDHT, GB_DISPLAY_HEIGHT);
+    EXPECT_TRUE(pixels[0] == 0x0F380FFF);
+}
+
+TEST_F(GameBoyFixture, PPU_SCANLINE)
+{
+    PPU_ScanLine_Tests(emulationCtx);
+}
+
 // TEST_F(GameBoyFixture, Load_And_Store_8bit)
 // {
 //     Load_And_Store_Tests_8bit(emulator, emulationCtx);
@@ -331,15 +893,15 @@ void CPU_BIOS_Test(const Emulation *emulator, EmulationState *emulationCtx)
 //     Load_And_Store_Tests_16bit(emulator, emulationCtx);
 // }
 
-// TEST_F(GameBoyFixture, ALU_8Bit)
-// {
-//     CPU_ALU_Tests_8bit(emulator, emulationCtx);
-// }
+TEST_F(GameBoyFixture, ALU_8Bit)
+{
+    CPU_ALU_Tests_8bit(emulator, emulationCtx);
+}
 
-// TEST_F(GameBoyFixture, ALU_16Bit)
-// {
-//     CPU_ALU_Tests_16bit(emulator, emulationCtx);
-// }
+TEST_F(GameBoyFixture, ALU_16Bit)
+{
+    CPU_ALU_Tests_16bit(emulator, emulationCtx);
+}
 
 // TEST_F(GameBoyFixture, CPU_JUMPS)
 // {
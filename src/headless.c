@@ -0,0 +1,372 @@
+// MINEMU HEADLESS RUNNER (CORE + STATIC LINKED EMULATORS, NO UI)
+/*
+    Runs every rom to a frame or cycle budget on a pool of worker threads (one emulator instance per rom) and writes
+    one JSON line per rom: framebuffer hash, registers and throughput.
+
+    usage: MINEMU_HEADLESS [--frames N | --cycles N] [--threads N] [--list file] [--profile] [--render-every N] rom...
+    - The emulator is picked from the rom extension (.gb .gbc: game boy, .ch8: chip8).
+    - --list reads one rom path per line.
+    - --profile runs the game boy roms on the opcode profiler (report on stderr, CSV on <rom name>.profile.csv).
+    - --render-every rasterizes one game boy frame out of N (0: none, LY/STAT timing and interrupts are unchanged), the
+      hash is the one of the last rasterized frame.
+    - JSON lines go to stdout, emulator logs (MNE_Log) are redirected to stderr.
+*/
+#define _POSIX_C_SOURCE 200809L
+
+#include <minemu.h>
+#include <CC8_Chip8.h>
+#include <GameBoy.h>
+
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define HEADLESS_DEFAULT_FRAMES 600
+#define HEADLESS_MAX_ROMS 4096
+#define HEADLESS_PATH_LENGHT 512
+#define HEADLESS_REGISTERS_LENGHT 512
+
+typedef struct
+{
+    const char *roms[HEADLESS_MAX_ROMS];
+    uint32_t    romCount;
+    uint64_t    frames; // frame budget (0 when running a cycle budget)
+    uint64_t    cycles;
+    uint32_t    threads;
+    uint8_t     profile;
+    uint16_t    renderInterval; // game boy frame skip (GB_SetRenderInterval)
+
+    uint32_t        nextRom; // next job index (atomic)
+    FILE           *output;
+    pthread_mutex_t outputLock;
+} HeadlessBatch;
+
+static Emulation *HeadlessSelectEmulator(const char *romPath)
+{
+    const char *extension = strrchr(romPath, '.');
+
+    if (extension == NULL)
+    {
+        return NULL;
+    }
+
+    if (strcmp(extension, ".gb") == 0 || strcmp(extension, ".gbc") == 0)
+    {
+        return &GameBoyEmulator;
+    }
+
+    if (strcmp(extension, ".ch8") == 0)
+    {
+        return &Chip8Emulator;
+    }
+
+    return NULL;
+}
+
+static double HeadlessSeconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+// Dumped by QuitProgram to the working directory (one CSV per rom)
+static void HeadlessEnableProfiler(EmulationState *ctx, const char *romPath)
+{
+    const char *slash = strrchr(romPath, '/');
+    const char *name = slash != NULL ? slash + 1 : romPath;
+    char csvPath[HEADLESS_PATH_LENGHT];
+
+    snprintf(csvPath, sizeof(csvPath), "%s.profile.csv", name);
+    GB_SetProfiling(ctx, 1);
+    GB_ProfilerSetCsvPath(ctx->profiler, csvPath);
+}
+
+// FNV-1a over the rendered pixels
+static uint64_t HeadlessHashPixels(const uint32_t *pixels, const size_t count)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    const uint8_t *bytes = (const uint8_t *) pixels;
+
+    for (size_t i = 0; i < count * sizeof(uint32_t); i++)
+    {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+    }
+
+    return hash;
+}
+
+// Quoted JSON string (paths can have quotes, backslashes or control characters)
+static void HeadlessWriteJsonString(FILE *output, const char *value)
+{
+    fputc('"', output);
+
+    for (const unsigned char *c = (const unsigned char *) value; *c != '\0'; c++)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            fputc('\\', output);
+            fputc(*c, output);
+        }
+        else if (*c < 0x20)
+        {
+            fprintf(output, "\\u%04x", *c);
+        }
+        else
+        {
+            fputc(*c, output);
+        }
+    }
+
+    fputc('"', output);
+}
+
+static void HeadlessWriteError(HeadlessBatch *batch, const char *romPath, const char *error)
+{
+    pthread_mutex_lock(&batch->outputLock);
+    fputs("{\"rom\":", batch->output);
+    HeadlessWriteJsonString(batch->output, romPath);
+    fprintf(batch->output, ",\"error\":\"%s\"}\n", error);
+    fflush(batch->output);
+    pthread_mutex_unlock(&batch->outputLock);
+}
+
+static void HeadlessRunRom(HeadlessBatch *batch, const char *romPath)
+{
+    Emulation *emulator = HeadlessSelectEmulator(romPath);
+
+    if (emulator == NULL)
+    {
+        HeadlessWriteError(batch, romPath, "unknown rom extension");
+        return;
+    }
+
+    const EmulationInfo info = emulator->GetInfo();
+    EmulationInstance instance = emulator->CreateInstance();
+
+    if (emulator->Initialize != NULL)
+    {
+        emulator->Initialize(instance, 0, NULL);
+    }
+
+    if (emulator->LoadProgram(instance, romPath) <= 0)
+    {
+        emulator->QuitProgram(instance);
+        emulator->DestroyInstance(instance);
+        HeadlessWriteError(batch, romPath, "cannot load rom");
+        return;
+    }
+
+    if (batch->profile && emulator == &GameBoyEmulator)
+    {
+        HeadlessEnableProfiler((EmulationState *) instance, romPath);
+    }
+
+    if (emulator == &GameBoyEmulator)
+    {
+        GB_SetRenderInterval(instance, batch->renderInterval);
+    }
+
+    // Stops early when the cpu stops (invalid opcode), HALT and STOP sleep through the budget
+    uint64_t cycles = 0;
+    uint64_t frames = 0;
+    uint8_t  stopped = 0;
+    const double begin = HeadlessSeconds();
+
+    if (batch->frames != 0)
+    {
+        for (; frames < batch->frames; frames++)
+        {
+            const uint64_t consumed = emulator->RunFrame(instance);
+
+            if (consumed == 0)
+            {
+                stopped = 1;
+                break;
+            }
+
+            cycles += consumed;
+        }
+    }
+    else
+    {
+        cycles = emulator->RunCycles(instance, batch->cycles);
+        stopped = cycles < batch->cycles;
+    }
+
+    const double elapsed = HeadlessSeconds() - begin;
+
+    // Final frame and registers
+    const size_t pixelCount = (size_t) info.displayWidth * info.displayHeight;
+    uint32_t *pixels = NULL;
+    char registers[HEADLESS_REGISTERS_LENGHT] = "null";
+
+    MNE_New(pixels, pixelCount, uint32_t);
+    emulator->OnRender(instance, pixels, info.displayWidth, info.displayHeight);
+
+    if (emulator->DumpRegisters != NULL)
+    {
+        emulator->DumpRegisters(instance, registers, sizeof(registers));
+    }
+
+    pthread_mutex_lock(&batch->outputLock);
+    fputs("{\"rom\":", batch->output);
+    HeadlessWriteJsonString(batch->output, romPath);
+    fprintf(batch->output,
+            ",\"emulator\":\"%s\",\"frames\":%llu,\"cycles\":%llu,\"stopped\":%s,\"seconds\":%.6f,"
+            "\"cycles_per_second\":%.0f,\"framebuffer_hash\":\"%016llx\",\"registers\":%s}\n",
+            info.name, (unsigned long long)frames, (unsigned long long)cycles, stopped ? "true" : "false", elapsed,
+            elapsed > 0 ? (double)cycles / elapsed : 0.0, (unsigned long long)HeadlessHashPixels(pixels, pixelCount), registers);
+    fflush(batch->output);
+    pthread_mutex_unlock(&batch->outputLock);
+
+    MNE_Delete(pixels);
+    emulator->QuitProgram(instance);
+    emulator->DestroyInstance(instance);
+}
+
+static void *HeadlessWorker(void *data)
+{
+    HeadlessBatch *batch = (HeadlessBatch *) data;
+
+    for (;;)
+    {
+        const uint32_t rom = __atomic_fetch_add(&batch->nextRom, 1, __ATOMIC_RELAXED);
+
+        if (rom >= batch->romCount)
+        {
+            return NULL;
+        }
+
+        HeadlessRunRom(batch, batch->roms[rom]);
+    }
+}
+
+static uint8_t HeadlessAddRom(HeadlessBatch *batch, const char *romPath)
+{
+    if (batch->romCount == HEADLESS_MAX_ROMS)
+    {
+        fprintf(stderr, "Too many roms (max %u)\n", HEADLESS_MAX_ROMS);
+        return 0;
+    }
+
+    batch->roms[batch->romCount++] = romPath;
+    return 1;
+}
+
+static uint8_t HeadlessReadList(HeadlessBatch *batch, const char *listPath)
+{
+    char  line[HEADLESS_PATH_LENGHT];
+    FILE *list = fopen(listPath, "r");
+
+    if (list == NULL)
+    {
+        fprintf(stderr, "Unable to open rom list %s\n", listPath);
+        return 0;
+    }
+
+    while (fgets(line, sizeof(line), list) != NULL)
+    {
+        line[strcspn(line, "\r\n")] = '\0';
+
+        if (line[0] != '\0' && !HeadlessAddRom(batch, strdup(line)))
+        {
+            fclose(list);
+            return 0;
+        }
+    }
+
+    fclose(list);
+    return 1;
+}
+
+static void HeadlessUsage()
+{
+    fprintf(stderr, "usage: MINEMU_HEADLESS [--frames N | --cycles N] [--threads N] [--list file] [--profile] [--render-every N] rom...\n");
+}
+
+int main(int argc, char **argv)
+{
+    static HeadlessBatch batch;
+
+    batch.frames = HEADLESS_DEFAULT_FRAMES;
+    batch.renderInterval = 1;
+    batch.threads = (uint32_t) sysconf(_SC_NPROCESSORS_ONLN);
+
+    for (int i = 1; i < argc; i++)
+    {
+        const uint8_t hasValue = i + 1 < argc;
+
+        if (strcmp(argv[i], "--frames") == 0 && hasValue)
+        {
+            batch.frames = strtoull(argv[++i], NULL, 10);
+            batch.cycles = 0;
+        }
+        else if (strcmp(argv[i], "--cycles") == 0 && hasValue)
+        {
+            batch.cycles = strtoull(argv[++i], NULL, 10);
+            batch.frames = 0;
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && hasValue)
+        {
+            batch.threads = (uint32_t) strtoul(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--profile") == 0)
+        {
+            batch.profile = 1;
+        }
+        else if (strcmp(argv[i], "--render-every") == 0 && hasValue)
+        {
+            batch.renderInterval = (uint16_t) strtoul(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--list") == 0 && hasValue)
+        {
+            if (!HeadlessReadList(&batch, argv[++i])) return 1;
+        }
+        else if (strncmp(argv[i], "--", 2) == 0)
+        {
+            HeadlessUsage();
+            return 1;
+        }
+        else if (!HeadlessAddRom(&batch, argv[i]))
+        {
+            return 1;
+        }
+    }
+
+    if (batch.romCount == 0 || (batch.frames == 0 && batch.cycles == 0))
+    {
+        HeadlessUsage();
+        return 1;
+    }
+
+    batch.threads = batch.threads == 0 ? 1 : batch.threads;
+    batch.threads = batch.threads > batch.romCount ? batch.romCount : batch.threads;
+
+    // Keep stdout for the JSON lines, everything else printed by the emulators goes to stderr
+    batch.output = fdopen(dup(STDOUT_FILENO), "w");
+    dup2(STDERR_FILENO, STDOUT_FILENO);
+    pthread_mutex_init(&batch.outputLock, NULL);
+
+    pthread_t workers[batch.threads];
+    const double begin = HeadlessSeconds();
+
+    for (uint32_t i = 0; i < batch.threads; i++)
+    {
+        pthread_create(&workers[i], NULL, HeadlessWorker, &batch);
+    }
+
+    for (uint32_t i = 0; i < batch.threads; i++)
+    {
+        pthread_join(workers[i], NULL);
+    }
+
+    fprintf(stderr, "[HEADLESS] %u ROMS %u THREADS %.3f SECONDS\n", batch.romCount, batch.threads, HeadlessSeconds() - begin);
+
+    pthread_mutex_destroy(&batch.outputLock);
+    fclose(batch.output);
+
+    return 0;
+}
@@ -4,12 +4,18 @@
 #include <CC8_Chip8.h>
 #include <GameBoy.h>
 
+// ~60 FRAMES PER SECOND, frames behind this many are dropped instead of catched up
+#define FRAME_TIME_MS 16
+#define MAX_FRAMES_PER_UPDATE 4
+
 // Api elements
 EmuApp *app;
 Emulation *emulator;
+EmulationInstance instance;
 
 // App callbacks
 void OnRender(unsigned int *pixels);
+void OnInput(const char code);
 
 // UI Shell callbacks
 void StartEmulation(void * data);
@@ -19,7 +25,8 @@ void QuitEmulation(void * data);
 int main(int argc, char **argv)
 {
     uint8_t  running = 1 ;
-    uint32_t last_update_time;
+    uint32_t last_update_time = 0;
+    uint32_t frame_time_accumulator = 0;
 
     //TODO: ADD APP SELECTOR
     app = &TinySDLApp;
@@ -30,6 +37,7 @@ int main(int argc, char **argv)
 
     // Fetch default emulation config
     EmulationInfo emuInfo = emulator->GetInfo();
+    instance = emulator->CreateInstance();
 
     // Configure emulator shell actions (if available)
     EmulatorUI.ShellAction(Start, StartEmulation);
@@ -37,7 +45,7 @@ int main(int argc, char **argv)
     EmulatorUI.ShellAction(Quit, QuitEmulation);
 
     // App and emulator initialization
-    app->Init(&emuInfo, emulator->OnInput, &EmulatorUI);
+    app->Init(&emuInfo, OnInput, &EmulatorUI);
 
     // Main loop
     while (running)
@@ -50,21 +58,45 @@ int main(int argc, char **argv)
 
         if (EmulatorUI.GetState() == Running)
         {
-            emulator->Loop(last_update_time, delta_time);
+            frame_time_accumulator += delta_time;
+
+            if (frame_time_accumulator > FRAME_TIME_MS * MAX_FRAMES_PER_UPDATE)
+            {
+                frame_time_accumulator = FRAME_TIME_MS * MAX_FRAMES_PER_UPDATE;
+            }
+
+            while (frame_time_accumulator >= FRAME_TIME_MS)
+            {
+                emulator->RunFrame(instance);
+                frame_time_accumulator -= FRAME_TIME_MS;
+            }
+        }
+        else
+        {
+            frame_time_accumulator = 0;
         }
 
         last_update_time = frameBeginTicks;
     }
 
     // App termination
-    emulator->QuitProgram();
+    emulator->QuitProgram(instance);
+    emulator->DestroyInstance(instance);
     app->Exit();
 }
 
 void OnRender(unsigned int *pixels)
 {
     // TODO: ADD REAL TIME WINDOW HEIGHT/WIDTH
-    emulator->OnRender(pixels, 0,0);
+    emulator->OnRender(instance, pixels, 0,0);
+}
+
+void OnInput(const char code)
+{
+    if (emulator->OnInput != NULL)
+    {
+        emulator->OnInput(instance, code);
+    }
 }
 
 void StartEmulation(void * data)
@@ -74,14 +106,21 @@ void StartEmulation(void * data)
     {
         case Running:
             EmulatorUI.SetState(Starting);
-            emulator->QuitProgram();
             break;
 
         default:
             break;
     }
+
+    // Previous program (if any) is released, the instance is reused for the new one
+    emulator->QuitProgram(instance);
+
+    if (emulator->Initialize != NULL)
+    {
+        emulator->Initialize(instance, 0, NULL);
+    }
     
-    if (emulator->LoadProgram((const char*) data) > 1)
+    if (emulator->LoadProgram(instance, (const char*) data) > 1)
     {
         EmulatorUI.SetState(Running);
     }